@@ -61,6 +61,7 @@
 #include <Base/Exception.h>
 #include <Base/Parameter.h>
 #include <Base/Console.h>
+#include <Base/Profiler.h>
 #include <Base/Factory.h>
 #include <Base/FileInfo.h>
 #include <Base/Type.h>
@@ -169,6 +170,11 @@ PyDoc_STRVAR(Console_doc,
      "FreeCAD Console\n"
     );
 
+PyDoc_STRVAR(Profiler_doc,
+     "FreeCAD Profiler\n"
+     "Records the time spent in recompute, load, save and view provider updates\n"
+    );
+
 Application::Application(ParameterManager * /*pcSysParamMngr*/,
                          ParameterManager * /*pcUserParamMngr*/,
                          std::map<std::string,std::string> &mConfig)
@@ -188,6 +194,7 @@ Application::Application(ParameterManager * /*pcSysParamMngr*/,
     Py::Module(pAppModule).setAttr(std::string("ActiveDocument"),Py::None());
 
     PyObject* pConsoleModule = Py_InitModule3("__FreeCADConsole__", ConsoleSingleton::Methods, Console_doc);
+    PyObject* pProfilerModule = Py_InitModule3("__FreeCADProfiler__", Base::Profiler::Methods, Profiler_doc);
 
     // introducing additional classes
 
@@ -241,6 +248,8 @@ Application::Application(ParameterManager * /*pcSysParamMngr*/,
     PyModule_AddObject(pAppModule, "Base", pBaseModule);
     Py_INCREF(pConsoleModule);
     PyModule_AddObject(pAppModule, "Console", pConsoleModule);
+    Py_INCREF(pProfilerModule);
+    PyModule_AddObject(pAppModule, "Profiler", pProfilerModule);
 
     //insert Units module
     PyObject* pUnitsModule = Py_InitModule3("Units", Base::UnitsApi::Methods,
@@ -617,6 +626,15 @@ void Application::addImportType(const char* Type, const char* ModuleName)
         std::string AppName = Config()["ExeName"];
         AppName += item.filter.substr(7);
         item.filter = AppName;
+    }
+
+    // a module that is registered lazily at startup registers its types again when it is loaded
+    for (std::vector<FileTypeItem>::const_iterator it = _mImportTypes.begin(); it != _mImportTypes.end(); ++it) {
+        if (it->filter == item.filter && it->module == item.module)
+            return;
+    }
+
+    if (strncmp(Type, "FreeCAD", 7) == 0) {
         // put to the front of the array
         _mImportTypes.insert(_mImportTypes.begin(),item);
     }
@@ -730,6 +748,15 @@ void Application::addExportType(const char* Type, const char* ModuleName)
         std::string AppName = Config()["ExeName"];
         AppName += item.filter.substr(7);
         item.filter = AppName;
+    }
+
+    // ignore a duplicate, see addImportType()
+    for (std::vector<FileTypeItem>::const_iterator it = _mExportTypes.begin(); it != _mExportTypes.end(); ++it) {
+        if (it->filter == item.filter && it->module == item.module)
+            return;
+    }
+
+    if (strncmp(Type, "FreeCAD", 7) == 0) {
         // put to the front of the array
         _mExportTypes.insert(_mExportTypes.begin(),item);
     }
@@ -870,14 +897,18 @@ char ** Application::_argv;
 
 void Application::destruct(void)
 {
-    // saving system parameter
-    Console().Log("Saving system parameter...\n");
-    _pcSysParamMngr->SaveDocument(mConfig["SystemParameter"].c_str());
+    // saving system parameter, unless nothing has changed
+    if (_pcSysParamMngr->IsDirty()) {
+        Console().Log("Saving system parameter...\n");
+        _pcSysParamMngr->SaveDocument(mConfig["SystemParameter"].c_str());
+        Console().Log("Saving system parameter...done\n");
+    }
     // saving the User parameter
-    Console().Log("Saving system parameter...done\n");
-    Console().Log("Saving user parameter...\n");
-    _pcUserParamMngr->SaveDocument(mConfig["UserParameter"].c_str());
-    Console().Log("Saving user parameter...done\n");
+    if (_pcUserParamMngr->IsDirty()) {
+        Console().Log("Saving user parameter...\n");
+        _pcUserParamMngr->SaveDocument(mConfig["UserParameter"].c_str());
+        Console().Log("Saving user parameter...done\n");
+    }
     // clean up
     delete _pcSysParamMngr;
     delete _pcUserParamMngr;
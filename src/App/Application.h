@@ -177,7 +177,7 @@ public:
      *  @see OpenHandlerFactorySingleton
      */
     //@{
-    /// Register an import filetype and a module name
+    /// Register an import filetype and a module name, registering the same pair again has no effect
     void addImportType(const char* Type, const char* ModuleName);
     /// Return a list of modules that support the given filetype.
     std::vector<std::string> getImportModules(const char* Type) const;
@@ -81,6 +81,7 @@ recompute path. Also enables more complicated dependencies beyond trees.
 #include <Base/FileInfo.h>
 #include <Base/TimeInfo.h>
 #include <Base/Interpreter.h>
+#include <Base/Profiler.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
 #include <Base/Stream.h>
@@ -150,6 +151,10 @@ struct DocumentP
     unsigned int UndoMaxStackSize;
     DependencyList DepList;
     std::map<DocumentObject*,Vertex> VertexObjectList;
+    // deferred change notifications
+    int notificationBatch;
+    std::vector<const DocumentObject*> pendingObjects;
+    std::map<const DocumentObject*, std::vector<const Property*> > pendingChanges;
 
     DocumentP() {
         activeObject = 0;
@@ -163,6 +168,7 @@ struct DocumentP
         iUndoMode = 0;
         UndoMemSize = 0;
         UndoMaxStackSize = 20;
+        notificationBatch = 0;
     }
 };
 
@@ -264,8 +270,11 @@ bool Document::undo(void)
         d->activeUndoTransaction = new Transaction();
         d->activeUndoTransaction->Name = mUndoTransactions.back()->Name;
 
-        // applying the undo
-        mUndoTransactions.back()->apply(*this,false);
+        // applying the undo, each restored property is notified once
+        {
+            NotificationBatch batch(this);
+            mUndoTransactions.back()->apply(*this,false);
+        }
 
         // save the redo
         mRedoTransactions.push_back(d->activeUndoTransaction);
@@ -294,7 +303,10 @@ bool Document::redo(void)
         d->activeUndoTransaction->Name = mRedoTransactions.back()->Name;
 
         // do the redo
-        mRedoTransactions.back()->apply(*this,true);
+        {
+            NotificationBatch batch(this);
+            mRedoTransactions.back()->apply(*this,true);
+        }
         mUndoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = 0;
 
@@ -521,9 +533,74 @@ void Document::onChangedProperty(const DocumentObject *Who, const Property *What
 {
     if (d->activeTransaction && !d->rollback)
         d->activeTransaction->addObjectChange(Who,What);
+
+    if (d->notificationBatch > 0) {
+        std::vector<const Property*>& props = d->pendingChanges[Who];
+        if (props.empty())
+            d->pendingObjects.push_back(Who);
+        if (std::find(props.begin(), props.end(), What) == props.end())
+            props.push_back(What);
+        return;
+    }
+
     signalChangedObject(*Who, *What);
 }
 
+void Document::beginNotificationBatch()
+{
+    d->notificationBatch++;
+}
+
+void Document::endNotificationBatch()
+{
+    if (d->notificationBatch == 0 || --d->notificationBatch > 0)
+        return;
+
+    // changes made by the observers are signalled immediately, the pending changes
+    // stay in place so that objects or properties removed by an observer are skipped
+    std::vector<const DocumentObject*> objects;
+    objects.swap(d->pendingObjects);
+    for (std::vector<const DocumentObject*>::iterator it = objects.begin(); it != objects.end(); ++it) {
+        for (;;) {
+            std::map<const DocumentObject*, std::vector<const Property*> >::iterator jt = d->pendingChanges.find(*it);
+            if (jt == d->pendingChanges.end())
+                break;
+            std::vector<const Property*>& props = jt->second;
+            if (props.empty()) {
+                d->pendingChanges.erase(jt);
+                break;
+            }
+            const Property* prop = props.front();
+            props.erase(props.begin());
+            signalChangedObject(**it, *prop);
+        }
+    }
+}
+
+bool Document::isNotificationBatchOpen() const
+{
+    return d->notificationBatch > 0;
+}
+
+void Document::_removePendingChanges(const DocumentObject* Obj)
+{
+    if (d->pendingChanges.erase(Obj) > 0) {
+        d->pendingObjects.erase(std::remove(d->pendingObjects.begin(),
+            d->pendingObjects.end(), Obj), d->pendingObjects.end());
+    }
+}
+
+void Document::_removePendingChange(const DocumentObject* Obj, const Property* Prop)
+{
+    std::map<const DocumentObject*, std::vector<const Property*> >::iterator it = d->pendingChanges.find(Obj);
+    if (it == d->pendingChanges.end())
+        return;
+    std::vector<const Property*>& props = it->second;
+    props.erase(std::remove(props.begin(), props.end(), Prop), props.end());
+    if (props.empty())
+        _removePendingChanges(Obj);
+}
+
 void Document::setTransactionMode(int iMode)
 {
     /*  if(_iTransactionMode == 0 && iMode == 1)
@@ -947,6 +1024,8 @@ bool Document::saveAs(const char* file)
 // Save the document under the name it has been opened
 bool Document::save (void)
 {
+    Base::ProfileZone zone("Document::save", FileName.getValue());
+
     int compression = App::GetApplication().GetParameterGroupByPath
         ("User parameter:BaseApp/Preferences/Document")->GetInt("CompressionLevel",3);
 
@@ -1046,11 +1125,14 @@ bool Document::save (void)
 // Open the document
 void Document::restore (void)
 {
+    Base::ProfileZone zone("Document::restore", FileName.getValue());
+
     // clean up if the document is not empty
     // !TODO mind exeptions while restoring!
     clearUndos();
     for (std::vector<DocumentObject*>::iterator obj = d->objectArray.begin(); obj != d->objectArray.end(); ++obj) {
         signalDeletedObject(*(*obj));
+        _removePendingChanges(*obj);
         delete *obj;
     }
     d->objectArray.clear();
@@ -1250,6 +1332,8 @@ void Document::_rebuildDependencyList(void)
 
 void Document::recompute()
 {
+    Base::ProfileZone zone("Document::recompute", getName());
+
     // delete recompute log
     for( std::vector<App::DocumentObjectExecReturn*>::iterator it=_RecomputeLog.begin();it!=_RecomputeLog.end();++it)
         delete *it;
@@ -1342,6 +1426,7 @@ bool Document::_recomputeFeature(DocumentObject* Feat)
     std::clog << "Solv: Executing Feature: " << Feat->getNameInDocument() << std::endl;;
 #endif
 
+    Base::ProfileZone zone(Feat->getTypeId().getName(), Feat->getNameInDocument());
     DocumentObjectExecReturn  *returnCode = 0;
     try {
         returnCode = Feat->recompute();
@@ -1495,6 +1580,7 @@ void Document::remObject(const char* sName)
         d->activeObject = 0;
 
     signalDeletedObject(*(pos->second));
+    _removePendingChanges(pos->second);
     if (!d->vertexMap.empty()) {
         // recompute of document is running
         for (std::map<Vertex,DocumentObject*>::iterator it = d->vertexMap.begin(); it != d->vertexMap.end(); ++it) {
@@ -1550,6 +1636,7 @@ void Document::_remObject(DocumentObject* pcObject)
         d->activeObject = 0;
 
     signalDeletedObject(*pcObject);
+    _removePendingChanges(pcObject);
 
     // do no transactions if we do a rollback!
     if(!d->rollback){
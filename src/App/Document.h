@@ -257,6 +257,20 @@ public:
     bool redo() ;
     //@}
 
+    /** @name methods for batching change notifications */
+    //@{
+    /** Defer signalChangedObject until the matching endNotificationBatch().
+     * Calls can be nested. Transactions are not affected.
+     */
+    void beginNotificationBatch();
+    /** Close a batch. When the outermost batch is closed each changed
+     * property is signalled once, grouped by object in the order of the first change.
+     */
+    void endNotificationBatch();
+    /// Check if change notifications are deferred
+    bool isNotificationBatchOpen() const;
+    //@}
+
     /** @name dependency stuff */
     //@{
     /// write GraphViz file
@@ -303,6 +317,10 @@ protected:
     void onBeforeChangeProperty(const DocumentObject *Who, const Property *What);
     /// callback from the Document objects after property was changed
     void onChangedProperty(const DocumentObject *Who, const Property *What);
+    /// drops the deferred notifications of an object to be deleted
+    void _removePendingChanges(const DocumentObject* Obj);
+    /// drops the deferred notification of a property to be deleted
+    void _removePendingChange(const DocumentObject* Obj, const Property* Prop);
     /// helper which Recompute only this feature
     bool _recomputeFeature(DocumentObject* Feat);
     void _clearRedos();
@@ -334,6 +352,32 @@ inline std::vector<T*> Document::getObjectsOfType() const
     return type;
 }
 
+/** Batches the change notifications of a document for its lifetime.
+ * Setting several properties of many objects then leads to only one
+ * update of each property's view, e.g. one tessellation of a shape.
+ * @code
+ * {
+ *     App::NotificationBatch batch(doc);
+ *     for (...)
+ *         obj->Placement.setValue(...);
+ * } // changes are signalled here
+ * @endcode
+ * @see Document::beginNotificationBatch()
+ */
+class AppExport NotificationBatch
+{
+public:
+    NotificationBatch(Document* doc) : doc(doc)
+    { doc->beginNotificationBatch(); }
+    ~NotificationBatch()
+    { doc->endNotificationBatch(); }
+
+private:
+    NotificationBatch(const NotificationBatch&);
+    NotificationBatch& operator=(const NotificationBatch&);
+    Document* doc;
+};
+
 
 } //namespace App
 
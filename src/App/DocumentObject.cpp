@@ -197,6 +197,12 @@ void DocumentObject::onChanged(const Property* prop)
     StatusBits.set(0);
 }
 
+void DocumentObject::onBeforeRemoveProperty(const Property* prop)
+{
+    if (_pDoc)
+        _pDoc->_removePendingChange(this,prop);
+}
+
 PyObject *DocumentObject::getPyObject(void)
 {
     if (PythonObject.is(Py::_None())) {
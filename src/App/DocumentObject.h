@@ -194,6 +194,8 @@ protected:
     virtual void onBeforeChange(const Property* prop);
     /// get called by the container when a property was changed
     virtual void onChanged(const Property* prop);
+    /// get called before a dynamic property is removed
+    void onBeforeRemoveProperty(const Property* prop);
     /// get called after a document has been fully restored
     virtual void onDocumentRestored() {}
     /// get called after duplicating an object
@@ -286,6 +286,24 @@ PyObject*  DocumentPy::commitTransaction(PyObject * args)
     Py_Return;
 }
 
+PyObject*  DocumentPy::beginNotificationBatch(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))     // convert args: Python->C 
+        return NULL;                    // NULL triggers exception 
+    getDocumentPtr()->beginNotificationBatch();
+    Py_Return;
+}
+
+PyObject*  DocumentPy::endNotificationBatch(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))     // convert args: Python->C 
+        return NULL;                    // NULL triggers exception 
+    PY_TRY {
+        getDocumentPtr()->endNotificationBatch();
+    } PY_CATCH;
+    Py_Return;
+}
+
 PyObject*  DocumentPy::undo(PyObject * args)
 {
     if (!PyArg_ParseTuple(args, ""))     // convert args: Python->C 
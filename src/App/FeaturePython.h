@@ -100,6 +100,9 @@ public:
         return props->addDynamicProperty(type, name, group, doc, attr, ro, hidden);
     }
     virtual bool removeDynamicProperty(const char* name) {
+        Property* prop = props->getDynamicPropertyByName(name);
+        if (prop)
+            FeatureT::onBeforeRemoveProperty(prop);
         return props->removeDynamicProperty(name);
     }
     std::vector<std::string> getDynamicPropertyNames() const {
@@ -34,6 +34,223 @@
 import FreeCAD
 
 
+class ModuleCache:
+	"""The module cache is a manifest of the module directories stored in
+	ModuleCache.txt in the user directory. For each directory it records what
+	a declarative Init.py registers and which workbenches a declarative
+	InitGui.py adds, so that these files need not be executed at startup. An
+	entry is rebuilt when the modification time of the directory or one of
+	its init files changes.
+	A file is declarative if it only sets parameters, registers file types
+	with literal arguments and defines classes with methods and literal
+	attributes. All other files are executed as before."""
+	Version = 1
+	AppCalls = ("addImportType", "addExportType", "EndingAdd")
+	ParamCalls = ("SetBool", "SetInt", "SetUnsigned", "SetFloat", "SetString")
+
+	def __init__(self, fileName):
+		self.fileName = fileName
+		self.entries = {}
+		self.used = {}
+		self.changed = False
+		try:
+			import ast
+			f = open(fileName)
+			data = ast.literal_eval(f.read())
+			f.close()
+			if data["Version"] == self.Version:
+				self.entries = data["Modules"]
+		except Exception:
+			pass # a missing or broken cache is rebuilt
+
+	def entry(self, Dir):
+		"""Returns the cached information of a module directory"""
+		import os
+		InitFile = os.path.join(Dir,"Init.py")
+		InitGuiFile = os.path.join(Dir,"InitGui.py")
+		stamp = (self.mtime(Dir), self.mtime(InitFile), self.mtime(InitGuiFile))
+		entry = self.entries.get(Dir)
+		if entry is None or entry["Stamp"] != stamp:
+			entry = {"Stamp": stamp, "Init": self.scanInit(InitFile), "InitGui": self.scanInitGui(InitGuiFile)}
+			self.entries[Dir] = entry
+			self.changed = True
+		self.used[Dir] = entry
+		return entry
+
+	def save(self):
+		"""Writes the cache if an entry was rebuilt or a directory is gone"""
+		if not self.changed and len(self.used) == len(self.entries):
+			return
+		try:
+			f = open(self.fileName, "w")
+			f.write(repr({"Version": self.Version, "Modules": self.used}))
+			f.close()
+		except IOError:
+			Log('Init:   Cannot write ' + self.fileName + '\n')
+		self.entries = dict(self.used)
+		self.changed = False
+
+	def replay(self, calls):
+		"""Makes the calls recorded by scanInit() or scanInitGui()"""
+		for call in calls:
+			if call[0] == "App":
+				getattr(FreeCAD, call[1])(*call[2])
+			else:
+				grp = FreeCAD.ParamGet(call[1][0])
+				for name in call[1][1:]:
+					grp = grp.GetGroup(name)
+				if call[0] == "Param":
+					getattr(grp, call[2])(*call[3])
+
+	def scanInit(self, fileName):
+		"""Returns the calls of a declarative Init.py or None"""
+		import ast
+		body = self.parse(fileName)
+		if body is None:
+			return None
+		calls = []
+		groups = {}
+		try:
+			for stmt in body:
+				if self.isDocString(stmt) or self.isPlainClass(stmt):
+					continue
+				if isinstance(stmt, ast.Import) and [(i.name, i.asname) for i in stmt.names] == [("FreeCAD", None)]:
+					continue
+				if isinstance(stmt, ast.Assign) and len(stmt.targets) == 1 and isinstance(stmt.targets[0], ast.Name):
+					path = self.paramGroup(stmt.value)
+					if path is None:
+						return None
+					groups[stmt.targets[0].id] = path
+					calls.append(("Group", path))
+					continue
+				call = isinstance(stmt, ast.Expr) and self.methodCall(stmt.value)
+				if not call:
+					return None
+				obj, method, args = call
+				if self.isName(obj, ("FreeCAD", "App")) and method in self.AppCalls:
+					calls.append(("App", method, self.literals(args)))
+				elif isinstance(obj, ast.Name) and obj.id in groups and method in self.ParamCalls:
+					calls.append(("Param", groups[obj.id], method, self.literals(args)))
+				else:
+					return None
+		except ValueError:
+			return None
+		return calls
+
+	def scanInitGui(self, fileName):
+		"""Returns the workbenches and the calls of a declarative InitGui.py or None"""
+		import ast
+		body = self.parse(fileName)
+		if body is None:
+			return None
+		classes = {}
+		workbenches = []
+		calls = []
+		try:
+			for stmt in body:
+				if self.isDocString(stmt):
+					continue
+				if self.isPlainClass(stmt) and [self.isName(i, ("Workbench",)) for i in stmt.bases] == [True]:
+					attrs = {}
+					for i in stmt.body:
+						if isinstance(i, ast.Assign) and i.targets[0].id in ("MenuText", "ToolTip", "Icon"):
+							attrs[i.targets[0].id] = ast.literal_eval(i.value)
+					classes[stmt.name] = attrs
+					continue
+				call = isinstance(stmt, ast.Expr) and self.methodCall(stmt.value)
+				if not call:
+					return None
+				obj, method, args = call
+				if self.isName(obj, ("FreeCADGui", "Gui")) and method == "addWorkbench" and len(args) == 1:
+					arg = args[0]
+					if isinstance(arg, ast.Call) and not arg.args and not arg.keywords and not arg.starargs and not arg.kwargs:
+						arg = arg.func # an instance of the class
+					if not isinstance(arg, ast.Name) or arg.id not in classes:
+						return None
+					info = dict(classes[arg.id])
+					info["Name"] = arg.id
+					workbenches.append(info)
+				elif self.isName(obj, ("FreeCAD", "App")) and method in self.AppCalls:
+					calls.append(("App", method, self.literals(args)))
+				else:
+					return None
+		except ValueError:
+			return None
+		if not workbenches:
+			return None
+		return {"Workbenches": workbenches, "Calls": calls}
+
+	def mtime(self, path):
+		import os
+		try:
+			return os.path.getmtime(path)
+		except OSError:
+			return 0
+
+	def parse(self, fileName):
+		import ast, os
+		if not os.path.exists(fileName):
+			return None
+		try:
+			f = open(fileName)
+			source = f.read()
+			f.close()
+			return ast.parse(source.replace("\r\n", "\n"), fileName).body
+		except Exception:
+			return None
+
+	def isName(self, node, names):
+		import ast
+		return isinstance(node, ast.Name) and node.id in names
+
+	def isDocString(self, stmt):
+		import ast
+		return isinstance(stmt, ast.Expr) and isinstance(stmt.value, ast.Str)
+
+	def isPlainClass(self, stmt):
+		"""Checks if a class only defines methods and literal attributes"""
+		import ast
+		if not isinstance(stmt, ast.ClassDef) or stmt.decorator_list:
+			return False
+		for i in stmt.bases:
+			if not isinstance(i, ast.Name):
+				return False
+		for i in stmt.body:
+			if isinstance(i, ast.FunctionDef) or isinstance(i, ast.Pass) or self.isDocString(i):
+				continue
+			if not isinstance(i, ast.Assign) or len(i.targets) != 1 or not isinstance(i.targets[0], ast.Name):
+				return False
+			try:
+				ast.literal_eval(i.value)
+			except ValueError:
+				return False
+		return True
+
+	def methodCall(self, node):
+		"""Returns the object, the method name and the arguments of a method call"""
+		import ast
+		if not isinstance(node, ast.Call) or not isinstance(node.func, ast.Attribute):
+			return None
+		if node.keywords or node.starargs or node.kwargs:
+			return None
+		return (node.func.value, node.func.attr, node.args)
+
+	def literals(self, nodes):
+		import ast
+		return tuple([ast.literal_eval(i) for i in nodes])
+
+	def paramGroup(self, node):
+		"""Returns the path of FreeCAD.ParamGet(...).GetGroup(...)... or None"""
+		subs = []
+		call = self.methodCall(node)
+		while call and call[1] == "GetGroup" and len(call[2]) == 1:
+			subs.insert(0, self.literals(call[2])[0])
+			call = self.methodCall(call[0])
+		if call and self.isName(call[0], ("FreeCAD", "App")) and call[1] == "ParamGet" and len(call[2]) == 1:
+			return self.literals(call[2]) + tuple(subs)
+		return None
+
+
 def InitApplications():
 	try:
 		import sys,os
@@ -53,6 +270,10 @@ def InitApplications():
 	MacroDir = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Macro").GetString("MacroPath")
 	MacroMod = os.path.realpath(MacroDir+"/Mod")
 	ModPar = FreeCAD.ParamGet("System parameter:Modules")
+	global ModuleManifest
+	ModuleManifest = None
+	if FreeCAD.ParamGet("User parameter:BaseApp/Preferences/General").GetBool("UseModuleCache",True):
+		ModuleManifest = ModuleCache(FreeCAD.ConfigGet("UserAppData")+"ModuleCache.txt")
 
 	#print FreeCAD.getHomePath()
 	if os.path.isdir(FreeCAD.getHomePath()+'src\\Tools'):
@@ -92,9 +313,15 @@ def InitApplications():
 			sys.path.insert(0,Dir)
 			PathExtension += Dir + os.pathsep
 			InstallFile = os.path.join(Dir,"Init.py")
+			calls = None
+			if ModuleManifest:
+				calls = ModuleManifest.entry(Dir)["Init"]
 			if (os.path.exists(InstallFile)):
 				try:
-					execfile(InstallFile)
+					if calls is None:
+						execfile(InstallFile)
+					else:
+						ModuleManifest.replay(calls)
 				except Exception, inst:
 					Log('Init:      Initializing ' + Dir + '... failed\n')
 					Err('During initialization the error ' + str(inst) + ' occurred in ' + InstallFile + '\n')
@@ -102,6 +329,8 @@ def InitApplications():
 					Log('Init:      Initializing ' + Dir + '... done\n')
 			else:
 				Log('Init:      Initializing ' + Dir + '(Init.py not found)... ignore\n')
+	if ModuleManifest:
+		ModuleManifest.save()
 	sys.path.insert(0,LibDir)
 	sys.path.insert(0,ModDir)
 	Log("Using "+ModDir+" as module path!\n")
@@ -33,6 +33,7 @@
 #include <Base/Writer.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/Profiler.h>
 
 #include "Property.h"
 #include "PropertyContainer.h"
@@ -234,8 +235,10 @@ void PropertyContainer::Restore(Base::XMLReader &reader)
         // not its name. In this case we would force to read-in a wrong property
         // type and the behaviour would be undefined.
         try {
-            if (prop && strcmp(prop->getTypeId().getName(), TypeName) == 0)
+            if (prop && strcmp(prop->getTypeId().getName(), TypeName) == 0) {
+                Base::ProfileZone zone(prop->getTypeId().getName(), PropName);
                 prop->Restore(reader);
+            }
         }
         catch (const Base::XMLParseException&) {
             throw; // re-throw
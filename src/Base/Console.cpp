@@ -32,6 +32,12 @@
 # include <windows.h>
 # endif
 # include "fcntl.h"
+# include <sstream>
+# include <QAtomicInt>
+# include <QAtomicPointer>
+# include <QCoreApplication>
+# include <QEvent>
+# include <QThread>
 #endif
 
 #include "Console.h"
@@ -42,8 +48,91 @@ using namespace Base;
 
 
 
-char format[4024];  // global buffer 
-const unsigned int format_len = 4024;
+static const unsigned int format_len = 4024; // size of the format buffer of each call
+
+namespace Base {
+
+/// A message of another thread waiting for the main thread
+struct ConsoleRecord
+{
+    ConsoleSingleton::FreeCAD_ConsoleMsgType type;
+    std::string text;
+    double seconds;
+    bool timing;
+    ConsoleRecord* next;
+};
+
+/**
+ * A lock-free queue for any number of producers and a single consumer.
+ * The producers push onto a stack and the consumer takes the whole stack
+ * at once and reverses it. As no record is ever taken alone there is no
+ * ABA problem.
+ */
+class ConsoleQueue
+{
+public:
+    ConsoleQueue() : head(0) {}
+    ~ConsoleQueue()
+    {
+        ConsoleRecord* rec = takeAll();
+        while (rec) {
+            ConsoleRecord* next = rec->next;
+            delete rec;
+            rec = next;
+        }
+    }
+    /// returns true if the queue was empty before
+    bool push(ConsoleRecord* rec)
+    {
+        for (;;) {
+            ConsoleRecord* top = head;
+            rec->next = top;
+            if (head.testAndSetOrdered(top, rec))
+                return top == 0;
+        }
+    }
+    /// takes all records in the order they were pushed
+    ConsoleRecord* takeAll()
+    {
+        ConsoleRecord* top = head.fetchAndStoreOrdered(0);
+        ConsoleRecord* list = 0;
+        while (top) {
+            ConsoleRecord* next = top->next;
+            top->next = list;
+            list = top;
+            top = next;
+        }
+        return list;
+    }
+
+private:
+    QAtomicPointer<ConsoleRecord> head;
+};
+
+/// Delivers the queued messages when the event loop of the main thread runs
+class ConsoleDispatcher : public QObject
+{
+public:
+    bool event(QEvent* e)
+    {
+        if (e->type() == QEvent::User) {
+            Console().Flush();
+            return true;
+        }
+        return QObject::event(e);
+    }
+};
+
+struct ConsoleSingletonP
+{
+    QThread* mainThread;
+    ConsoleQueue queue;
+    ConsoleDispatcher dispatcher;
+    // the message types any observer takes
+    mutable QAtomicInt msgMask;
+};
+
+} // namespace Base
 
 
 //**************************************************************************
@@ -53,14 +142,24 @@ const unsigned int format_len = 4024;
 ConsoleSingleton::ConsoleSingleton(void)
   :_bVerbose(false)
 {
-
+    d = new ConsoleSingletonP;
+    d->mainThread = QThread::currentThread();
+    d->msgMask = 0;
 }
 
 ConsoleSingleton::~ConsoleSingleton()
 {
+    Flush();
     for(std::set<ConsoleObserver * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();Iter++)
         delete (*Iter);   
+    delete d;
+}
 
+void ConsoleObserver::Timing(const char *sName, double dSeconds)
+{
+    std::stringstream str;
+    str << sName << ": " << dSeconds << " s\n";
+    Log(str.str().c_str());
 }
 
 
@@ -126,6 +225,7 @@ ConsoleMsgFlags ConsoleSingleton::SetEnabledMsgType(const char* sObs, ConsoleMsg
                 flags |= MsgType_Log;
             pObs->bLog = b;
         }
+        UpdateMsgMask();
         return flags;
     }
     else {
@@ -155,6 +255,32 @@ bool ConsoleSingleton::IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType
     }
 }
 
+/**
+ * Returns true if any observer takes messages of the given type. This can be called from any
+ * thread and allows to skip building expensive messages.
+ */
+bool ConsoleSingleton::IsMsgTypeEnabled(FreeCAD_ConsoleMsgType type) const
+{
+    if (type == MsgType_Log && _bVerbose)
+        return false;
+    // the flags of the observers can be changed directly, so refresh them in the main thread
+    if (QThread::currentThread() == d->mainThread)
+        UpdateMsgMask();
+    return ((int)d->msgMask & type) != 0;
+}
+
+void ConsoleSingleton::UpdateMsgMask(void) const
+{
+    int mask = 0;
+    for(std::set<ConsoleObserver * >::const_iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();Iter++) {
+        if((*Iter)->bMsg) mask |= MsgType_Txt;
+        if((*Iter)->bLog) mask |= MsgType_Log;
+        if((*Iter)->bWrn) mask |= MsgType_Wrn;
+        if((*Iter)->bErr) mask |= MsgType_Err;
+    }
+    d->msgMask = mask;
+}
+
 /** Prints a Message
  *  This method issues a Message. 
  *  Messages are used show some non vital information. That means in the
@@ -171,11 +297,14 @@ bool ConsoleSingleton::IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType
  */
 void ConsoleSingleton::Message( const char *pMsg, ... )
 {
+    if (!IsMsgTypeEnabled(MsgType_Txt))
+        return;
+    char format[format_len];
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
     vsnprintf(format, format_len, pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyMessage(format);
+    Dispatch(MsgType_Txt, format, 0.0, false);
 }
 
 /** Prints a Message
@@ -195,11 +324,14 @@ void ConsoleSingleton::Message( const char *pMsg, ... )
  */
 void ConsoleSingleton::Warning( const char *pMsg, ... )
 {
+    if (!IsMsgTypeEnabled(MsgType_Wrn))
+        return;
+    char format[format_len];
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
     vsnprintf(format, format_len, pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyWarning(format);
+    Dispatch(MsgType_Wrn, format, 0.0, false);
 }
 
 /** Prints a Message
@@ -219,11 +351,14 @@ void ConsoleSingleton::Warning( const char *pMsg, ... )
  */
 void ConsoleSingleton::Error( const char *pMsg, ... )
 {
+    if (!IsMsgTypeEnabled(MsgType_Err))
+        return;
+    char format[format_len];
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
     vsnprintf(format, format_len, pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyError(format);
+    Dispatch(MsgType_Err, format, 0.0, false);
 }
 
 
@@ -246,13 +381,51 @@ void ConsoleSingleton::Error( const char *pMsg, ... )
 
 void ConsoleSingleton::Log( const char *pMsg, ... )
 {
-    if (!_bVerbose)
-    {
-        va_list namelessVars;
-        va_start(namelessVars, pMsg);  // Get the "..." vars
-        vsnprintf(format, format_len, pMsg, namelessVars);
-        va_end(namelessVars);
-        NotifyLog(format);
+    if (!IsMsgTypeEnabled(MsgType_Log))
+        return;
+    char format[format_len];
+    va_list namelessVars;
+    va_start(namelessVars, pMsg);  // Get the "..." vars
+    vsnprintf(format, format_len, pMsg, namelessVars);
+    va_end(namelessVars);
+    Dispatch(MsgType_Log, format, 0.0, false);
+}
+
+/** Reports a duration
+ *  The duration in seconds of the step \a sName is passed as a record to
+ *  ConsoleObserver::Timing() of the observers taking log messages, thus no
+ *  message is formatted if logging is switched off.
+ *  \par
+ *  \code
+ *  Base::TimeInfo start;
+ *  ...
+ *  Console().Timing("Reading file", Base::TimeInfo::diffTimeF(start,Base::TimeInfo()));
+ *  \endcode
+ *  @see Log
+ */
+void ConsoleSingleton::Timing( const char *sName, double dSeconds )
+{
+    if (IsMsgTypeEnabled(MsgType_Log))
+        Dispatch(MsgType_Log, sName, dSeconds, true);
+}
+
+/** Delivers the queued messages
+ *  Messages issued in other threads than the main thread are queued and
+ *  delivered to the observers by the main thread. This happens with the next
+ *  message of the main thread or when its event loop runs. Call this method
+ *  to deliver them immediately, e.g. after waiting for some worker threads.
+ *  Outside the main thread this method does nothing.
+ */
+void ConsoleSingleton::Flush(void)
+{
+    if (QThread::currentThread() != d->mainThread)
+        return;
+    ConsoleRecord* rec = d->queue.takeAll();
+    while (rec) {
+        Notify(rec->type, rec->text.c_str(), rec->seconds, rec->timing);
+        ConsoleRecord* next = rec->next;
+        delete rec;
+        rec = next;
     }
 }
 
@@ -290,6 +463,7 @@ void ConsoleSingleton::AttachObserver(ConsoleObserver *pcObserver)
     assert(_aclObservers.find(pcObserver) == _aclObservers.end() );
 
     _aclObservers.insert(pcObserver);
+    UpdateMsgMask();
 }
 
 /** Detaches an Observer from Console
@@ -300,6 +474,47 @@ void ConsoleSingleton::AttachObserver(ConsoleObserver *pcObserver)
 void ConsoleSingleton::DetachObserver(ConsoleObserver *pcObserver)
 {
     _aclObservers.erase(pcObserver);
+    UpdateMsgMask();
+}
+
+void ConsoleSingleton::Dispatch(FreeCAD_ConsoleMsgType type, const char *sMsg, double dSeconds, bool bTiming)
+{
+    if (QThread::currentThread() != d->mainThread) {
+        ConsoleRecord* rec = new ConsoleRecord;
+        rec->type = type;
+        rec->text = sMsg;
+        rec->seconds = dSeconds;
+        rec->timing = bTiming;
+        // only the first record of a batch needs to wake up the main thread
+        if (d->queue.push(rec) && QCoreApplication::instance())
+            QCoreApplication::postEvent(&d->dispatcher, new QEvent(QEvent::User));
+        return;
+    }
+
+    // keep the order with the messages other threads issued before
+    Flush();
+    Notify(type, sMsg, dSeconds, bTiming);
+}
+
+void ConsoleSingleton::Notify(FreeCAD_ConsoleMsgType type, const char *sMsg, double dSeconds, bool bTiming)
+{
+    switch (type) {
+    case MsgType_Txt:
+        NotifyMessage(sMsg);
+        break;
+    case MsgType_Wrn:
+        NotifyWarning(sMsg);
+        break;
+    case MsgType_Err:
+        NotifyError(sMsg);
+        break;
+    case MsgType_Log:
+        if (bTiming)
+            NotifyTiming(sMsg, dSeconds);
+        else
+            NotifyLog(sMsg);
+        break;
+    }
 }
 
 void ConsoleSingleton::NotifyMessage(const char *sMsg)
@@ -334,6 +549,14 @@ void ConsoleSingleton::NotifyLog(const char *sMsg)
     }
 }
 
+void ConsoleSingleton::NotifyTiming(const char *sName, double dSeconds)
+{
+    for(std::set<ConsoleObserver * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();Iter++) {
+        if((*Iter)->bLog)
+            (*Iter)->Timing(sName, dSeconds);   // send record to the listener
+    }
+}
+
 ConsoleObserver *ConsoleSingleton::Get(const char *Name) const
 {
     const char* OName;
@@ -52,6 +52,7 @@
  
 namespace Base {
 class ConsoleSingleton;
+struct ConsoleSingletonP;
 } // namespace Base
 
 typedef Base::ConsoleSingleton ConsoleMsgType;
@@ -79,6 +80,8 @@ public:
     virtual void Error  (const char *)=0;
     /// get calles when a Log Message is issued
     virtual void Log    (const char *){}
+    /// get calles when a timing is issued, the default passes it as Log Message
+    virtual void Timing (const char *sName, double dSeconds);
 
     virtual const char *Name(void){return 0L;}
     bool bErr,bMsg,bLog,bWrn;
@@ -100,6 +103,13 @@ public:
  *  \par
  *  ConsoleSingleton is abel to switch between several modes to, e.g. switch
  *  the logging on or off, or treat Warnings as Errors, and so on...
+ *  \par
+ *  The console can be used from any thread. Each call formats into its own
+ *  buffer and only if an observer takes the message type. The observers are
+ *  always notified in the main thread, i.e. the thread that created the
+ *  console: messages of other threads are put into a lock-free queue that is
+ *  delivered by the next console call of the main thread, by Flush() or by
+ *  the event loop of the main thread.
  *  @see ConsoleObserver
  */
 class BaseExport ConsoleSingleton
@@ -116,6 +126,10 @@ public:
     virtual void Error   ( const char * pMsg, ... ) ;
     /// Prints a log Message 
     virtual void Log     ( const char * pMsg, ... ) ;
+    /// Reports the duration of a named step as log record
+    void Timing(const char * sName, double dSeconds);
+    /// Delivers the queued messages of other threads, does nothing outside the main thread
+    void Flush(void);
 
     /// Delivers a time/date string 
     const char* Time(void);
@@ -143,6 +157,8 @@ public:
     ConsoleMsgFlags SetEnabledMsgType(const char* sObs, ConsoleMsgFlags type, bool b);
     /// Enables or disables message types of a cetain console observer
     bool IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType type) const;
+    /// Checks if any observer takes messages of this type, used to skip formatting
+    bool IsMsgTypeEnabled(FreeCAD_ConsoleMsgType type) const;
 
     /// singleton 
     static ConsoleSingleton &Instance(void);
@@ -174,13 +190,18 @@ private:
     static ConsoleSingleton *_pcSingleton;
 
     // observer processing 
+    void Dispatch(FreeCAD_ConsoleMsgType type, const char *sMsg, double dSeconds, bool bTiming);
+    void Notify  (FreeCAD_ConsoleMsgType type, const char *sMsg, double dSeconds, bool bTiming);
+    void UpdateMsgMask(void) const;
     void NotifyMessage(const char *sMsg);
     void NotifyWarning(const char *sMsg);
     void NotifyError  (const char *sMsg);
     void NotifyLog    (const char *sMsg);
+    void NotifyTiming (const char *sName, double dSeconds);
 
     // observer list
     std::set<ConsoleObserver * > _aclObservers;
+    ConsoleSingletonP* d;
 };
 
 /** Access to the Console
@@ -23,12 +23,17 @@
 
 #include "PreCompiled.h"
 
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QThread>
+
 #include "FutureWatcherProgress.h"
 
 using namespace Base;
 
 FutureWatcherProgress::FutureWatcherProgress(const char* text, unsigned int steps)
-  : seq(text, 100), steps(steps), current(0)
+  : seq(text, steps)
 {
 }
 
@@ -36,15 +41,41 @@ FutureWatcherProgress::~FutureWatcherProgress()
 {
 }
 
+ConcurrentProgress& FutureWatcherProgress::progress()
+{
+    return seq;
+}
+
+bool FutureWatcherProgress::isCanceled() const
+{
+    return seq.isCanceled();
+}
+
 void FutureWatcherProgress::progressValueChanged(int v)
 {
-    if (steps == 0)
+    bool wasCanceled = seq.isCanceled();
+    if (v > 0)
+        seq.setProgress((size_t)v);
+    if (!wasCanceled && seq.isCanceled())
+        Q_EMIT canceled();
+}
+
+void Base::waitForFinished(const QFuture<void>& future)
+{
+    // without a running event loop the finished() signal would never be delivered
+    QCoreApplication* app = QCoreApplication::instance();
+    if (!app || app->thread() != QThread::currentThread()) {
+        QFuture<void> f = future;
+        f.waitForFinished();
         return;
-    unsigned int step = (100 * v) / steps;
-    if (step > current) {
-        current = step;
-        seq.next();
     }
+
+    QFutureWatcher<void> watcher;
+    QEventLoop loop;
+    QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+    watcher.setFuture(future);
+    if (!watcher.isFinished())
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
 }
 
 #include "moc_FutureWatcherProgress.cpp"
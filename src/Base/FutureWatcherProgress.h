@@ -24,12 +24,19 @@
 #ifndef BASE_FUTUREWATCHER_H
 #define BASE_FUTUREWATCHER_H
 
+#include <QFuture>
 #include <QObject>
 #include <Base/Sequencer.h>
 
 namespace Base
 {
 
+/**
+ * Passes the progress of a QFutureWatcher to the sequencer. Connect its
+ * progressValueChanged(int) signal to the slot of the same name and the
+ * canceled() signal to the cancel() slot of the watcher.
+ * @see ConcurrentProgress
+ */
 class BaseExport FutureWatcherProgress : public QObject
 {
     Q_OBJECT
@@ -38,13 +45,28 @@ public:
     FutureWatcherProgress(const char* text, unsigned int steps);
     ~FutureWatcherProgress();
 
+    /** The progress, e.g. to create sub-progresses for the stages of a pipeline. */
+    ConcurrentProgress& progress();
+    bool isCanceled() const;
+
+Q_SIGNALS:
+    /** Emitted once if the user canceled the operation. */
+    void canceled();
+
 private Q_SLOTS:
     void progressValueChanged(int v);
 
 private:
-    Base::SequencerLauncher seq;
-    unsigned int steps, current;
+    Base::ConcurrentProgress seq;
 };
+
+/**
+ * Waits until \a future has finished. Called from the thread of the application it
+ * processes the events except for user input meanwhile, so that the progress reported
+ * by the worker threads is shown. Without an application instance, e.g. in console
+ * mode, or from another thread it simply blocks.
+ */
+BaseExport void waitForFinished(const QFuture<void>& future);
 }
 
 #endif // BASE_FUTUREWATCHER_H 
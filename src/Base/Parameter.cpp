@@ -59,6 +59,9 @@
 #ifdef FC_OS_LINUX
 #   include <unistd.h>
 #endif
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 #include "Parameter.h"
 #include "Exception.h"
@@ -190,6 +193,158 @@ inline bool DOMTreeErrorReporter::getSawErrors() const
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 
+//**************************************************************************
+//**************************************************************************
+// ParameterGrpP
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+/// The DOM element of a parameter and its parsed value
+template <class T>
+struct ParameterEntry
+{
+    ParameterEntry() : element(0), value(), isSet(false) {}
+    DOMElement *element;
+    T value;
+    bool isSet; /**< false for a new element and for a text element without text */
+};
+
+struct ParameterGrpP
+{
+    typedef boost::unordered_map<std::string, ParameterEntry<bool> > BoolMap;
+    typedef boost::unordered_map<std::string, ParameterEntry<long> > IntMap;
+    typedef boost::unordered_map<std::string, ParameterEntry<unsigned long> > UnsignedMap;
+    typedef boost::unordered_map<std::string, ParameterEntry<double> > FloatMap;
+    typedef boost::unordered_map<std::string, ParameterEntry<std::string> > TextMap;
+    typedef boost::unordered_map<std::string, DOMElement*> GroupMap;
+
+    ParameterGrpP() : dirty(new bool(false)), indexed(false), batch(0), cleared(false) {}
+    void clear();
+    void build(DOMElement *group);
+
+    /// the changed flag of the document, shared by all groups of a ParameterManager
+    boost::shared_ptr<bool> dirty;
+
+    bool indexed;
+    BoolMap bools;
+    IntMap ints;
+    UnsignedMap uints;
+    FloatMap floats;
+    TextMap texts;
+    GroupMap groups;
+
+    int batch;
+    bool cleared; /**< Clear() was called during the batch */
+    std::vector<std::string> pending;
+    boost::unordered_set<std::string> pendingNames;
+};
+
+template <class T>
+static void addEntry(boost::unordered_map<std::string, ParameterEntry<T> > &map,
+                     const std::string &name, DOMElement *element, const T &value, bool isSet = true)
+{
+    // like FindElement() the first element of a name wins
+    if (map.find(name) != map.end())
+        return;
+    ParameterEntry<T> &entry = map[name];
+    entry.element = element;
+    entry.value = value;
+    entry.isSet = isSet;
+}
+
+template <class T>
+static const ParameterEntry<T> *findEntry(const boost::unordered_map<std::string, ParameterEntry<T> > &map,
+                                          const char *Name)
+{
+    typename boost::unordered_map<std::string, ParameterEntry<T> >::const_iterator it = map.find(Name);
+    return it != map.end() ? &it->second : 0;
+}
+
+static DOMElement *createElement(DOMElement *group, const char *Type, const char *Name)
+{
+    XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument *pDocument = group->getOwnerDocument();
+    DOMElement *pcElem = pDocument->createElement(XStr(Type).unicodeForm());
+    pcElem->setAttribute(XStr("Name").unicodeForm(), XStr(Name).unicodeForm());
+    group->appendChild(pcElem);
+    return pcElem;
+}
+
+template <class T>
+static ParameterEntry<T> &findOrCreateEntry(boost::unordered_map<std::string, ParameterEntry<T> > &map,
+                                            DOMElement *group, const char *Type, const char *Name)
+{
+    typename boost::unordered_map<std::string, ParameterEntry<T> >::iterator it = map.find(Name);
+    if (it != map.end())
+        return it->second;
+    ParameterEntry<T> &entry = map[Name];
+    entry.element = createElement(group, Type, Name);
+    return entry;
+}
+
+/// removes the entry and its DOM element, returns false if there is none
+template <class T>
+static bool removeEntry(boost::unordered_map<std::string, ParameterEntry<T> > &map,
+                        DOMElement *group, const char *Name)
+{
+    typename boost::unordered_map<std::string, ParameterEntry<T> >::iterator it = map.find(Name);
+    if (it == map.end())
+        return false;
+    group->removeChild(it->second.element);
+    map.erase(it);
+    return true;
+}
+
+void ParameterGrpP::clear()
+{
+    bools.clear();
+    ints.clear();
+    uints.clear();
+    floats.clear();
+    texts.clear();
+    groups.clear();
+    indexed = false;
+}
+
+void ParameterGrpP::build(DOMElement *group)
+{
+    clear();
+    indexed = true;
+
+    XStr nameAttr("Name");
+    XStr valueAttr("Value");
+    for (DOMNode *clChild = group->getFirstChild(); clChild != 0;  clChild = clChild->getNextSibling()) {
+        if (clChild->getNodeType() != DOMNode::ELEMENT_NODE)
+            continue;
+        DOMElement *pcElem = static_cast<DOMElement*>(clChild);
+        DOMNode *pcName = pcElem->getAttributes()->getNamedItem(nameAttr.unicodeForm());
+        if (!pcName)
+            continue;
+
+        std::string type = StrX(pcElem->getNodeName()).c_str();
+        std::string name = StrX(pcName->getNodeValue()).c_str();
+        if (type == "FCParamGroup") {
+            groups.insert(std::make_pair(name, pcElem));
+        }
+        else if (type == "FCText") {
+            DOMNode *pcText = pcElem->getFirstChild();
+            if (pcText)
+                addEntry(texts, name, pcElem, std::string(StrXUTF8(pcText->getNodeValue()).c_str()));
+            else
+                addEntry(texts, name, pcElem, std::string(), false);
+        }
+        else {
+            std::string value = StrX(pcElem->getAttribute(valueAttr.unicodeForm())).c_str();
+            if (type == "FCBool")
+                addEntry(bools, name, pcElem, value == "1");
+            else if (type == "FCInt")
+                addEntry(ints, name, pcElem, atol(value.c_str()));
+            else if (type == "FCUInt")
+                addEntry(uints, name, pcElem, strtoul(value.c_str(),0,10));
+            else if (type == "FCFloat")
+                addEntry(floats, name, pcElem, atof(value.c_str()));
+        }
+    }
+}
+
 //**************************************************************************
 // Construction/Destruction
 
@@ -197,7 +352,7 @@ inline bool DOMTreeErrorReporter::getSawErrors() const
 /** Default construction
   */
 ParameterGrp::ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode,const char* sName)
-        : Base::Handled(), Subject<const char*>(),_pGroupNode(GroupNode)
+        : Base::Handled(), Subject<const char*>(),_pGroupNode(GroupNode), d(new ParameterGrpP)
 {
     if (sName) _cName=sName;
 }
@@ -208,6 +363,7 @@ ParameterGrp::ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode,
   */
 ParameterGrp::~ParameterGrp()
 {
+    delete d;
 }
 
 //**************************************************************************
@@ -215,15 +371,22 @@ ParameterGrp::~ParameterGrp()
 
 void ParameterGrp::copyTo(Base::Reference<ParameterGrp> Grp)
 {
+    Grp->BeginNotificationBatch();
+
     // delete previos content
     Grp->Clear();
 
     // copy all
     insertTo(Grp);
+
+    Grp->EndNotificationBatch();
 }
 
 void ParameterGrp::insertTo(Base::Reference<ParameterGrp> Grp)
 {
+    // notify each changed entry only once
+    Grp->BeginNotificationBatch();
+
     // copy group
     std::vector<Base::Reference<ParameterGrp> > Grps = GetGroups();
     std::vector<Base::Reference<ParameterGrp> >::iterator It1;
@@ -259,6 +422,8 @@ void ParameterGrp::insertTo(Base::Reference<ParameterGrp> Grp)
     std::vector<std::pair<std::string,unsigned long> >::iterator It6;
     for (It6 = UIntMap.begin();It6 != UIntMap.end();++It6)
         Grp->SetUnsigned(It6->first.c_str(),It6->second);
+
+    Grp->EndNotificationBatch();
 }
 
 void ParameterGrp::exportTo(const char* FileName)
@@ -340,10 +505,19 @@ Base::Reference<ParameterGrp> ParameterGrp::_GetGroup(const char* Name)
     }
 
     // search if Group node already there
-    pcTemp = FindOrCreateElement(_pGroupNode,"FCParamGroup",Name);
+    ParameterGrpP &index = Index();
+    ParameterGrpP::GroupMap::iterator it = index.groups.find(Name);
+    if (it != index.groups.end()) {
+        pcTemp = it->second;
+    }
+    else {
+        pcTemp = createElement(_pGroupNode,"FCParamGroup",Name);
+        index.groups[Name] = pcTemp;
+    }
 
     // create and register handle
     rParamGrp = Base::Reference<ParameterGrp> (new ParameterGrp(pcTemp,Name));
+    rParamGrp->d->dirty = d->dirty;
     _GroupMap[Name] = rParamGrp;
 
     return rParamGrp;
@@ -363,6 +537,7 @@ std::vector<Base::Reference<ParameterGrp> > ParameterGrp::GetGroups(void)
         // already created?
         if (!(rParamGrp=_GroupMap[Name]).isValid()) {
             rParamGrp = Base::Reference<ParameterGrp> (new ParameterGrp(((DOMElement*)pcTemp),Name.c_str()));
+            rParamGrp->d->dirty = d->dirty;
             _GroupMap[Name] = rParamGrp;
         }
         vrParamGrp.push_back( rParamGrp );
@@ -388,7 +563,7 @@ bool ParameterGrp::HasGroup(const char* Name) const
     if ( _GroupMap.find(Name) != _GroupMap.end() )
         return true;
 
-    if ( FindElement(_pGroupNode,"FCParamGroup",Name) != 0 )
+    if ( Index().groups.find(Name) != Index().groups.end() )
         return true;
 
     return false;
@@ -397,24 +572,26 @@ bool ParameterGrp::HasGroup(const char* Name) const
 bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
+    const ParameterEntry<bool> *pcEntry = findEntry(Index().bools,Name);
     // if not return preset
-    if (!pcElem) return bPreset;
-    // if yes check the value and return
-    if (strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1"))
-        return false;
-    else
-        return true;
+    if (!pcEntry) return bPreset;
+    // if yes return the value
+    return pcEntry->value;
 }
 
 void  ParameterGrp::SetBool(const char* Name, bool bValue)
 {
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCBool",Name);
+    ParameterEntry<bool> &entry = findOrCreateEntry(Index().bools,_pGroupNode,"FCBool",Name);
+    // nothing to do if the value doesn't change
+    if (entry.isSet && entry.value == bValue)
+        return;
     // and set the vaue
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+    entry.element->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+    entry.value = bValue;
+    entry.isSet = true;
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 std::vector<bool> ParameterGrp::GetBools(const char * sFilter) const
@@ -464,23 +641,28 @@ std::vector<std::pair<std::string,bool> > ParameterGrp::GetBoolMap(const char *
 long ParameterGrp::GetInt(const char* Name, long lPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
+    const ParameterEntry<long> *pcEntry = findEntry(Index().ints,Name);
     // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    if (!pcEntry) return lPreset;
+    // if yes return the value
+    return pcEntry->value;
 }
 
 void  ParameterGrp::SetInt(const char* Name, long lValue)
 {
     char cBuf[256];
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCInt",Name);
+    ParameterEntry<long> &entry = findOrCreateEntry(Index().ints,_pGroupNode,"FCInt",Name);
+    // nothing to do if the value doesn't change
+    if (entry.isSet && entry.value == lValue)
+        return;
     // and set the vaue
     sprintf(cBuf,"%li",lValue);
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.element->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.value = lValue;
+    entry.isSet = true;
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 std::vector<long> ParameterGrp::GetInts(const char * sFilter) const
@@ -525,23 +707,28 @@ std::vector<std::pair<std::string,long> > ParameterGrp::GetIntMap(const char * s
 unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
+    const ParameterEntry<unsigned long> *pcEntry = findEntry(Index().uints,Name);
     // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+    if (!pcEntry) return lPreset;
+    // if yes return the value
+    return pcEntry->value;
 }
 
 void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
 {
     char cBuf[256];
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCUInt",Name);
+    ParameterEntry<unsigned long> &entry = findOrCreateEntry(Index().uints,_pGroupNode,"FCUInt",Name);
+    // nothing to do if the value doesn't change
+    if (entry.isSet && entry.value == lValue)
+        return;
     // and set the vaue
     sprintf(cBuf,"%lu",lValue);
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.element->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.value = lValue;
+    entry.isSet = true;
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 std::vector<unsigned long> ParameterGrp::GetUnsigneds(const char * sFilter) const
@@ -586,23 +773,30 @@ std::vector<std::pair<std::string,unsigned long> > ParameterGrp::GetUnsignedMap(
 double ParameterGrp::GetFloat(const char* Name, double dPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
+    const ParameterEntry<double> *pcEntry = findEntry(Index().floats,Name);
     // if not return preset
-    if (!pcElem) return dPreset;
-    // if yes check the value and return
-    return atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    if (!pcEntry) return dPreset;
+    // if yes return the value
+    return pcEntry->value;
 }
 
 void  ParameterGrp::SetFloat(const char* Name, double dValue)
 {
     char cBuf[256];
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCFloat",Name);
-    // and set the value
+    ParameterEntry<double> &entry = findOrCreateEntry(Index().floats,_pGroupNode,"FCFloat",Name);
+    // cache the value as it is read back from the document
     sprintf(cBuf,"%.12f",dValue); // use %.12f instead of %f to handle values < 1.0e-6
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    dValue = atof(cBuf);
+    // nothing to do if the value doesn't change
+    if (entry.isSet && entry.value == dValue)
+        return;
+    // and set the value
+    entry.element->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    entry.value = dValue;
+    entry.isSet = true;
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 std::vector<double> ParameterGrp::GetFloats(const char * sFilter) const
@@ -661,8 +855,12 @@ void ParameterGrp::GetBlob(const char* /*Name*/, void* /*pBuf*/, long /*lMaxLeng
 void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 {
     // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCText",Name);
+    ParameterEntry<std::string> &entry = findOrCreateEntry(Index().texts,_pGroupNode,"FCText",Name);
+    // nothing to do if the value doesn't change
+    if (entry.isSet && entry.value == sValue)
+        return;
     // and set the value
+    DOMElement *pcElem = entry.element;
     DOMNode *pcElem2 = pcElem->getFirstChild();
     if (!pcElem2) {
         XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument *pDocument = _pGroupNode->getOwnerDocument();
@@ -672,26 +870,20 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
     else {
         pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
     }
+    entry.value = sValue;
+    entry.isSet = true;
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 
 }
 
 std::string ParameterGrp::GetASCII(const char* Name, const char * pPreset) const
 {
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
-    // if not return preset
-    if (!pcElem) {
-        if (pPreset==0)
-            return std::string("");
-        else
-            return std::string(pPreset);
-    }
-    // if yes check the value and return
-    DOMNode *pcElem2 = pcElem->getFirstChild();
-    if (pcElem2)
-        return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
+    const ParameterEntry<std::string> *pcEntry = findEntry(Index().texts,Name);
+    // if yes and it has a text return it, otherwise the preset
+    if (pcEntry && pcEntry->isSet)
+        return pcEntry->value;
     else if (pPreset==0)
         return std::string("");
 
@@ -752,42 +944,36 @@ void ParameterGrp::RemoveGrp(const char* Name)
     _GroupMap.erase(Name);
 
     // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCParamGroup",Name);
+    ParameterGrpP &index = Index();
+    ParameterGrpP::GroupMap::iterator it = index.groups.find(Name);
     // if not return
-    if (!pcElem)
+    if (it == index.groups.end())
         return;
-    else
-        _pGroupNode->removeChild(pcElem);
+    _pGroupNode->removeChild(it->second);
+    index.groups.erase(it);
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 void ParameterGrp::RemoveASCII(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
-    // if not return
-    if (!pcElem)
+    // check if Element in group and remove it
+    if (!removeEntry(Index().texts,_pGroupNode,Name))
         return;
-    else
-        _pGroupNode->removeChild(pcElem);
+
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 
 }
 
 void ParameterGrp::RemoveBool(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
-    // if not return
-    if (!pcElem)
+    // check if Element in group and remove it
+    if (!removeEntry(Index().bools,_pGroupNode,Name))
         return;
-    else
-        _pGroupNode->removeChild(pcElem);
 
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 void ParameterGrp::RemoveBlob(const char* /*Name*/)
@@ -805,44 +991,32 @@ void ParameterGrp::RemoveBlob(const char* /*Name*/)
 
 void ParameterGrp::RemoveFloat(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
-    // if not return
-    if (!pcElem)
+    // check if Element in group and remove it
+    if (!removeEntry(Index().floats,_pGroupNode,Name))
         return;
-    else
-        _pGroupNode->removeChild(pcElem);
 
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 void ParameterGrp::RemoveInt(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
-    // if not return
-    if (!pcElem)
+    // check if Element in group and remove it
+    if (!removeEntry(Index().ints,_pGroupNode,Name))
         return;
-    else
-        _pGroupNode->removeChild(pcElem);
 
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 void ParameterGrp::RemoveUnsigned(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
-    // if not return
-    if (!pcElem)
+    // check if Element in group and remove it
+    if (!removeEntry(Index().uints,_pGroupNode,Name))
         return;
-    else
-        _pGroupNode->removeChild(pcElem);
 
     // trigger observer
-    Notify(Name);
+    Changed(Name);
 }
 
 void ParameterGrp::Clear(void)
@@ -869,8 +1043,9 @@ void ParameterGrp::Clear(void)
         //delete pcTemp;
         pcTemp->release();
     }
+    ResetIndex();
     // trigger observer
-    Notify(0);
+    Changed(0);
 }
 
 //**************************************************************************
@@ -929,6 +1104,56 @@ XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *ParameterGrp::FindOrCreateElement(XER
     return pcElem;
 }
 
+ParameterGrpP& ParameterGrp::Index() const
+{
+    if (!d->indexed)
+        d->build(_pGroupNode);
+    return *d;
+}
+
+void ParameterGrp::ResetIndex()
+{
+    d->clear();
+}
+
+void ParameterGrp::Changed(const char* Name)
+{
+    *d->dirty = true;
+
+    if (d->batch > 0) {
+        if (!Name)
+            d->cleared = true;
+        else if (d->pendingNames.insert(Name).second)
+            d->pending.push_back(Name);
+    }
+    else {
+        Notify(Name);
+    }
+}
+
+void ParameterGrp::BeginNotificationBatch()
+{
+    d->batch++;
+}
+
+void ParameterGrp::EndNotificationBatch()
+{
+    if (d->batch == 0 || --d->batch > 0)
+        return;
+
+    // an observer may change parameters again
+    bool cleared = d->cleared;
+    std::vector<std::string> names;
+    names.swap(d->pending);
+    d->pendingNames.clear();
+    d->cleared = false;
+
+    if (cleared)
+        Notify(0);
+    for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); ++it)
+        Notify(it->c_str());
+}
+
 void ParameterGrp::NotifyAll()
 {
     // get all ints and notify
@@ -1165,6 +1390,8 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSou
     if (!_pGroupNode)
         throw Exception("Malformed Parameter document: Root group not found");
 
+    ResetIndex();
+    SetDirty(false);
     return 1;
 }
 
@@ -1187,6 +1414,7 @@ void  ParameterManager::SaveDocument(const char* sFileName) const
 #endif
         SaveDocument(myFormTarget);
         delete myFormTarget;
+        *d->dirty = false;
     }
     catch (XMLException& e) {
         std::cerr << "An error occurred during creation of output transcoder. Msg is:"
@@ -1310,6 +1538,9 @@ void  ParameterManager::CreateDocument(void)
     _pGroupNode = _pDocument->createElement(XStr("FCParamGroup").unicodeForm());
     ((DOMElement*)_pGroupNode)->setAttribute(XStr("Name").unicodeForm(), XStr("Root").unicodeForm());
     rootElem->appendChild(_pGroupNode);
+
+    ResetIndex();
+    SetDirty(true);
 }
 
 void  ParameterManager::CheckDocument() const
@@ -1317,6 +1548,16 @@ void  ParameterManager::CheckDocument() const
 
 }
 
+bool  ParameterManager::IsDirty() const
+{
+    return *d->dirty;
+}
+
+void  ParameterManager::SetDirty(bool on)
+{
+    *d->dirty = on;
+}
+
 
 //**************************************************************************
 //**************************************************************************
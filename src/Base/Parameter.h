@@ -65,6 +65,7 @@ class InputSource;
 XERCES_CPP_NAMESPACE_END
 
 class ParameterManager;
+struct ParameterGrpP;
 
 
 /** The parameter container class
@@ -76,6 +77,11 @@ class ParameterManager;
  *  and exporting groups of parameters and enables streaming
  *  to a persistent medium via XML.
  *  \par
+ *  The values of a group are indexed in a hash table with their parsed value
+ *  on first access, so reading a parameter does not search and transcode the
+ *  DOM. Setting a parameter to its current value changes nothing and does not
+ *  notify the observers.
+ *  \par
  *  Its main task is making user parameter persitent, saving
  *  last used values in dialog boxes, setting and retrieving all
  *  kind of preferences and so on.
@@ -219,6 +225,17 @@ public:
      */
     void NotifyAll();
 
+    /** @name notification batches */
+    //@{
+    /** Defers the notification of the observers until the matching
+     *  EndNotificationBatch(). Then each changed entry is notified once, in
+     *  the order of its first change. Batches can be nested.
+     */
+    void BeginNotificationBatch();
+    /// ends a batch started with BeginNotificationBatch()
+    void EndNotificationBatch();
+    //@}
+
 protected:
     /// constructor is protected (handle concept)
     ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode=0L,const char* sName=0L);
@@ -244,6 +261,13 @@ protected:
      */
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *FindOrCreateElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *Start, const char* Type, const char* Name) const;
 
+    /// the index of the entries of this group, built on first use
+    ParameterGrpP& Index() const;
+    /// drops the index, e.g. if the DOM node of the group was replaced
+    void ResetIndex();
+    /// marks the document as changed and notifies or queues the observers
+    void Changed(const char* Name);
+
 
     /// DOM Node of the Base node of this group
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *_pGroupNode;
@@ -251,6 +275,8 @@ protected:
     std::string _cName;
     /// map of already exported groups
     std::map <std::string ,Base::Reference<ParameterGrp> > _GroupMap;
+    /// index and notification state
+    ParameterGrpP *d;
 
 };
 
@@ -275,6 +301,12 @@ public:
     void  CreateDocument(void);
     void  CheckDocument() const;
 
+    /** Checks if a parameter has changed since the document was loaded or
+     *  saved to a file. A newly created document is always changed.
+     */
+    bool  IsDirty() const;
+    void  SetDirty(bool);
+
 private:
 
     XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument   *_pDocument;
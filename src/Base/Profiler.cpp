@@ -0,0 +1,367 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <iomanip>
+# include <map>
+# include <sstream>
+# ifdef FC_OS_WIN32
+# include <windows.h>
+# else
+# include <sys/time.h>
+# endif
+# include <QMutex>
+# include <QMutexLocker>
+# include <QThread>
+#endif
+
+#include "Profiler.h"
+#include "FileInfo.h"
+#include "PyObjectBase.h"
+#include "Stream.h"
+
+using namespace Base;
+
+namespace Base {
+
+struct ProfileEvent
+{
+    std::string name;
+    std::string detail;
+    int thread;
+    double start;
+    double value; /**< The duration of a zone or the value of a counter */
+    bool counter;
+};
+
+struct ProfilerP
+{
+    QMutex mutex;
+    double origin;
+    std::vector<ProfileEvent> events;
+    std::map<Qt::HANDLE, int> threads;
+
+    /// small number of the current thread, the mutex must be locked
+    int currentThread()
+    {
+        Qt::HANDLE id = QThread::currentThreadId();
+        std::map<Qt::HANDLE, int>::iterator it = threads.find(id);
+        if (it != threads.end())
+            return it->second;
+        int index = (int)threads.size();
+        threads[id] = index;
+        return index;
+    }
+};
+
+static double microseconds()
+{
+#ifdef FC_OS_WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart * 1.0e6 / (double)freq.QuadPart;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return (double)tv.tv_sec * 1.0e6 + (double)tv.tv_usec;
+#endif
+}
+
+static void writeJsonString(std::ostream& str, const std::string& s)
+{
+    str << '"';
+    for (std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+        unsigned char c = (unsigned char)*it;
+        switch (c) {
+        case '"':  str << "\\\""; break;
+        case '\\': str << "\\\\"; break;
+        case '\n': str << "\\n"; break;
+        case '\r': str << "\\r"; break;
+        case '\t': str << "\\t"; break;
+        default:
+            if (c < 0x20)
+                str << "\\u00" << std::hex << std::setw(2) << std::setfill('0') << (int)c
+                    << std::dec << std::setfill(' ');
+            else
+                str << *it;
+            break;
+        }
+    }
+    str << '"';
+}
+
+struct SummaryGreater
+{
+    bool operator()(const Profiler::Summary& a, const Profiler::Summary& b) const
+    { return a.total > b.total; }
+};
+
+} // namespace Base
+
+//**************************************************************************
+// Construction destruction
+
+bool Profiler::_enabled = false;
+Profiler* Profiler::_pcSingleton = 0;
+
+Profiler::Profiler()
+  : d(new ProfilerP)
+{
+    d->origin = microseconds();
+}
+
+Profiler::~Profiler()
+{
+    delete d;
+}
+
+Profiler& Profiler::Instance(void)
+{
+    if (!_pcSingleton)
+        _pcSingleton = new Profiler();
+    return *_pcSingleton;
+}
+
+void Profiler::setEnabled(bool on)
+{
+    _enabled = on;
+}
+
+void Profiler::clear(void)
+{
+    QMutexLocker locker(&d->mutex);
+    d->events.clear();
+}
+
+double Profiler::now(void) const
+{
+    return microseconds() - d->origin;
+}
+
+void Profiler::addZone(const char* name, const std::string& detail, double start, double end)
+{
+    ProfileEvent ev;
+    ev.name = name;
+    ev.detail = detail;
+    ev.start = start;
+    ev.value = end - start;
+    ev.counter = false;
+
+    QMutexLocker locker(&d->mutex);
+    ev.thread = d->currentThread();
+    d->events.push_back(ev);
+}
+
+void Profiler::addCounter(const char* name, double value)
+{
+    ProfileEvent ev;
+    ev.name = name;
+    ev.start = now();
+    ev.value = value;
+    ev.counter = true;
+
+    QMutexLocker locker(&d->mutex);
+    ev.thread = d->currentThread();
+    d->events.push_back(ev);
+}
+
+std::vector<Profiler::Summary> Profiler::summary(void) const
+{
+    std::map<std::string, Summary> zones;
+    {
+        QMutexLocker locker(&d->mutex);
+        for (std::vector<ProfileEvent>::const_iterator it = d->events.begin(); it != d->events.end(); ++it) {
+            if (it->counter)
+                continue;
+            double secs = it->value * 1.0e-6;
+            std::map<std::string, Summary>::iterator jt = zones.find(it->name);
+            if (jt == zones.end()) {
+                Summary s;
+                s.name = it->name;
+                s.count = 1;
+                s.total = secs;
+                s.max = secs;
+                zones[it->name] = s;
+            }
+            else {
+                jt->second.count++;
+                jt->second.total += secs;
+                jt->second.max = std::max<double>(jt->second.max, secs);
+            }
+        }
+    }
+
+    std::vector<Summary> result;
+    for (std::map<std::string, Summary>::iterator it = zones.begin(); it != zones.end(); ++it)
+        result.push_back(it->second);
+    std::sort(result.begin(), result.end(), SummaryGreater());
+    return result;
+}
+
+void Profiler::writeTrace(std::ostream& str) const
+{
+    QMutexLocker locker(&d->mutex);
+    str << std::fixed << std::setprecision(3);
+    str << "{\"traceEvents\":[";
+    for (std::vector<ProfileEvent>::const_iterator it = d->events.begin(); it != d->events.end(); ++it) {
+        if (it != d->events.begin())
+            str << ",";
+        str << "\n{\"name\":";
+        writeJsonString(str, it->name);
+        if (it->counter) {
+            str << ",\"ph\":\"C\",\"ts\":" << it->start
+                << ",\"pid\":1,\"tid\":" << it->thread
+                << ",\"args\":{\"value\":" << it->value << "}}";
+        }
+        else {
+            str << ",\"cat\":\"FreeCAD\",\"ph\":\"X\",\"ts\":" << it->start
+                << ",\"dur\":" << it->value
+                << ",\"pid\":1,\"tid\":" << it->thread;
+            if (!it->detail.empty()) {
+                str << ",\"args\":{\"detail\":";
+                writeJsonString(str, it->detail);
+                str << "}";
+            }
+            str << "}";
+        }
+    }
+    str << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+//**************************************************************************
+// ProfileZone
+
+void ProfileZone::begin(const char* name, const char* detail)
+{
+    _name = name;
+    if (detail)
+        _detail = detail;
+    _start = Profiler::Instance().now();
+}
+
+void ProfileZone::end(void)
+{
+    Profiler& prof = Profiler::Instance();
+    prof.addZone(_name, _detail, _start, prof.now());
+}
+
+//**************************************************************************
+// Python stuff
+
+PyMethodDef Profiler::Methods[] = {
+    {"setEnabled",    (PyCFunction) Profiler::sPySetEnabled, 1,
+     "setEnabled(bool) -- Switch the recording of zones and counters on or off"},
+    {"isEnabled",     (PyCFunction) Profiler::sPyIsEnabled, 1,
+     "isEnabled() -- Check if zones and counters are recorded"},
+    {"clear",         (PyCFunction) Profiler::sPyClear, 1,
+     "clear() -- Remove all recorded data"},
+    {"addCounter",    (PyCFunction) Profiler::sPyAddCounter, 1,
+     "addCounter(string,float) -- Record the value of a counter"},
+    {"summary",       (PyCFunction) Profiler::sPySummary, 1,
+     "summary() -- List of (name, count, total seconds, max seconds) of the zones,\n"
+     "sorted by the total time"},
+    {"exportTrace",   (PyCFunction) Profiler::sPyExport, 1,
+     "exportTrace(string) -- Write the recorded data to a JSON file in the Chrome trace\n"
+     "event format, it can be loaded with chrome://tracing"},
+    {NULL, NULL, 0, NULL}		/* Sentinel */
+};
+
+PyObject *Profiler::sPySetEnabled(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    PyObject *on;
+    if (!PyArg_ParseTuple(args, "O!", &PyBool_Type, &on))
+        return NULL;
+    Instance().setEnabled(PyObject_IsTrue(on) ? true : false);
+    Py_Return;
+}
+
+PyObject *Profiler::sPyIsEnabled(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    return PyBool_FromLong(isEnabled() ? 1 : 0);
+}
+
+PyObject *Profiler::sPyClear(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    Instance().clear();
+    Py_Return;
+}
+
+PyObject *Profiler::sPyAddCounter(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    char *name;
+    double value;
+    if (!PyArg_ParseTuple(args, "sd", &name, &value))
+        return NULL;
+    if (isEnabled())
+        Instance().addCounter(name, value);
+    Py_Return;
+}
+
+PyObject *Profiler::sPySummary(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    PY_TRY {
+        std::vector<Summary> zones = Instance().summary();
+        Py::List list;
+        for (std::vector<Summary>::iterator it = zones.begin(); it != zones.end(); ++it) {
+            Py::Tuple item(4);
+            item.setItem(0, Py::String(it->name));
+            item.setItem(1, Py::Int((long)it->count));
+            item.setItem(2, Py::Float(it->total));
+            item.setItem(3, Py::Float(it->max));
+            list.append(item);
+        }
+        return Py::new_reference_to(list);
+    } PY_CATCH;
+}
+
+PyObject *Profiler::sPyExport(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    char *fileName;
+    if (!PyArg_ParseTuple(args, "et", "utf-8", &fileName))
+        return NULL;
+    std::string name = fileName;
+    PyMem_Free(fileName);
+
+    PY_TRY {
+        Base::FileInfo fi(name);
+        Base::ofstream str(fi, std::ios::out | std::ios::binary);
+        if (!str) {
+            std::string msg = "Cannot open file '" + name + "' for writing";
+            PyErr_SetString(PyExc_IOError, msg.c_str());
+            return NULL;
+        }
+        Instance().writeTrace(str);
+    } PY_CATCH;
+
+    Py_Return;
+}
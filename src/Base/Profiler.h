@@ -0,0 +1,135 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BASE_PROFILER_H
+#define BASE_PROFILER_H
+
+#include <Base/PyExport.h>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Base
+{
+
+struct ProfilerP;
+
+/**
+ * The Profiler class records the time spent in named zones and the values of
+ * counters of all threads. It is switched off by default and then a zone costs
+ * only the check of a flag.
+ *
+ * Zones are recorded with ProfileZone instances on the stack, an optional
+ * detail, e.g. the name of an object, is shown with each zone:
+ * \code
+ * void Document::recompute()
+ * {
+ *     Base::ProfileZone zone("Document::recompute", getName());
+ *     ...
+ * }
+ * \endcode
+ *
+ * The recorded data can be summed up per zone name with summary() or written
+ * in the trace event format of Chrome (chrome://tracing) with writeTrace().
+ * In Python the profiler is available as FreeCAD.Profiler.
+ */
+class BaseExport Profiler
+{
+public:
+    /// The total time of all zones with the same name
+    struct Summary {
+        std::string name;
+        unsigned long count;
+        double total; /**< in seconds */
+        double max;   /**< in seconds */
+    };
+
+    static Profiler& Instance(void);
+    /// Checks if the profiler records zones and counters
+    static bool isEnabled(void)
+    { return _enabled; }
+    void setEnabled(bool);
+    /// Removes all recorded data
+    void clear(void);
+
+    /// The time in microseconds since the profiler was created
+    double now(void) const;
+    /// Records a zone, the times are in microseconds as returned by now()
+    void addZone(const char* name, const std::string& detail, double start, double end);
+    /// Records the value of a counter at the current time
+    void addCounter(const char* name, double value);
+
+    std::vector<Summary> summary(void) const;
+    /// Writes the recorded data as JSON in the Chrome trace event format
+    void writeTrace(std::ostream&) const;
+
+    static PyMethodDef Methods[];
+
+protected:
+    static PyObject *sPySetEnabled(PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sPyIsEnabled (PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sPyClear     (PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sPyAddCounter(PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sPySummary   (PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sPyExport    (PyObject *self,PyObject *args,PyObject *kwd);
+
+private:
+    Profiler();
+    ~Profiler();
+
+    static bool _enabled;
+    static Profiler* _pcSingleton;
+    ProfilerP* d;
+};
+
+/**
+ * Records the time from its construction to its destruction as zone of the
+ * profiler, if enabled. Instances must be created on the stack.
+ */
+class BaseExport ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name)
+      : _name(0), _start(0.0)
+    { if (Profiler::isEnabled()) begin(name, 0); }
+    ProfileZone(const char* name, const char* detail)
+      : _name(0), _start(0.0)
+    { if (Profiler::isEnabled()) begin(name, detail); }
+    ~ProfileZone()
+    { if (_name) end(); }
+
+private:
+    void begin(const char* name, const char* detail);
+    void end(void);
+
+    ProfileZone(const ProfileZone&);
+    ProfileZone& operator=(const ProfileZone&);
+
+    const char* _name;
+    std::string _detail;
+    double _start;
+};
+
+} // namespace Base
+
+#endif // BASE_PROFILER_H
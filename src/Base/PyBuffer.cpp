@@ -0,0 +1,104 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <string>
+#endif
+
+#include <CXX/Exception.hxx>
+
+#include "PyBuffer.h"
+
+using namespace Base;
+
+
+PyBufferReader::PyBufferReader(PyObject* obj)
+  : type(UInt8), count(0)
+{
+    if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+        throw Py::Exception(); // the Python error is already set
+
+    // a missing format means unsigned bytes, a byte order prefix must be the native one
+    const char* fmt = view.format ? view.format : "B";
+    unsigned short one = 1;
+    bool little = *reinterpret_cast<unsigned char*>(&one) == 1;
+    if (*fmt == '@' || *fmt == '=' || (*fmt == '<' && little) || ((*fmt == '>' || *fmt == '!') && !little))
+        fmt++;
+
+    bool valid = (fmt[0] != '\0' && fmt[1] == '\0' && view.itemsize > 0);
+    if (valid) {
+        switch (fmt[0]) {
+        case 'f':
+            type = Float;
+            valid = (view.itemsize == sizeof(float));
+            break;
+        case 'd':
+            type = Double;
+            valid = (view.itemsize == sizeof(double));
+            break;
+        case 'b': case 'h': case 'i': case 'l': case 'q':
+        case 'B': case 'H': case 'I': case 'L': case 'Q':
+            {
+                // the size of the integer types depends on the platform
+                bool sign = (fmt[0] >= 'a');
+                switch (view.itemsize) {
+                case 1: type = sign ? Int8 : UInt8; break;
+                case 2: type = sign ? Int16 : UInt16; break;
+                case 4: type = sign ? Int32 : UInt32; break;
+                case 8: type = sign ? Int64 : UInt64; break;
+                default: valid = false; break;
+                }
+            }
+            break;
+        default:
+            valid = false;
+            break;
+        }
+    }
+
+    if (!valid) {
+        std::string msg = "Unsupported buffer format '";
+        msg += (view.format ? view.format : "");
+        msg += "', expect float, double or integer items";
+        PyBuffer_Release(&view);
+        throw Py::TypeError(msg);
+    }
+
+    count = view.len / view.itemsize;
+}
+
+PyBufferReader::~PyBufferReader()
+{
+    PyBuffer_Release(&view);
+}
+
+PyObject* Base::createByteArray(Py_ssize_t size, char*& data)
+{
+    PyObject* array = PyByteArray_FromStringAndSize(0, size);
+    if (!array)
+        throw Py::Exception();
+    data = PyByteArray_AsString(array);
+    return array;
+}
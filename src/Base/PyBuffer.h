@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BASE_PYBUFFER_H
+#define BASE_PYBUFFER_H
+
+// Std. configurations
+#include <Python.h>
+
+namespace Base
+{
+
+/**
+ * Read access to the memory of a Python object that supports the buffer
+ * protocol, e.g. a numpy array, a bytearray or a string. The memory must be
+ * C contiguous and hold float, double or integer items in native byte order.
+ * Bulk data can be passed this way without creating a Python object per item.
+ * @code
+ * PY_TRY {
+ *     Base::PyBufferReader buf(obj);
+ *     std::vector<float> data(buf.size());
+ *     buf.copyTo(&data[0]);
+ * } PY_CATCH;
+ * @endcode
+ */
+class BaseExport PyBufferReader
+{
+public:
+    /// throws Py::TypeError if the object has no suitable buffer
+    PyBufferReader(PyObject* obj);
+    ~PyBufferReader();
+
+    /// number of items of the buffer
+    Py_ssize_t size() const
+    { return count; }
+    /// copies all items converted to T, \a out must have room for size() items
+    template <class T>
+    void copyTo(T* out) const;
+
+private:
+    enum ItemType { Float, Double, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64 };
+
+    template <class S, class T>
+    static void copyItems(const void* in, T* out, Py_ssize_t n)
+    {
+        const S* src = static_cast<const S*>(in);
+        for (Py_ssize_t i = 0; i < n; i++)
+            out[i] = static_cast<T>(src[i]);
+    }
+
+    PyBufferReader(const PyBufferReader&);
+    PyBufferReader& operator=(const PyBufferReader&);
+
+    Py_buffer view;
+    ItemType type;
+    Py_ssize_t count;
+};
+
+template <class T>
+void PyBufferReader::copyTo(T* out) const
+{
+    const void* in = view.buf;
+    switch (type) {
+    case Float:  copyItems<float>(in, out, count); break;
+    case Double: copyItems<double>(in, out, count); break;
+    case Int8:   copyItems<signed char>(in, out, count); break;
+    case UInt8:  copyItems<unsigned char>(in, out, count); break;
+    case Int16:  copyItems<short>(in, out, count); break;
+    case UInt16: copyItems<unsigned short>(in, out, count); break;
+    case Int32:  copyItems<int>(in, out, count); break;
+    case UInt32: copyItems<unsigned int>(in, out, count); break;
+    case Int64:  copyItems<PY_LONG_LONG>(in, out, count); break;
+    case UInt64: copyItems<unsigned PY_LONG_LONG>(in, out, count); break;
+    }
+}
+
+/** Creates a bytearray of \a size bytes, \a data is set to its memory.
+ * Filling the memory directly is the only copy needed to pass bulk data to Python,
+ * e.g. numpy.frombuffer(data, numpy.float32) uses the bytearray without a copy.
+ */
+BaseExport PyObject* createByteArray(Py_ssize_t size, char*& data);
+
+} // namespace Base
+
+#endif // BASE_PYBUFFER_H
@@ -40,6 +40,7 @@
 #include "InputSource.h"
 #include "Console.h"
 #include "Sequencer.h"
+#include "Profiler.h"
 
 #include <zipios++/zipios-config.h>
 #include <zipios++/zipfile.h>
@@ -304,6 +305,7 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
         // no file name for the current entry in the zip was registered.
         if (jt != FileList.end()) {
             try {
+                Base::ProfileZone zone("RestoreDocFile", jt->FileName.c_str());
                 Base::Reader reader(zipstream,DocumentSchema);
                 jt->Object->RestoreDocFile(reader);
             }
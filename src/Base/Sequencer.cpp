@@ -26,6 +26,7 @@
 #ifndef _PreComp_
 # include <cstdio>
 # include <algorithm>
+# include <QAtomicInt>
 # include <QMutex>
 # include <QMutexLocker>
 #endif
@@ -250,6 +251,12 @@ void ConsoleSequencer::nextStep( bool )
         printf("\t\t\t\t\t\t(%2.1f %%)\t\r", (float)progressInPercent());
 }
 
+void ConsoleSequencer::setProgress(size_t step)
+{
+    if (this->nTotalSteps != 0)
+        printf("\t\t\t\t\t\t(%2.1f %%)\t\r", (100.0f * (float)step) / (float)this->nTotalSteps);
+}
+
 void ConsoleSequencer::resetData()
 {
     SequencerBase::resetData();
@@ -295,7 +302,11 @@ bool SequencerLauncher::next(bool canAbort)
 void SequencerLauncher::setProgress(size_t pos)
 {
     QMutexLocker locker(&SequencerP::mutex);
-    SequencerBase::Instance().setProgress(pos);
+    if (SequencerP::_topLauncher != this)
+        return; // ignore
+    SequencerBase& seq = SequencerBase::Instance();
+    seq.nProgress = pos;
+    seq.setProgress(pos);
 }
 
 size_t SequencerLauncher::numberOfSteps() const
@@ -311,6 +322,121 @@ bool SequencerLauncher::wasCanceled() const
 
 // ---------------------------------------------------------
 
+namespace Base {
+struct ConcurrentProgressP
+{
+    ConcurrentProgress* parent;
+    ConcurrentProgressP* root;
+    size_t parentSteps;
+    size_t steps;
+    QAtomicInt done;
+    QAtomicInt percent; /**< The percentage passed on to the sequencer, only used by the root */
+    QAtomicInt canceled; /**< Only used by the root */
+    SequencerLauncher* seq;
+
+    /** The steps of the parent that correspond to \a n own steps. */
+    size_t toParent(size_t n) const
+    {
+        if (steps == 0)
+            return 0;
+        n = std::min<size_t>(n, steps);
+        return (size_t)((double)n * (double)parentSteps / (double)steps);
+    }
+};
+}
+
+ConcurrentProgress::ConcurrentProgress(const char* pszStr, size_t steps)
+  : d(new ConcurrentProgressP)
+{
+    d->parent = 0;
+    d->root = d;
+    d->parentSteps = 0;
+    d->steps = steps;
+    d->done = 0;
+    d->percent = 0;
+    d->canceled = 0;
+    d->seq = new SequencerLauncher(pszStr, steps);
+}
+
+ConcurrentProgress::ConcurrentProgress(ConcurrentProgress& parent, size_t parentSteps, size_t steps)
+  : d(new ConcurrentProgressP)
+{
+    d->parent = &parent;
+    d->root = parent.d->root;
+    d->parentSteps = parentSteps;
+    d->steps = steps;
+    d->done = 0;
+    d->percent = 0;
+    d->canceled = 0;
+    d->seq = 0;
+}
+
+ConcurrentProgress::~ConcurrentProgress()
+{
+    delete d->seq;
+    delete d;
+}
+
+size_t ConcurrentProgress::numberOfSteps() const
+{
+    return d->steps;
+}
+
+size_t ConcurrentProgress::progress() const
+{
+    return (size_t)(int)d->done;
+}
+
+void ConcurrentProgress::add(size_t n)
+{
+    if (n == 0)
+        return;
+    size_t now = (size_t)(d->done.fetchAndAddRelaxed((int)n) + (int)n);
+
+    if (d->parent) {
+        // the ranges of concurrent calls don't overlap, so the sum of the parts is exact
+        size_t part = d->toParent(now) - d->toParent(now - n);
+        if (part > 0)
+            d->parent->add(part);
+    }
+    else {
+        update(now);
+    }
+}
+
+void ConcurrentProgress::setProgress(size_t pos)
+{
+    size_t now = progress();
+    if (pos > now)
+        add(pos - now);
+}
+
+void ConcurrentProgress::update(size_t now)
+{
+    if (d->steps == 0)
+        return;
+    int perc = (int)((100.0 * (double)std::min<size_t>(now, d->steps)) / (double)d->steps);
+    int last = d->percent;
+    // only the thread that raises the percentage updates the sequencer
+    if (perc > last && d->percent.testAndSetOrdered(last, perc)) {
+        d->seq->setProgress(now);
+        if (d->seq->wasCanceled())
+            cancel();
+    }
+}
+
+void ConcurrentProgress::cancel()
+{
+    d->root->canceled = 1;
+}
+
+bool ConcurrentProgress::isCanceled() const
+{
+    return d->root->canceled != 0;
+}
+
+// ---------------------------------------------------------
+
 void ProgressIndicatorPy::init_type()
 {
     behaviors().name("ProgressIndicator");
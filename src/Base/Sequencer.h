@@ -35,6 +35,7 @@ namespace Base
 
 class AbortException;
 class SequencerLauncher;
+struct ConcurrentProgressP;
 
 /**
  * \brief This class gives the user an indication of the progress of an operation and
@@ -271,6 +272,8 @@ protected:
     void startStep();
     /** Writes the current progress to the console window. */
     void nextStep(bool canAbort);
+    /** Writes the given progress to the console window. */
+    void setProgress(size_t);
 
 private:
     /** Puts text to the console window */
@@ -373,6 +376,78 @@ public:
     bool wasCanceled() const;
 };
 
+/**
+ * \brief The ConcurrentProgress class reports the progress of an operation whose steps
+ * are done by several threads.
+ *
+ * Worker threads report their done steps with add() which is a single atomic operation,
+ * and poll isCanceled() which only reads an atomic flag. The progress is passed on to the
+ * running sequencer only when it has grown by one percent, so the user interface gets
+ * updated at most a hundred times, regardless of the number of steps and threads.
+ *
+ * \code
+ *  Base::ConcurrentProgress progress("Checking...", count);
+ *  QtConcurrent::blockingMap(index, boost::bind(&Checker::check, &checker, _1, &progress));
+ *
+ *  void Checker::check(unsigned long index, Base::ConcurrentProgress* progress)
+ *  {
+ *    if (progress->isCanceled())
+ *      return;
+ *    // do something
+ *    progress->add();
+ *  }
+ * \endcode
+ *
+ * The stages of a pipeline can report their own steps with sub-progresses that take a
+ * part of the steps of their parent. They share the cancel state of the outermost
+ * progress.
+ *
+ * \code
+ *  Base::ConcurrentProgress total("Processing...", 100);
+ *  Base::ConcurrentProgress reading(total, 20, numFiles);  // 20% for reading
+ *  Base::ConcurrentProgress meshing(total, 80, numFaces);  // 80% for meshing
+ * \endcode
+ *
+ * \note The outermost instance must be created in the main thread as it starts the
+ * sequencer with a SequencerLauncher. The number of steps is limited to the range of int.
+ * @see FutureWatcherProgress
+ */
+class BaseExport ConcurrentProgress
+{
+public:
+    /** Starts the sequencer with \a steps steps, must be called in the main thread. */
+    ConcurrentProgress(const char* pszStr, size_t steps);
+    /** Creates a sub-progress whose \a steps make up \a parentSteps steps of \a parent. */
+    ConcurrentProgress(ConcurrentProgress& parent, size_t parentSteps, size_t steps);
+    ~ConcurrentProgress();
+
+    size_t numberOfSteps() const;
+    /** Returns the number of done steps. */
+    size_t progress() const;
+    /** Adds \a n done steps. This method can be called from any thread. */
+    void add(size_t n = 1);
+    /**
+     * Sets the number of done steps, e.g. from the progress of a QFuture. As the progress
+     * cannot go back this must not be mixed with add() of other threads.
+     */
+    void setProgress(size_t);
+    /** Cancels the operation. This method can be called from any thread. */
+    void cancel();
+    /**
+     * Returns true if the operation was canceled with cancel() or by the user.
+     * This method can be called from any thread and is cheap enough for inner loops.
+     */
+    bool isCanceled() const;
+
+private:
+    void update(size_t);
+
+    ConcurrentProgress(const ConcurrentProgress&);
+    ConcurrentProgress& operator=(const ConcurrentProgress&);
+
+    ConcurrentProgressP* d;
+};
+
 /** Access to the only SequencerBase instance */
 inline SequencerBase& Sequencer ()
 {
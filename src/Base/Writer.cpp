@@ -32,6 +32,7 @@
 #include "Exception.h"
 #include "Base64.h"
 #include "FileInfo.h"
+#include "Profiler.h"
 #include "Stream.h"
 #include "Tools.h"
 
@@ -211,6 +212,7 @@ void ZipWriter::writeFiles(void)
     size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList.begin()[index];
+        Base::ProfileZone zone("SaveDocFile", entry.FileName.c_str());
         ZipStream.putNextEntry(entry.FileName);
         entry.Object->SaveDocFile(*this);
         index++;
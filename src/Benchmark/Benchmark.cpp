@@ -0,0 +1,232 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include <QThread>
+
+#include <Base/Exception.h>
+#include <Base/Profiler.h>
+#include <Base/TimeInfo.h>
+#include <App/Application.h>
+
+#include "Benchmark.h"
+
+using namespace Benchmark;
+
+const volatile void* Benchmark::keepSink = 0;
+
+namespace {
+
+struct Entry
+{
+    std::string name;
+    Function function;
+};
+
+struct EntryLess
+{
+    bool operator()(const Entry& a, const Entry& b) const
+    { return a.name < b.name; }
+};
+
+// a function local registry does not depend on the order of static initialization
+std::vector<Entry>& registry()
+{
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+std::vector<Entry> sortedEntries()
+{
+    std::vector<Entry> entries = registry();
+    std::sort(entries.begin(), entries.end(), EntryLess());
+    return entries;
+}
+
+double milliseconds()
+{
+    return Base::Profiler::Instance().now() / 1000.0;
+}
+
+void writeJsonString(std::ostream& str, const std::string& s)
+{
+    str << '"';
+    for (std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+        if (*it == '"' || *it == '\\')
+            str << '\\' << *it;
+        else if ((unsigned char)*it < 0x20)
+            str << ' ';
+        else
+            str << *it;
+    }
+    str << '"';
+}
+
+std::string configValue(const char* key)
+{
+    std::map<std::string, std::string>& cfg = App::Application::Config();
+    std::map<std::string, std::string>::iterator it = cfg.find(key);
+    return it != cfg.end() ? it->second : std::string();
+}
+
+}
+
+Registrar::Registrar(const char* name, Function function)
+{
+    Entry entry;
+    entry.name = name;
+    entry.function = function;
+    registry().push_back(entry);
+}
+
+State::State(double minTime, unsigned long minIterations, unsigned long maxIterations)
+  : minTime(minTime * 1000.0), minIterations(minIterations), maxIterations(maxIterations)
+  , start(0.0), paused(0.0), pauseStart(0.0), total(0.0), running(false), itemsProcessed(0.0)
+{
+}
+
+bool State::keepRunning()
+{
+    double now = milliseconds();
+    if (running) {
+        double time = now - start - paused;
+        iterationTimes.push_back(time);
+        total += time;
+    }
+
+    running = iterationTimes.size() < maxIterations &&
+        (iterationTimes.size() < minIterations || total < minTime);
+    if (running) {
+        paused = 0.0;
+        start = milliseconds();
+    }
+    return running;
+}
+
+void State::pauseTiming()
+{
+    pauseStart = milliseconds();
+}
+
+void State::resumeTiming()
+{
+    paused += milliseconds() - pauseStart;
+}
+
+void Benchmark::listBenchmarks(std::ostream& str)
+{
+    std::vector<Entry> entries = sortedEntries();
+    for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+        str << it->name << std::endl;
+}
+
+int Benchmark::runBenchmarks(const Options& options, std::ostream& out, std::ostream& log)
+{
+    int failed = 0;
+    std::vector<Entry> entries = sortedEntries();
+
+    out << std::fixed << std::setprecision(4);
+    out << "{\n  \"context\": {\n";
+    out << "    \"version\": ";
+    writeJsonString(out, configValue("BuildVersionMajor") + "." +
+                         configValue("BuildVersionMinor") + "." +
+                         configValue("BuildRevision"));
+    out << ",\n    \"date\": ";
+    writeJsonString(out, Base::TimeInfo::currentDateTimeString());
+    out << ",\n    \"threads\": " << QThread::idealThreadCount();
+    out << ",\n    \"min_time\": " << options.minTime;
+    out << "\n  },\n  \"benchmarks\": [";
+
+    bool first = true;
+    for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+        if (!options.filter.empty() && it->name.find(options.filter) == std::string::npos)
+            continue;
+
+        log << it->name << "..." << std::flush;
+        State state(options.minTime, options.minIterations, options.maxIterations);
+        std::string error;
+        try {
+            it->function(state);
+        }
+        catch (const Base::Exception& e) {
+            error = e.what();
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+        catch (...) {
+            error = "unknown exception";
+        }
+
+        std::vector<double> times = state.times();
+        if (error.empty() && times.empty())
+            error = "no iteration was run";
+
+        out << (first ? "\n" : ",\n") << "    {\"name\": ";
+        first = false;
+        writeJsonString(out, it->name);
+        if (!state.getLabel().empty()) {
+            out << ", \"label\": ";
+            writeJsonString(out, state.getLabel());
+        }
+
+        if (!error.empty()) {
+            failed++;
+            log << " failed: " << error << std::endl;
+            out << ", \"error\": ";
+            writeJsonString(out, error);
+            out << "}";
+            continue;
+        }
+
+        std::sort(times.begin(), times.end());
+        double sum = 0.0;
+        for (std::vector<double>::iterator jt = times.begin(); jt != times.end(); ++jt)
+            sum += *jt;
+        double mean = sum / times.size();
+        double median = times[times.size() / 2];
+        if (times.size() % 2 == 0)
+            median = 0.5 * (median + times[times.size() / 2 - 1]);
+
+        out << ", \"iterations\": " << times.size()
+            << ", \"time_unit\": \"ms\""
+            << ", \"min\": " << times.front()
+            << ", \"median\": " << median
+            << ", \"mean\": " << mean;
+        if (state.items() > 0.0 && median > 0.0)
+            out << ", \"items_per_second\": " << state.items() / (median / 1000.0);
+        out << "}";
+
+        log << " " << median << " ms (" << times.size() << " iterations)" << std::endl;
+    }
+
+    out << "\n  ]\n}\n";
+    return failed;
+}
@@ -0,0 +1,154 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BENCHMARK_BENCHMARK_H
+#define BENCHMARK_BENCHMARK_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+
+/**
+ * Random numbers from a linear congruential generator. Unlike rand() the
+ * sequence is the same on all platforms, so the generated test data and
+ * thus the measured times are reproducible.
+ */
+class Random
+{
+public:
+    explicit Random(unsigned long seed = 4711)
+      : state(seed & 0xffffffffUL) {}
+    /// uniformly distributed in [0,1)
+    double next()
+    {
+        state = (1664525UL * state + 1013904223UL) & 0xffffffffUL;
+        return (double)state / 4294967296.0;
+    }
+    /// uniformly distributed in [min,max)
+    double uniform(double min, double max)
+    { return min + (max - min) * next(); }
+
+private:
+    unsigned long state;
+};
+
+/**
+ * The State class controls the iterations of a benchmark. The code between
+ * two calls of keepRunning() is timed, the set-up before the loop is not.
+ * \code
+ * static void MeshGridBuild(Benchmark::State& state)
+ * {
+ *     MeshCore::MeshKernel kernel;
+ *     makeSphere(kernel, ...);
+ *     while (state.keepRunning()) {
+ *         MeshCore::MeshFacetGrid grid(kernel);
+ *         Benchmark::keep(grid);
+ *     }
+ *     state.setItemsProcessed(kernel.CountFacets());
+ * }
+ * FC_BENCHMARK(MeshGridBuild);
+ * \endcode
+ */
+class State
+{
+public:
+    State(double minTime, unsigned long minIterations, unsigned long maxIterations);
+
+    /// returns true as long as another iteration is needed
+    bool keepRunning();
+    /// excludes the time until resumeTiming() from the current iteration
+    void pauseTiming();
+    void resumeTiming();
+    /// the number of items, e.g. facets or points, processed per iteration
+    void setItemsProcessed(double items)
+    { itemsProcessed = items; }
+    /// a short description of the test data
+    void setLabel(const std::string& text)
+    { label = text; }
+
+    /// times of the iterations in milliseconds
+    const std::vector<double>& times() const
+    { return iterationTimes; }
+    double items() const
+    { return itemsProcessed; }
+    const std::string& getLabel() const
+    { return label; }
+
+private:
+    double minTime;
+    unsigned long minIterations;
+    unsigned long maxIterations;
+    std::vector<double> iterationTimes;
+    double start;
+    double paused;
+    double pauseStart;
+    double total;
+    bool running;
+    double itemsProcessed;
+    std::string label;
+};
+
+typedef void (*Function)(State&);
+
+/// Registers a benchmark function, use it through FC_BENCHMARK
+struct Registrar
+{
+    Registrar(const char* name, Function function);
+};
+
+/// The options of a benchmark run
+struct Options
+{
+    Options() : minTime(0.5), minIterations(3), maxIterations(1000) {}
+    std::string filter;    /**< only run benchmarks whose name contains this text */
+    double minTime;        /**< minimal total time of a benchmark in seconds */
+    unsigned long minIterations;
+    unsigned long maxIterations;
+};
+
+/// Lists the names of the registered benchmarks
+void listBenchmarks(std::ostream&);
+/**
+ * Runs the registered benchmarks and writes the results as JSON to \a out.
+ * The progress is written to \a log. Returns the number of failed benchmarks.
+ */
+int runBenchmarks(const Options&, std::ostream& out, std::ostream& log);
+
+extern const volatile void* keepSink;
+
+/// Keeps the compiler from optimizing away the computation of \a value
+template <class T>
+inline void keep(const T& value)
+{
+    keepSink = &value;
+}
+
+} // namespace Benchmark
+
+#define FC_BENCHMARK(function) \
+    static Benchmark::Registrar fc_benchmark_##function(#function, function)
+
+#endif // BENCHMARK_BENCHMARK_H
@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <Base/FileInfo.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/FeatureTest.h>
+
+#include "Benchmark.h"
+
+namespace {
+
+const int objectCount = 2000;
+
+/**
+ * Creates a document with test features, each one is linked to up to three
+ * randomly chosen features created before, so the dependencies form a DAG.
+ */
+App::Document* createDocument(int count)
+{
+    Benchmark::Random random;
+    App::Document* doc = App::GetApplication().newDocument("Benchmark");
+    std::vector<App::DocumentObject*> objects;
+    for (int i = 0; i < count; i++) {
+        App::FeatureTest* obj = static_cast<App::FeatureTest*>
+            (doc->addObject("App::FeatureTest", "Feature"));
+        std::vector<App::DocumentObject*> links;
+        int numLinks = objects.empty() ? 0 : (int)random.uniform(0.0, 4.0);
+        for (int j = 0; j < numLinks; j++) {
+            App::DocumentObject* link = objects[(size_t)random.uniform(0.0, (double)objects.size())];
+            if (std::find(links.begin(), links.end(), link) == links.end())
+                links.push_back(link);
+        }
+        obj->LinkList.setValues(links);
+        objects.push_back(obj);
+    }
+    doc->recompute();
+    return doc;
+}
+
+std::string documentLabel(int count)
+{
+    std::stringstream str;
+    str << count << " objects";
+    return str.str();
+}
+
+std::string tempFileName()
+{
+    return Base::FileInfo::getTempPath() + "FreeCADBenchmarks.FCStd";
+}
+
+void DocumentRecompute(Benchmark::State& state)
+{
+    App::Document* doc = createDocument(objectCount);
+    std::vector<App::DocumentObject*> objects = doc->getObjects();
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        for (std::vector<App::DocumentObject*>::iterator it = objects.begin(); it != objects.end(); ++it)
+            (*it)->touch();
+        state.resumeTiming();
+        doc->recompute();
+    }
+    App::GetApplication().closeDocument(doc->getName());
+    state.setItemsProcessed(objectCount);
+    state.setLabel(documentLabel(objectCount));
+}
+
+void DocumentSave(Benchmark::State& state)
+{
+    App::Document* doc = createDocument(objectCount);
+    std::string fileName = tempFileName();
+    while (state.keepRunning()) {
+        doc->saveAs(fileName.c_str());
+    }
+    App::GetApplication().closeDocument(doc->getName());
+    Base::FileInfo(fileName).deleteFile();
+    state.setItemsProcessed(objectCount);
+    state.setLabel(documentLabel(objectCount));
+}
+
+void DocumentRestore(Benchmark::State& state)
+{
+    App::Document* doc = createDocument(objectCount);
+    std::string fileName = tempFileName();
+    doc->saveAs(fileName.c_str());
+    App::GetApplication().closeDocument(doc->getName());
+    while (state.keepRunning()) {
+        doc = App::GetApplication().openDocument(fileName.c_str());
+        state.pauseTiming();
+        App::GetApplication().closeDocument(doc->getName());
+        state.resumeTiming();
+    }
+    Base::FileInfo(fileName).deleteFile();
+    state.setItemsProcessed(objectCount);
+    state.setLabel(documentLabel(objectCount));
+}
+
+}
+
+FC_BENCHMARK(DocumentRecompute);
+FC_BENCHMARK(DocumentSave);
+FC_BENCHMARK(DocumentRestore);
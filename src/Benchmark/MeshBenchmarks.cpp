@@ -0,0 +1,214 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include <Mod/Mesh/App/Core/Definitions.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+#include <Mod/Mesh/App/Core/Curvature.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+
+#include "Benchmark.h"
+
+using namespace MeshCore;
+
+namespace {
+
+/**
+ * Creates a UV sphere with 2*rings*(segments-1) facets. With \a noise > 0 the
+ * radius of each vertex is changed randomly by up to this fraction which gives
+ * a crumpled surface with self-intersections.
+ */
+void makeSphere(MeshKernel& kernel, const Base::Vector3f& center, float radius,
+                int rings, int segments, float noise = 0.0f)
+{
+    Benchmark::Random random;
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i <= rings; i++) {
+        double theta = D_PI * i / rings;
+        for (int j = 0; j < segments; j++) {
+            double phi = 2.0 * D_PI * j / segments;
+            double r = radius;
+            if (noise > 0.0f && i > 0 && i < rings)
+                r *= 1.0 + random.uniform(-noise, noise);
+            points.push_back(center + Base::Vector3f(
+                (float)(r * sin(theta) * cos(phi)),
+                (float)(r * sin(theta) * sin(phi)),
+                (float)(r * cos(theta))));
+        }
+    }
+
+    std::vector<MeshGeomFacet> facets;
+    for (int i = 0; i < rings; i++) {
+        for (int j = 0; j < segments; j++) {
+            int k = (j + 1) % segments;
+            const Base::Vector3f& p00 = points[i * segments + j];
+            const Base::Vector3f& p01 = points[i * segments + k];
+            const Base::Vector3f& p10 = points[(i + 1) * segments + j];
+            const Base::Vector3f& p11 = points[(i + 1) * segments + k];
+            if (i > 0)
+                facets.push_back(MeshGeomFacet(p00, p10, p01));
+            if (i < rings - 1)
+                facets.push_back(MeshGeomFacet(p01, p10, p11));
+        }
+    }
+
+    kernel = facets;
+}
+
+std::string sphereLabel(const MeshKernel& kernel)
+{
+    std::stringstream str;
+    str << kernel.CountFacets() << " facets";
+    return str.str();
+}
+
+void MeshFacetGridBuild(Benchmark::State& state)
+{
+    MeshKernel kernel;
+    makeSphere(kernel, Base::Vector3f(0.0f, 0.0f, 0.0f), 10.0f, 200, 400);
+    while (state.keepRunning()) {
+        MeshFacetGrid grid(kernel);
+        Benchmark::keep(grid);
+    }
+    state.setItemsProcessed(kernel.CountFacets());
+    state.setLabel(sphereLabel(kernel));
+}
+
+void MeshNearestFacet(Benchmark::State& state)
+{
+    MeshKernel kernel;
+    makeSphere(kernel, Base::Vector3f(0.0f, 0.0f, 0.0f), 10.0f, 200, 400);
+    MeshFacetGrid grid(kernel);
+
+    const int count = 10000;
+    Benchmark::Random random;
+    std::vector<Base::Vector3f> queries;
+    for (int i = 0; i < count; i++) {
+        queries.push_back(Base::Vector3f((float)random.uniform(-12.0, 12.0),
+                                         (float)random.uniform(-12.0, 12.0),
+                                         (float)random.uniform(-12.0, 12.0)));
+    }
+
+    while (state.keepRunning()) {
+        unsigned long sum = 0;
+        for (std::vector<Base::Vector3f>::iterator it = queries.begin(); it != queries.end(); ++it)
+            sum += grid.SearchNearestFromPoint(*it);
+        Benchmark::keep(sum);
+    }
+    state.setItemsProcessed(count);
+    state.setLabel(sphereLabel(kernel));
+}
+
+void MeshSelfIntersection(Benchmark::State& state)
+{
+    MeshKernel kernel;
+    makeSphere(kernel, Base::Vector3f(0.0f, 0.0f, 0.0f), 10.0f, 100, 200, 0.05f);
+    while (state.keepRunning()) {
+        std::vector<std::pair<unsigned long, unsigned long> > intersections;
+        MeshEvalSelfIntersection eval(kernel);
+        eval.GetIntersections(intersections);
+        Benchmark::keep(intersections);
+    }
+    state.setItemsProcessed(kernel.CountFacets());
+    state.setLabel(sphereLabel(kernel));
+}
+
+void MeshLaplaceSmoothing(Benchmark::State& state)
+{
+    MeshKernel original;
+    makeSphere(original, Base::Vector3f(0.0f, 0.0f, 0.0f), 10.0f, 200, 400, 0.02f);
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        MeshKernel kernel = original;
+        state.resumeTiming();
+        LaplaceSmoothing smooth(kernel);
+        smooth.Smooth(10);
+    }
+    state.setItemsProcessed(original.CountPoints());
+    state.setLabel(sphereLabel(original));
+}
+
+void MeshCurvaturePerFace(Benchmark::State& state)
+{
+    MeshKernel kernel;
+    makeSphere(kernel, Base::Vector3f(0.0f, 0.0f, 0.0f), 10.0f, 100, 200);
+    while (state.keepRunning()) {
+        MeshCurvature curvature(kernel);
+        curvature.ComputePerFace(true);
+        Benchmark::keep(curvature.GetCurvature());
+    }
+    state.setItemsProcessed(kernel.CountFacets());
+    state.setLabel(sphereLabel(kernel));
+}
+
+void MeshUnion(Benchmark::State& state)
+{
+    MeshKernel sphere1, sphere2;
+    makeSphere(sphere1, Base::Vector3f(0.0f, 0.0f, 0.0f), 10.0f, 50, 100);
+    makeSphere(sphere2, Base::Vector3f(7.0f, 3.0f, 1.0f), 10.0f, 50, 100);
+    while (state.keepRunning()) {
+        MeshKernel result;
+        SetOperations op(sphere1, sphere2, result, SetOperations::Union);
+        op.Do();
+        Benchmark::keep(result);
+    }
+    state.setItemsProcessed(sphere1.CountFacets() + sphere2.CountFacets());
+    state.setLabel(sphereLabel(sphere1) + " each");
+}
+
+void MeshBinarySTL(Benchmark::State& state)
+{
+    MeshKernel kernel;
+    makeSphere(kernel, Base::Vector3f(0.0f, 0.0f, 0.0f), 10.0f, 200, 400);
+    while (state.keepRunning()) {
+        std::stringstream str;
+        MeshOutput output(kernel);
+        output.SaveBinarySTL(str);
+        MeshKernel copy;
+        MeshInput input(copy);
+        input.LoadBinarySTL(str);
+        Benchmark::keep(copy);
+    }
+    state.setItemsProcessed(kernel.CountFacets());
+    state.setLabel(sphereLabel(kernel));
+}
+
+}
+
+FC_BENCHMARK(MeshFacetGridBuild);
+FC_BENCHMARK(MeshNearestFacet);
+FC_BENCHMARK(MeshSelfIntersection);
+FC_BENCHMARK(MeshLaplaceSmoothing);
+FC_BENCHMARK(MeshCurvaturePerFace);
+FC_BENCHMARK(MeshUnion);
+FC_BENCHMARK(MeshBinarySTL);
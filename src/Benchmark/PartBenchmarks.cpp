@@ -0,0 +1,82 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <sstream>
+#include <vector>
+
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pnt.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/Part/App/PartFeature.h>
+
+#include "Benchmark.h"
+
+namespace {
+
+/// A row of overlapping cylinders, so each fuse step has to split faces
+std::vector<TopoDS_Shape> makeCylinders(int count)
+{
+    std::vector<TopoDS_Shape> shapes;
+    for (int i = 0; i < count; i++) {
+        gp_Ax2 axis(gp_Pnt(1.5 * i, 0.3 * (i % 3), 0.0), gp_Dir(0.0, 0.0, 1.0));
+        shapes.push_back(BRepPrimAPI_MakeCylinder(axis, 1.0, 5.0 + 0.1 * (i % 5)).Shape());
+    }
+    return shapes;
+}
+
+void fuseCylinders(Benchmark::State& state, bool balanced)
+{
+    const int count = 32;
+    std::vector<TopoDS_Shape> shapes = makeCylinders(count);
+    while (state.keepRunning()) {
+        std::vector<Part::ShapeHistory> history;
+        TopoDS_Shape result = Part::Feature::reduceShapes
+            (Part::Feature::BooleanFuse, shapes, history, balanced);
+        Benchmark::keep(result);
+    }
+
+    std::stringstream str;
+    str << count << " cylinders";
+    state.setItemsProcessed(count);
+    state.setLabel(str.str());
+}
+
+void PartFuseBalanced(Benchmark::State& state)
+{
+    fuseCylinders(state, true);
+}
+
+void PartFuseSequential(Benchmark::State& state)
+{
+    fuseCylinders(state, false);
+}
+
+}
+
+FC_BENCHMARK(PartFuseBalanced);
+FC_BENCHMARK(PartFuseSequential);
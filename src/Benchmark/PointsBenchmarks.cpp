@@ -0,0 +1,75 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsAlgos.h>
+
+#include "Benchmark.h"
+
+namespace {
+
+void PointsLoadAscii(Benchmark::State& state)
+{
+    const int count = 200000;
+    std::string fileName = Base::FileInfo::getTempPath() + "FreeCADBenchmarks.asc";
+    Base::FileInfo fi(fileName);
+    {
+        Benchmark::Random random;
+        Base::ofstream str(fi, std::ios::out);
+        str << std::fixed << std::setprecision(6);
+        for (int i = 0; i < count; i++) {
+            str << random.uniform(-100.0, 100.0) << " "
+                << random.uniform(-100.0, 100.0) << " "
+                << random.uniform(-100.0, 100.0) << "\n";
+        }
+    }
+
+    try {
+        while (state.keepRunning()) {
+            Points::PointKernel kernel;
+            Points::PointsAlgos::Load(kernel, fileName.c_str());
+            Benchmark::keep(kernel);
+        }
+    }
+    catch (...) {
+        fi.deleteFile();
+        throw;
+    }
+
+    fi.deleteFile();
+    std::stringstream label;
+    label << count << " points";
+    state.setItemsProcessed(count);
+    state.setLabel(label.str());
+}
+
+}
+
+FC_BENCHMARK(PointsLoadAscii);
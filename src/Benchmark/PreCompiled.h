@@ -0,0 +1,44 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BENCHMARK_PRECOMPILED_H
+#define BENCHMARK_PRECOMPILED_H
+
+#include <FCConfig.h>
+
+// Importing of App classes
+#ifdef FC_OS_WIN32
+# define MeshExport          __declspec(dllimport)
+# define PointsExport        __declspec(dllimport)
+# define PartExport          __declspec(dllimport)
+# define SketcherExport      __declspec(dllimport)
+# define AppRaytracingExport __declspec(dllimport)
+#else // for Linux
+# define MeshExport
+# define PointsExport
+# define PartExport
+# define SketcherExport
+# define AppRaytracingExport
+#endif
+
+#endif // BENCHMARK_PRECOMPILED_H
@@ -0,0 +1,58 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <sstream>
+
+#include <BRepPrimAPI_MakeTorus.hxx>
+#include <BRepTools.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/Raytracing/App/PovTools.h>
+
+#include "Benchmark.h"
+
+namespace {
+
+void RaytracingPovExport(Benchmark::State& state)
+{
+    TopoDS_Shape shape = BRepPrimAPI_MakeTorus(10.0, 3.0).Shape();
+    std::string data;
+    while (state.keepRunning()) {
+        // the triangulation is kept with the shape, remove it to time the meshing
+        state.pauseTiming();
+        BRepTools::Clean(shape);
+        state.resumeTiming();
+
+        std::ostringstream str;
+        Raytracing::PovTools::writeShape(str, "Torus", shape, 0.01f);
+        data = str.str();
+    }
+    state.setItemsProcessed((double)data.size());
+    state.setLabel("torus, deviation 0.01");
+}
+
+}
+
+FC_BENCHMARK(RaytracingPovExport);
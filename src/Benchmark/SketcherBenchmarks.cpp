@@ -0,0 +1,223 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <Mod/Sketcher/App/freegcs/GCS.h>
+#include <Mod/Sketcher/App/freegcs/SubSystem.h>
+
+#include "Benchmark.h"
+
+namespace {
+
+/**
+ * A constraint system of open polylines with alternating horizontal and
+ * vertical segments of fixed length. The first point of each chain is fixed,
+ * so the system is fully constrained and each chain is an independent
+ * component of it. Besides the system each chain gets an own list of the
+ * same constraints to build the subsystems the solver works on.
+ */
+class Chains
+{
+public:
+    Chains(int chains, int segments)
+      : numChains(chains), numSegments(segments)
+    {
+        int numPoints = chains * (segments + 1);
+        // the constraints keep pointers to the values, so allocate them up-front
+        values.resize(2 * numPoints + chains * segments + 2 * chains);
+        double* coords = &values[0];
+        double* lengths = coords + 2 * numPoints;
+        double* fixed = lengths + chains * segments;
+
+        Benchmark::Random random;
+        points.resize(numPoints);
+        chainUnknowns.resize(chains);
+        for (int i = 0; i < numPoints; i++) {
+            points[i].x = coords + 2 * i;
+            points[i].y = coords + 2 * i + 1;
+            unknowns.push_back(points[i].x);
+            unknowns.push_back(points[i].y);
+            chainUnknowns[i / (segments + 1)].push_back(points[i].x);
+            chainUnknowns[i / (segments + 1)].push_back(points[i].y);
+        }
+
+        chainConstraints.resize(chains);
+        for (int c = 0; c < chains; c++) {
+            std::vector<GCS::Constraint*>& constraints = chainConstraints[c];
+            GCS::Point& first = points[c * (segments + 1)];
+            fixed[2 * c] = 0.0;
+            fixed[2 * c + 1] = 10.0 * c;
+            system.addConstraintCoordinateX(first, fixed + 2 * c);
+            system.addConstraintCoordinateY(first, fixed + 2 * c + 1);
+            constraints.push_back(new GCS::ConstraintEqual(first.x, fixed + 2 * c));
+            constraints.push_back(new GCS::ConstraintEqual(first.y, fixed + 2 * c + 1));
+            for (int s = 0; s < segments; s++) {
+                GCS::Point& p1 = points[c * (segments + 1) + s];
+                GCS::Point& p2 = points[c * (segments + 1) + s + 1];
+                double* length = lengths + c * segments + s;
+                *length = random.uniform(1.0, 5.0);
+                if (s % 2 == 0) {
+                    system.addConstraintHorizontal(p1, p2);
+                    constraints.push_back(new GCS::ConstraintEqual(p1.y, p2.y));
+                }
+                else {
+                    system.addConstraintVertical(p1, p2);
+                    constraints.push_back(new GCS::ConstraintEqual(p1.x, p2.x));
+                }
+                system.addConstraintP2PDistance(p1, p2, length);
+                constraints.push_back(new GCS::ConstraintP2PDistance(p1, p2, length));
+            }
+        }
+
+        resetPoints();
+    }
+
+    ~Chains()
+    {
+        for (std::size_t c = 0; c < chainConstraints.size(); c++) {
+            for (std::size_t i = 0; i < chainConstraints[c].size(); i++)
+                delete chainConstraints[c][i];
+        }
+    }
+
+    /// Creates one subsystem per chain like GCS::System::initSolution() does for each component
+    void createSubSystems(std::vector<GCS::SubSystem*>& subSystems)
+    {
+        for (int c = 0; c < numChains; c++)
+            subSystems.push_back(new GCS::SubSystem(chainConstraints[c], chainUnknowns[c]));
+    }
+
+    /// Moves all points to the start position of the solver
+    void resetPoints()
+    {
+        Benchmark::Random random(815);
+        for (int c = 0; c < numChains; c++) {
+            double x = 0.0, y = 10.0 * c;
+            for (int s = 0; s <= numSegments; s++) {
+                GCS::Point& p = points[c * (numSegments + 1) + s];
+                *p.x = x + random.uniform(-0.5, 0.5);
+                *p.y = y + random.uniform(-0.5, 0.5);
+                if (s % 2 == 0)
+                    x += 3.0;
+                else
+                    y += 3.0;
+            }
+        }
+    }
+
+    std::string label() const
+    {
+        std::stringstream str;
+        str << numChains << " chains of " << numSegments << " segments";
+        return str.str();
+    }
+
+    GCS::System system;
+    GCS::VEC_pD unknowns;
+
+private:
+    Chains(const Chains&);
+    Chains& operator=(const Chains&);
+
+    int numChains, numSegments;
+    std::vector<double> values;
+    std::vector<GCS::Point> points;
+    std::vector< std::vector<GCS::Constraint*> > chainConstraints;
+    std::vector<GCS::VEC_pD> chainUnknowns;
+};
+
+void GcsDiagnose(Benchmark::State& state)
+{
+    Chains chains(50, 20);
+    while (state.keepRunning()) {
+        chains.system.declareUnknowns(chains.unknowns);
+        chains.system.initSolution();
+    }
+    state.setItemsProcessed(chains.unknowns.size());
+    state.setLabel(chains.label());
+}
+
+void GcsSolve(Benchmark::State& state)
+{
+    Chains chains(50, 20);
+    chains.system.declareUnknowns(chains.unknowns);
+    chains.system.initSolution();
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        chains.resetPoints();
+        state.resumeTiming();
+        int ret = chains.system.solve();
+        if (ret != GCS::Success)
+            throw std::runtime_error("Solving the constraint system failed");
+    }
+    state.setItemsProcessed(chains.unknowns.size());
+    state.setLabel(chains.label());
+}
+
+void GcsJacobi(Benchmark::State& state)
+{
+    Chains chains(50, 20);
+    std::vector<GCS::SubSystem*> subSystems;
+    chains.createSubSystems(subSystems);
+    std::vector<Eigen::MatrixXd> jacobi(subSystems.size());
+    while (state.keepRunning()) {
+        for (std::size_t i = 0; i < subSystems.size(); i++)
+            subSystems[i]->calcJacobi(jacobi[i]);
+        Benchmark::keep(jacobi);
+    }
+    for (std::size_t i = 0; i < subSystems.size(); i++)
+        delete subSystems[i];
+    state.setItemsProcessed(chains.unknowns.size());
+    state.setLabel(chains.label());
+}
+
+void GcsGrad(Benchmark::State& state)
+{
+    Chains chains(50, 20);
+    std::vector<GCS::SubSystem*> subSystems;
+    chains.createSubSystems(subSystems);
+    std::vector<Eigen::VectorXd> grad(subSystems.size());
+    for (std::size_t i = 0; i < subSystems.size(); i++)
+        grad[i].resize(subSystems[i]->pSize());
+    while (state.keepRunning()) {
+        for (std::size_t i = 0; i < subSystems.size(); i++)
+            subSystems[i]->calcGrad(grad[i]);
+        Benchmark::keep(grad);
+    }
+    for (std::size_t i = 0; i < subSystems.size(); i++)
+        delete subSystems[i];
+    state.setItemsProcessed(chains.unknowns.size());
+    state.setLabel(chains.label());
+}
+
+}
+
+FC_BENCHMARK(GcsDiagnose);
+FC_BENCHMARK(GcsSolve);
+FC_BENCHMARK(GcsJacobi);
+FC_BENCHMARK(GcsGrad);
@@ -0,0 +1,150 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Interpreter.h>
+#include <Base/Stream.h>
+#include <App/Application.h>
+
+#include "Benchmark.h"
+
+using Base::Console;
+using App::Application;
+
+static const char sUsage[] =
+    "Usage: FreeCADBenchmarks [options]\n"
+    "Runs the benchmarks of the geometry kernels and writes the results as JSON.\n\n"
+    "Options:\n"
+    "  --filter <text>    only run benchmarks whose name contains text\n"
+    "  --out <file>       write the results to file instead of stdout\n"
+    "  --min-time <secs>  minimal time spent per benchmark, default 0.5\n"
+    "  --list             list the benchmarks and exit\n"
+    "  --help             show this help and exit\n";
+
+int main( int argc, char ** argv )
+{
+    // Make sure that we use '.' as decimal point
+#if defined(FC_OS_LINUX)
+    putenv("LANG=C");
+    putenv("LC_ALL=C");
+#else
+    setlocale(LC_NUMERIC, "C");
+#endif
+
+    Benchmark::Options options;
+    std::string outFile;
+    bool list = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        }
+        else if (arg == "--out" && hasValue) {
+            outFile = argv[++i];
+        }
+        else if (arg == "--min-time" && hasValue) {
+            options.minTime = atof(argv[++i]);
+        }
+        else if (arg == "--list") {
+            list = true;
+        }
+        else if (arg == "--help" || arg == "-h") {
+            std::cout << sUsage;
+            return 0;
+        }
+        else {
+            std::cerr << "Unknown option '" << arg << "'\n\n" << sUsage;
+            return 1;
+        }
+    }
+
+    if (list) {
+        Benchmark::listBenchmarks(std::cout);
+        return 0;
+    }
+
+    // Name and Version of the Application
+    App::Application::Config()["ExeName"] = "FreeCADBenchmarks";
+    App::Application::Config()["ExeVendor"] = "FreeCAD";
+    App::Application::Config()["AppDataSkipVendor"] = "true";
+
+    try {
+        App::Application::Config()["RunMode"] = "Exit";
+        // the options of the benchmarks are unknown to the application
+        App::Application::init(1,argv);
+        // The Part module sets up OCC for the concurrent algorithms, e.g. it switches on
+        // the reentrant mode. As in FreeCADCmd there is no QCoreApplication, so the
+        // concurrent code must not rely on an event loop.
+        Base::Interpreter().loadModule("Part");
+    }
+    catch (const Base::Exception& e) {
+        std::cerr << "Initialization of FreeCADBenchmarks failed: " << e.what() << std::endl;
+        exit(100);
+    }
+    catch (...) {
+        std::cerr << "Initialization of FreeCADBenchmarks failed" << std::endl;
+        exit(101);
+    }
+
+    int failed = 0;
+    if (outFile.empty()) {
+        // keep the messages of the kernels out of the JSON output
+        Console().SetEnabledMsgType("Console", Base::ConsoleSingleton::MsgType_Txt |
+                                               Base::ConsoleSingleton::MsgType_Log |
+                                               Base::ConsoleSingleton::MsgType_Wrn |
+                                               Base::ConsoleSingleton::MsgType_Err, false);
+        std::stringstream str;
+        failed = Benchmark::runBenchmarks(options, str, std::cerr);
+        std::cout << str.str();
+    }
+    else {
+        Base::FileInfo fi(outFile);
+        Base::ofstream str(fi, std::ios::out | std::ios::binary);
+        if (!str) {
+            std::cerr << "Cannot open file '" << outFile << "' for writing" << std::endl;
+            failed = 1;
+        }
+        else {
+            failed = Benchmark::runBenchmarks(options, str, std::cerr);
+        }
+    }
+
+    // close open documents
+    App::GetApplication().closeAllDocuments();
+
+    // cleans up
+    Application::destruct();
+
+    return failed > 0 ? 1 : 0;
+}
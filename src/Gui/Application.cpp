@@ -988,6 +988,19 @@ bool Application::activateWorkbench(const char* name)
         return false;
 
     try {
+        // a workbench registered lazily at startup is replaced by the handler
+        // of its module when InitGui.py is executed now
+        if (PyObject_HasAttrString(pcWorkbench, "__LazyInitGui__")) {
+            Py::Callable load(Py::Object(pcWorkbench).getAttr(std::string("LoadInitGui")));
+            load.apply(Py::Tuple());
+            pcWorkbench = PyDict_GetItemString(_pcWorkbenchDictionary, name);
+            if (!pcWorkbench || PyObject_HasAttrString(pcWorkbench, "__LazyInitGui__")) {
+                std::stringstream str;
+                str << "InitGui.py did not add the workbench '" << name << "'";
+                throw Py::RuntimeError(str.str());
+            }
+        }
+
         std::string type;
         Py::Object handler(pcWorkbench);
         if (!handler.hasAttr(std::string("__Workbench__"))) {
@@ -606,14 +606,19 @@ PyObject* Application::sAddWorkbenchHandler(PyObject * /*self*/, PyObject *args,
         Py::Callable(object.getAttr(std::string("GetClassName")));
         item = name.as_std_string();
 
+        // a workbench registered lazily at startup is replaced silently when
+        // its module is loaded, but not by another lazy one
         PyObject* wb = PyDict_GetItemString(Instance->_pcWorkbenchDictionary,item.c_str()); 
-        if (wb) {
+        if (wb && (!PyObject_HasAttrString(wb, "__LazyInitGui__") ||
+                    PyObject_HasAttrString(object.ptr(), "__LazyInitGui__"))) {
             PyErr_Format(PyExc_KeyError, "'%s' already exists.", item.c_str());
             return NULL;
         }
 
+        bool added = (wb == 0);
         PyDict_SetItemString(Instance->_pcWorkbenchDictionary,item.c_str(),object.ptr());
-        Instance->signalAddWorkbench(item.c_str());
+        if (added)
+            Instance->signalAddWorkbench(item.c_str());
     }
     catch (const Py::Exception&) {
         return NULL;
@@ -37,6 +37,7 @@
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Matrix.h>
+#include <Base/Profiler.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
 
@@ -447,6 +448,7 @@ void Document::slotChangedObject(const App::DocumentObject& Obj, const App::Prop
     ViewProvider* viewProvider = getViewProvider(&Obj);
     if (viewProvider) {
         try {
+            Base::ProfileZone zone(viewProvider->getTypeId().getName(), Obj.getNameInDocument());
             viewProvider->update(&Prop);
         } catch(const Base::MemoryException& e) {
             Base::Console().Error("Memory exception in '%s' thrown: %s\n",Obj.getNameInDocument(),e.what());
@@ -97,6 +97,27 @@ class NoneWorkbench ( Workbench ):
 		"""Return the name of the associated C++ class."""
 		return "Gui::NoneWorkbench"
 
+class LazyWorkbench ( Workbench ):
+	"""Stands in for a workbench whose InitGui.py was not executed at
+startup. Its subclass has the name, menu text, tool tip and icon of the real
+workbench as recorded in the module cache. When the workbench is activated
+the first time LoadInitGui() executes InitGui.py which replaces this object.
+	"""
+	__LazyInitGui__ = ""
+	def LoadInitGui(self):
+		"""Execute the InitGui.py of the module."""
+		import __main__
+		Log('Init: Loading ' + self.__LazyInitGui__ + '\n')
+		execfile(self.__LazyInitGui__, __main__.__dict__, {})
+
+def AddLazyWorkbench(info, InstallFile):
+	import types
+	attrs = {"__LazyInitGui__": InstallFile}
+	for key in ("MenuText", "ToolTip", "Icon"):
+		if key in info:
+			attrs[key] = info[key]
+	Gui.addWorkbench(types.ClassType(info["Name"], (LazyWorkbench,), attrs)())
+
 def InitApplications():
 	import sys,os
 	# Searching modules dirs +++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -108,9 +129,17 @@ def InitApplications():
 	for Dir in ModDirs:
 		if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
 			InstallFile = os.path.join(Dir,"InitGui.py")
+			lazy = None
+			if ModuleManifest:
+				lazy = ModuleManifest.entry(Dir)["InitGui"]
 			if (os.path.exists(InstallFile)):
 				try:
-					execfile(InstallFile)
+					if lazy is None:
+						execfile(InstallFile)
+					else:
+						ModuleManifest.replay(lazy["Calls"])
+						for info in lazy["Workbenches"]:
+							AddLazyWorkbench(info, InstallFile)
 				except Exception, inst:
 					Log('Init:      Initializing ' + Dir + '... failed\n')
 					Err('During initialization the error ' + str(inst) + ' occurred in ' + InstallFile + '\n')
@@ -118,6 +147,8 @@ def InitApplications():
 					Log('Init:      Initializing ' + Dir + '... done\n')
 			else:
 				Log('Init:      Initializing ' + Dir + '(InitGui.py not found)... ignore\n')
+	if ModuleManifest:
+		ModuleManifest.save()
 
 
 Log ('Init: Running FreeCADGuiInit.py start script...\n')
@@ -147,6 +178,7 @@ FreeCAD.addExportType("3D View (*.svg)","FreeCADGui")
 FreeCAD.addExportType("Portable Document Format (*.pdf)","FreeCADGui")
 
 del(InitApplications)
+del(AddLazyWorkbench)
 del(NoneWorkbench)
 del(StandardWorkbench)
 
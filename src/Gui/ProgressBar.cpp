@@ -183,7 +183,12 @@ void Sequencer::nextStep(bool canAbort)
 
 void Sequencer::setProgress(size_t step)
 {
-    d->bar->show();
+    QThread *currentThread = QThread::currentThread();
+    QThread *thr = d->bar->thread(); // this is the main thread
+    if (thr != currentThread)
+        QMetaObject::invokeMethod(d->bar, "show", Qt::QueuedConnection);
+    else
+        d->bar->show();
     setValue((int)step);
 }
 
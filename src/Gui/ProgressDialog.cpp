@@ -140,6 +140,11 @@ void SequencerDialog::nextStep(bool canAbort)
     }
 }
 
+void SequencerDialog::setProgress(size_t step)
+{
+    setProgress((int)step);
+}
+
 void SequencerDialog::setProgress(int step)
 {
     QThread *currentThread = QThread::currentThread();
@@ -55,6 +55,8 @@ protected:
     void startStep();
     /** Increase the step indicator of the progress dialog. */
     void nextStep(bool canAbort);
+    /** Sets the step indicator of the progress dialog to a certain position. */
+    void setProgress(size_t step);
     /** Resets the sequencer */
     void resetData();
     void showRemainingTime();
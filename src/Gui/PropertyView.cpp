@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <set>
 # include <QGridLayout>
 # include <QHeaderView>
 # include <QEvent>
@@ -111,9 +112,15 @@ void PropertyView::onSelectionChanged(const SelectionChanges& msg)
     std::vector<PropInfo> propDataMap;
     std::vector<PropInfo> propViewMap;
     std::vector<SelectionSingleton::SelObj> array = Gui::Selection().getCompleteSelection();
+    // several selected sub-elements of an object count as one object
+    std::set<App::DocumentObject*> objects;
+    std::size_t numObjects = 0;
     for (std::vector<SelectionSingleton::SelObj>::const_iterator it = array.begin(); it != array.end(); ++it) {
         App::DocumentObject *ob=0;
         ViewProvider *vp=0;
+        if ((*it).pObject && !objects.insert((*it).pObject).second)
+            continue;
+        numObjects++;
 
         std::vector<App::Property*> dataList;
         std::map<std::string, App::Property*> viewList;
@@ -177,7 +184,7 @@ void PropertyView::onSelectionChanged(const SelectionChanges& msg)
     std::vector<PropInfo>::const_iterator it;
     PropertyModel::PropertyList dataProps;
     for (it = propDataMap.begin(); it != propDataMap.end(); ++it) {
-        if (it->propList.size() == array.size()) {
+        if (it->propList.size() == numObjects) {
             dataProps.push_back(std::make_pair(it->propName, it->propList));
         }
     }
@@ -185,7 +192,7 @@ void PropertyView::onSelectionChanged(const SelectionChanges& msg)
 
     PropertyModel::PropertyList viewProps;
     for (it = propViewMap.begin(); it != propViewMap.end(); ++it) {
-        if (it->propList.size() == array.size()) {
+        if (it->propList.size() == numObjects) {
             viewProps.push_back(std::make_pair(it->propName, it->propList));
         }
     }
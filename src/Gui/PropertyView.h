@@ -51,7 +51,7 @@ namespace Gui {
 
 /** The property view class.
  */
-class PropertyView : public QWidget, public Gui::SelectionObserver
+class PropertyView : public QWidget, public Gui::SelectionObserver, public Gui::SelectionBatchObserver
 {
     Q_OBJECT
 
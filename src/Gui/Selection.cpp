@@ -83,7 +83,23 @@ void SelectionObserver::attachSelection()
 {
     if (!connectSelection.connected()) {
         connectSelection = Selection().signalSelectionChanged.connect(boost::bind
-            (&SelectionObserver::onSelectionChanged, this, _1));
+            (&SelectionObserver::_onSelectionChanged, this, _1));
+    }
+}
+
+void SelectionObserver::_onSelectionChanged(const SelectionChanges& msg)
+{
+    if (msg.pSubNames && !dynamic_cast<SelectionBatchObserver*>(this)) {
+        SelectionChanges single(msg);
+        single.pSubNames = 0;
+        std::vector<std::string>::const_iterator it;
+        for (it = msg.pSubNames->begin(); it != msg.pSubNames->end(); ++it) {
+            single.pSubName = it->c_str();
+            onSelectionChanged(single);
+        }
+    }
+    else {
+        onSelectionChanged(msg);
     }
 }
 
@@ -661,6 +677,7 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
             temp.TypeName = temp.pObject->getTypeId().getName();
 
         _SelList.push_back(temp);
+        _SelIndex.insert(indexKey(temp.DocName, temp.FeatName, temp.SubName));
 
         SelectionChanges Chng;
 
@@ -689,12 +706,30 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
     }
 }
 
+void SelectionSingleton::notifyBatch(const SelectionChanges& Chng)
+{
+    SelectionChanges single(Chng);
+    single.pSubNames = 0;
+    for (std::set<ObserverType*>::iterator it = _ObserverSet.begin(); it != _ObserverSet.end(); ++it) {
+        if (dynamic_cast<SelectionBatchObserver*>(*it)) {
+            (*it)->OnChange(*this, Chng);
+            continue;
+        }
+        std::vector<std::string>::const_iterator jt;
+        for (jt = Chng.pSubNames->begin(); jt != Chng.pSubNames->end(); ++jt) {
+            single.pSubName = jt->c_str();
+            (*it)->OnChange(*this, single);
+        }
+    }
+}
+
 bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames)
 {
-    // already in ?
-    //if (isSelected(pDocName, pObjectName, pSubName))
-    //    return true;
+    return addSelections(pDocName, pObjectName, pSubNames);
+}
 
+bool SelectionSingleton::addSelections(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames)
+{
     _SelObj temp;
 
     temp.pDoc = getDocument(pDocName);
@@ -710,30 +745,52 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
 
         temp.DocName  = pDocName;
         temp.FeatName = pObjectName ? pObjectName : "";
+        temp.x        = 0;
+        temp.y        = 0;
+        temp.z        = 0;
+
+        std::vector<std::string> added;
+        added.reserve(pSubNames.size());
+        bool denied = false;
         for (std::vector<std::string>::const_iterator it = pSubNames.begin(); it != pSubNames.end(); ++it) {
-            temp.SubName  = it->c_str();
-            temp.x        = 0;
-            temp.y        = 0;
-            temp.z        = 0;
+            // already in ?
+            std::string key = indexKey(temp.DocName, temp.FeatName, *it);
+            if (_SelIndex.find(key) != _SelIndex.end())
+                continue;
+            // check for a Selection Gate
+            if (ActiveGate && !ActiveGate->allow(temp.pDoc,temp.pObject,it->c_str())) {
+                denied = true;
+                continue;
+            }
 
+            temp.SubName = *it;
             _SelList.push_back(temp);
+            _SelIndex.insert(key);
+            added.push_back(*it);
         }
 
-        SelectionChanges Chng;
+        if (denied) {
+            if (getMainWindow())
+                getMainWindow()->showMessage(QString::fromAscii("Selection not allowed by filter"),5000);
+            QApplication::beep();
+        }
 
-        Chng.pDocName  = pDocName;
-        Chng.pObjectName = pObjectName ? pObjectName : "";
-        Chng.pSubName  = "";
-        Chng.x         = 0;
-        Chng.y         = 0;
-        Chng.z         = 0;
-        Chng.Type      = SelectionChanges::AddSelection;
+        if (!added.empty()) {
+            SelectionChanges Chng;
 
-        Notify(Chng);
-        signalSelectionChanged(Chng);
+            Chng.pDocName  = pDocName;
+            Chng.pObjectName = pObjectName ? pObjectName : "";
+            Chng.pSubName  = "";
+            Chng.pSubNames = &added;
+            Chng.Type      = SelectionChanges::AddSelection;
 
-        // allow selection
-        return true;
+            notifyBatch(Chng);
+            signalSelectionChanged(Chng);
+
+            Base::Console().Log("Sel : Add %d sub-elements of \"%s.%s\"\n",(int)added.size(),pDocName,Chng.pObjectName);
+        }
+
+        return !denied || !added.empty();
     }
     else {
         // neither an existing nor active document available 
@@ -745,6 +802,10 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
 
 void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectName, const char* pSubName)
 {
+    // a single sub-element that is not selected
+    if (pObjectName && pSubName && !isSelected(pDocName, pObjectName, pSubName))
+        return;
+
     std::vector<SelectionChanges> rmvList;
 
     for (std::list<_SelObj>::iterator It = _SelList.begin();It != _SelList.end();) {
@@ -759,6 +820,10 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
 
             // destroy the _SelObj item
             It = _SelList.erase(It);
+            boost::unordered_multiset<std::string>::iterator jt =
+                _SelIndex.find(indexKey(tmpDocName, tmpFeaName, tmpSubName));
+            if (jt != _SelIndex.end())
+                _SelIndex.erase(jt);
 
             SelectionChanges Chng;
             Chng.pDocName  = tmpDocName.c_str();
@@ -823,6 +888,7 @@ void SelectionSingleton::setSelection(const char* pDocName, const std::vector<Ap
         return;
 
     _SelList = temp;
+    rebuildIndex();
 
     SelectionChanges Chng;
     Chng.Type = SelectionChanges::SetSelection;
@@ -856,6 +922,7 @@ void SelectionSingleton::clearSelection(const char* pDocName)
         }
 
         _SelList = selList;
+        rebuildIndex();
 
         SelectionChanges Chng;
         Chng.Type = SelectionChanges::ClrSelection;
@@ -873,6 +940,7 @@ void SelectionSingleton::clearSelection(const char* pDocName)
 void SelectionSingleton::clearCompleteSelection()
 {
     _SelList.clear();
+    _SelIndex.clear();
 
     SelectionChanges Chng;
     Chng.Type = SelectionChanges::ClrSelection;
@@ -892,16 +960,16 @@ bool SelectionSingleton::isSelected(const char* pDocName, const char* pObjectNam
     const char* tmpDocName = pDocName ? pDocName : "";
     const char* tmpFeaName = pObjectName ? pObjectName : "";
     const char* tmpSubName = pSubName ? pSubName : "";
-    for (std::list<_SelObj>::const_iterator It = _SelList.begin();It != _SelList.end();++It)
-        if (It->DocName == tmpDocName && It->FeatName == tmpFeaName && It->SubName == tmpSubName)
-            return true;
-    return false;
+    return _SelIndex.find(indexKey(tmpDocName, tmpFeaName, tmpSubName)) != _SelIndex.end();
 }
 
 bool SelectionSingleton::isSelected(App::DocumentObject* obj, const char* pSubName) const
 {
     if (!obj) return false;
 
+    if (pSubName && obj->getNameInDocument())
+        return isSelected(obj->getDocument()->getName(), obj->getNameInDocument(), pSubName);
+
     for(list<_SelObj>::const_iterator It = _SelList.begin();It != _SelList.end();++It) {
         if (It->pObject == obj) {
             if (pSubName) {
@@ -932,6 +1000,27 @@ void SelectionSingleton::slotRenamedObject(const App::DocumentObject& Obj)
             it->DocName = pDoc->getName();
         }
     }
+    rebuildIndex();
+}
+
+std::string SelectionSingleton::indexKey(const std::string& pDocName, const std::string& pObjectName, const std::string& pSubName)
+{
+    // names cannot contain a line break
+    std::string key;
+    key.reserve(pDocName.size() + pObjectName.size() + pSubName.size() + 2);
+    key += pDocName;
+    key += '\n';
+    key += pObjectName;
+    key += '\n';
+    key += pSubName;
+    return key;
+}
+
+void SelectionSingleton::rebuildIndex()
+{
+    _SelIndex.clear();
+    for (std::list<_SelObj>::const_iterator it = _SelList.begin(); it != _SelList.end(); ++it)
+        _SelIndex.insert(indexKey(it->DocName, it->FeatName, it->SubName));
 }
 
 
@@ -985,6 +1074,9 @@ PyMethodDef SelectionSingleton::Methods[] = {
     {"addSelection",         (PyCFunction) SelectionSingleton::sAddSelection, 1, 
      "addSelection(object,[string,float,float,float]) -- Add an object to the selection\n"
      "where string is the sub-element name and the three floats represent a 3d point"},
+    {"addSelections",        (PyCFunction) SelectionSingleton::sAddSelections, 1,
+     "addSelections(object,[string]) -- Add several sub-elements of an object to the selection\n"
+     "Observers are notified only once for all given sub-element names"},
     {"removeSelection",      (PyCFunction) SelectionSingleton::sRemoveSelection, 1,
      "removeSelection(object) -- Remove an object from the selection"},
     {"clearSelection"  ,     (PyCFunction) SelectionSingleton::sClearSelection, 1,
@@ -1059,6 +1151,37 @@ PyObject *SelectionSingleton::sAddSelection(PyObject * /*self*/, PyObject *args,
     Py_Return;
 }
 
+PyObject *SelectionSingleton::sAddSelections(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    PyObject *object, *sequence;
+    if (!PyArg_ParseTuple(args, "O!O", &(App::DocumentObjectPy::Type),&object,&sequence))
+        return NULL;                             // NULL triggers exception 
+
+    App::DocumentObjectPy* docObjPy = static_cast<App::DocumentObjectPy*>(object);
+    App::DocumentObject* docObj = docObjPy->getDocumentObjectPtr();
+    if (!docObj || !docObj->getNameInDocument()) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, "Cannot check invalid object");
+        return NULL;
+    }
+
+    try {
+        std::vector<std::string> subNames;
+        Py::Sequence list(sequence);
+        subNames.reserve(list.size());
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it)
+            subNames.push_back(static_cast<std::string>(Py::String(*it)));
+
+        Selection().addSelections(docObj->getDocument()->getName(),
+                                  docObj->getNameInDocument(),
+                                  subNames);
+    }
+    catch (const Py::Exception&) {
+        return NULL;
+    }
+
+    Py_Return;
+}
+
 PyObject *SelectionSingleton::sRemoveSelection(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
 {
     PyObject *object;
@@ -30,6 +30,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <boost/unordered_set.hpp>
 #include <CXX/Objects.hxx>
 
 #include <Base/Observer.h>
@@ -62,6 +63,11 @@ namespace Gui
 class GuiExport SelectionChanges
 {
 public:
+    SelectionChanges()
+      : pDocName(0), pObjectName(0), pSubName(0), x(0), y(0), z(0), pSubNames(0)
+    {
+    }
+
     enum MsgType {
         AddSelection,
         RmvSelection,
@@ -79,6 +85,22 @@ public:
     float x;
     float y;
     float z;
+    /** The sub-elements of an object added with one AddSelection message by
+     * SelectionSingleton::addSelections(), 0 otherwise. For such a message
+     * \a pSubName is empty. Only a SelectionBatchObserver gets it.
+     */
+    const std::vector<std::string>* pSubNames;
+};
+
+/**
+ * Observers of the selection that handle the batched AddSelection message of
+ * SelectionSingleton::addSelections() derive from this class as well. All other
+ * observers get one AddSelection message per sub-element.
+ */
+class GuiExport SelectionBatchObserver
+{
+public:
+    virtual ~SelectionBatchObserver() {}
 };
 
 } //namespace Gui
@@ -131,6 +153,7 @@ public:
 
 private:
     virtual void onSelectionChanged(const SelectionChanges& msg) = 0;
+    void _onSelectionChanged(const SelectionChanges& msg);
 
 private:
     typedef boost::signals::connection Connection;
@@ -203,6 +226,11 @@ public:
     bool addSelection(const char* pDocName, const char* pObjectName=0, const char* pSubName=0, float x=0, float y=0, float z=0);
     /// Add to selection with several sub-elements
     bool addSelection(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames);
+    /** Add several sub-elements of an object to the selection. Already selected
+     * sub-elements are skipped and only one AddSelection message is sent for
+     * all the others, see SelectionChanges::pSubNames.
+     */
+    bool addSelections(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames);
     /// Remove from selection (for internal use)
     void rmvSelection(const char* pDocName, const char* pObjectName=0, const char* pSubName=0);
     /// Set the selection for a document
@@ -306,6 +334,7 @@ public:
 
 protected:
     static PyObject *sAddSelection        (PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sAddSelections       (PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject *sRemoveSelection     (PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject *sClearSelection      (PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject *sIsSelected          (PyObject *self,PyObject *args,PyObject *kwd);
@@ -330,6 +359,12 @@ protected:
 
     /// helper to retrieve document by name
     App::Document* getDocument(const char* pDocName=0) const;
+    /// sends a batched AddSelection message to the observers, see SelectionBatchObserver
+    void notifyBatch(const SelectionChanges& Chng);
+    /// key of a selection entry in the index
+    static std::string indexKey(const std::string& pDocName, const std::string& pObjectName, const std::string& pSubName);
+    /// rebuilds the index after the selection list has been replaced
+    void rebuildIndex();
 
     SelectionChanges CurrentPreselection;
 
@@ -343,6 +378,8 @@ protected:
         float x,y,z;
     };
     std::list<_SelObj> _SelList;
+    /// hashed (document, object, sub-element) keys of _SelList for fast look-ups
+    boost::unordered_multiset<std::string> _SelIndex;
 
     static SelectionSingleton* _pcSingleton;
 
@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <qstatusbar.h>
 # include <qstring.h>
 # include <QGLWidget>
@@ -203,10 +204,13 @@ void SoFCSelection::doAction(SoAction *action)
 
         if (selaction->SelChange.Type == SelectionChanges::AddSelection || 
             selaction->SelChange.Type == SelectionChanges::RmvSelection) {
+            const std::vector<std::string>* subNames = selaction->SelChange.pSubNames;
             if (documentName.getValue() == selaction->SelChange.pDocName &&
                 objectName.getValue() == selaction->SelChange.pObjectName &&
                 (subElementName.getValue() == selaction->SelChange.pSubName || 
-                *(selaction->SelChange.pSubName) == '\0') ) {
+                (*(selaction->SelChange.pSubName) == '\0' && (!subNames ||
+                std::find(subNames->begin(), subNames->end(),
+                    std::string(subElementName.getValue().getString())) != subNames->end()))) ) {
                 if (selaction->SelChange.Type == SelectionChanges::AddSelection) {
                     if(selected.getValue() == NOTSELECTED){
                         selected = SELECTED;
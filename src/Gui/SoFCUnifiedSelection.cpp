@@ -263,26 +263,34 @@ void SoFCUnifiedSelection::doAction(SoAction *action)
                 App::DocumentObject* obj = doc->getObject(selaction->SelChange.pObjectName);
                 ViewProvider*vp = Application::Instance->getViewProvider(obj);
                 if (vp && vp->useNewSelectionModel() && vp->isSelectable()) {
-                    SoDetail* detail = vp->getDetail(selaction->SelChange.pSubName);
-                    SoSelectionElementAction::Type type = SoSelectionElementAction::None;
-                    if (selaction->SelChange.Type == SelectionChanges::AddSelection) {
-                        if (detail)
-                            type = SoSelectionElementAction::Append;
-                        else
-                            type = SoSelectionElementAction::All;
-                    }
-                    else {
-                        if (detail)
-                            type = SoSelectionElementAction::Remove;
-                        else
-                            type = SoSelectionElementAction::None;
-                    }
+                    // a batch of sub-elements comes with one message
+                    std::vector<std::string> subNames;
+                    if (selaction->SelChange.pSubNames)
+                        subNames = *selaction->SelChange.pSubNames;
+                    else
+                        subNames.push_back(selaction->SelChange.pSubName);
+                    for (std::vector<std::string>::iterator it = subNames.begin(); it != subNames.end(); ++it) {
+                        SoDetail* detail = vp->getDetail(it->c_str());
+                        SoSelectionElementAction::Type type = SoSelectionElementAction::None;
+                        if (selaction->SelChange.Type == SelectionChanges::AddSelection) {
+                            if (detail)
+                                type = SoSelectionElementAction::Append;
+                            else
+                                type = SoSelectionElementAction::All;
+                        }
+                        else {
+                            if (detail)
+                                type = SoSelectionElementAction::Remove;
+                            else
+                                type = SoSelectionElementAction::None;
+                        }
 
-                    SoSelectionElementAction action(type);
-                    action.setColor(this->colorSelection.getValue());
-                    action.setElement(detail);
-                    action.apply(vp->getRoot());
-                    delete detail;
+                        SoSelectionElementAction action(type);
+                        action.setColor(this->colorSelection.getValue());
+                        action.setElement(detail);
+                        action.apply(vp->getRoot());
+                        delete detail;
+                    }
                 }
             }
         }
@@ -123,10 +123,7 @@ void TaskSelectLinkProperty::activate(void)
             std::string ObjName = StartObject->getNameInDocument();
             std::string DocName = StartObject->getDocument()->getName();
 
-            for (std::vector<std::string>::const_iterator it = StartValueBuffer.begin();it!=StartValueBuffer.end();++it)
-            {
-                Gui::Selection().addSelection(DocName.c_str(),ObjName.c_str(),it->c_str());
-            }
+            Gui::Selection().addSelections(DocName.c_str(),ObjName.c_str(),StartValueBuffer);
         }
         
     }
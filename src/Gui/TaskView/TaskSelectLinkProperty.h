@@ -52,7 +52,8 @@ namespace TaskView {
  */
 
 
-class GuiExport TaskSelectLinkProperty : public TaskBox, public Gui::SelectionSingleton::ObserverType
+class GuiExport TaskSelectLinkProperty : public TaskBox, public Gui::SelectionSingleton::ObserverType,
+                                        public Gui::SelectionBatchObserver
 {
     Q_OBJECT
 
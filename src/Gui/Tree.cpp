@@ -666,6 +666,21 @@ void TreeWidget::onItemExpanded(QTreeWidgetItem * item)
     if (item && item->type() == TreeWidget::ObjectType) {
         DocumentObjectItem* obj = static_cast<DocumentObjectItem*>(item);
         obj->setExpandedStatus(true);
+
+        // the items of the claimed objects are created on demand
+        QTreeWidgetItem* parent = item->parent();
+        while (parent && parent->type() != TreeWidget::DocumentType)
+            parent = parent->parent();
+        if (parent)
+            static_cast<DocumentItem*>(parent)->populateItem(obj);
+    }
+}
+
+void TreeWidget::onCreateItems()
+{
+    std::map<const Gui::Document*,DocumentItem*>::iterator pos;
+    for (pos = DocumentMap.begin();pos!=DocumentMap.end();++pos) {
+        pos->second->createPendingItems();
     }
 }
 
@@ -845,15 +860,15 @@ DocumentItem::~DocumentItem()
 void DocumentItem::slotInEdit(const Gui::ViewProviderDocumentObject& v)
 {
     std::string name (v.getObject()->getNameInDocument());
-    std::map<std::string, DocumentObjectItem*>::iterator it = ObjectMap.find(name);
-    if (it != ObjectMap.end()) 
-        it->second->setBackgroundColor(0,Qt::yellow);
+    DocumentObjectItem* item = ensureItem(name);
+    if (item)
+        item->setBackgroundColor(0,Qt::yellow);
 }
 
 void DocumentItem::slotResetEdit(const Gui::ViewProviderDocumentObject& v)
 {
     std::string name (v.getObject()->getNameInDocument());
-    std::map<std::string, DocumentObjectItem*>::iterator it = ObjectMap.find(name);
+    ObjectItemMap::iterator it = ObjectMap.find(name);
     if (it != ObjectMap.end()) {
         it->second->setData(0, Qt::BackgroundColorRole,QVariant());
     }
@@ -861,16 +876,15 @@ void DocumentItem::slotResetEdit(const Gui::ViewProviderDocumentObject& v)
 
 void DocumentItem::slotNewObject(const Gui::ViewProviderDocumentObject& obj)
 {
-    std::string displayName = obj.getObject()->Label.getValue();
     std::string objectName = obj.getObject()->getNameInDocument();
-    std::map<std::string, DocumentObjectItem*>::iterator it = ObjectMap.find(objectName);
-    if (it == ObjectMap.end()) {
+    if (ObjectMap.find(objectName) == ObjectMap.end() &&
+        HiddenMap.find(objectName) == HiddenMap.end()) {
+        // The item is created in the next event loop when it is known whether another
+        // object claims it. This avoids to create and move the items of new objects.
         // cast to non-const object
-        DocumentObjectItem* item = new DocumentObjectItem(
-            const_cast<Gui::ViewProviderDocumentObject*>(&obj), this);
-        item->setIcon(0, obj.getIcon());
-        item->setText(0, QString::fromUtf8(displayName.c_str()));
-        ObjectMap[objectName] = item;
+        HiddenMap[objectName] = HiddenObject(
+            const_cast<Gui::ViewProviderDocumentObject*>(&obj), 0);
+        scheduleItem(objectName);
     } else {
         Base::Console().Warning("DocumentItem::slotNewObject: Cannot add view provider twice.\n");
     }
@@ -879,7 +893,17 @@ void DocumentItem::slotNewObject(const Gui::ViewProviderDocumentObject& obj)
 void DocumentItem::slotDeleteObject(const Gui::ViewProviderDocumentObject& obj)
 {
     std::string objectName = obj.getObject()->getNameInDocument();
-    std::map<std::string, DocumentObjectItem*>::iterator it = ObjectMap.find(objectName);
+
+    // the objects claimed by it while it was collapsed get their own items
+    ClaimedObjectMap::iterator ct = ClaimMap.find(&obj);
+    if (ct != ClaimMap.end()) {
+        std::vector<std::string> names;
+        names.swap(ct->second);
+        ClaimMap.erase(ct);
+        releaseObjects(&obj, names);
+    }
+
+    ObjectItemMap::iterator it = ObjectMap.find(objectName);
     if (it != ObjectMap.end()) {
         QTreeWidgetItem* parent = it->second->parent();
         if (it->second->childCount() > 0) {
@@ -891,60 +915,35 @@ void DocumentItem::slotDeleteObject(const Gui::ViewProviderDocumentObject& obj)
         delete it->second;
         ObjectMap.erase(it);
     }
+    else {
+        HiddenMap.erase(objectName);
+    }
 }
 
 void DocumentItem::slotChangeObject(const Gui::ViewProviderDocumentObject& view)
 {
-    // As we immediately add a newly created object to the tree we check here which
-    // item (this or a DocumentObjectItem) is the parent of the associated item of 'view'
     App::DocumentObject* obj = view.getObject();
     std::string objectName = obj->getNameInDocument();
-    std::map<std::string, DocumentObjectItem*>::iterator it = ObjectMap.find(objectName);
+    ObjectItemMap::iterator it = ObjectMap.find(objectName);
     if (it != ObjectMap.end()) {
-        // use new grouping style
-        std::set<QTreeWidgetItem*> children;
-        std::vector<App::DocumentObject*> group = view.claimChildren();
-        for (std::vector<App::DocumentObject*>::iterator jt = group.begin(); jt != group.end(); ++jt) {
-            if (*jt) {
-                const char* internalName = (*jt)->getNameInDocument();
-                if (internalName) {
-                    std::map<std::string, DocumentObjectItem*>::iterator kt = ObjectMap.find(internalName);
-                    if (kt != ObjectMap.end()) {
-                        children.insert(kt->second);
-                        QTreeWidgetItem* parent = kt->second->parent();
-                        if (parent && parent != it->second) {
-                            if (it->second != kt->second) {
-                                int index = parent->indexOfChild(kt->second);
-                                parent->takeChild(index);
-                                it->second->addChild(kt->second);
-                            }
-                            else {
-                                Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Object references to itself.\n");
-                            }
-                        }
-                    }
-                    else {
-                        Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Cannot reparent unknown object.\n");
-                    }
-                }
-                else {
-                    Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Group references unknown object.\n");
-                }
-            }
-        }
-        // move all children which are not part of the group anymore to this item
-        int count = it->second->childCount();
-        for (int i=0; i < count; i++) {
-            QTreeWidgetItem* child = it->second->child(i);
-            if (children.find(child) == children.end()) {
-                it->second->takeChild(i);
-                this->addChild(child);
-            }
-        }
+        DocumentObjectItem* item = it->second;
+        updateChildren(item);
 
         // set the text label
         std::string displayName = obj->Label.getValue();
-        it->second->setText(0, QString::fromUtf8(displayName.c_str()));
+        item->setText(0, QString::fromUtf8(displayName.c_str()));
+        return;
+    }
+
+    HiddenObjectMap::iterator jt = HiddenMap.find(objectName);
+    if (jt != HiddenMap.end()) {
+        // without an item only remember the claimed objects but the items
+        // of claimed objects must be moved below the item of this object
+        if (claimObjects(&view, view.claimChildren())) {
+            DocumentObjectItem* item = ensureItem(objectName);
+            if (item)
+                updateChildren(item);
+        }
     }
     else {
         Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Cannot change unknown object.\n");
@@ -953,7 +952,7 @@ void DocumentItem::slotChangeObject(const Gui::ViewProviderDocumentObject& view)
 
 void DocumentItem::slotRenameObject(const Gui::ViewProviderDocumentObject& obj)
 {
-    for (std::map<std::string,DocumentObjectItem*>::iterator it = ObjectMap.begin(); it != ObjectMap.end(); ++it) {
+    for (ObjectItemMap::iterator it = ObjectMap.begin(); it != ObjectMap.end(); ++it) {
         if (it->second->object() == &obj) {
             DocumentObjectItem* item = it->second;
             ObjectMap.erase(it);
@@ -963,6 +962,21 @@ void DocumentItem::slotRenameObject(const Gui::ViewProviderDocumentObject& obj)
         }
     }
 
+    for (HiddenObjectMap::iterator it = HiddenMap.begin(); it != HiddenMap.end(); ++it) {
+        if (it->second.first == &obj) {
+            HiddenObject hidden = it->second;
+            HiddenMap.erase(it);
+            std::string objectName = obj.getObject()->getNameInDocument();
+            HiddenMap[objectName] = hidden;
+            // the list of the claiming object still has the old name
+            if (hidden.second)
+                ClaimMap[hidden.second].push_back(objectName);
+            else
+                scheduleItem(objectName);
+            return;
+        }
+    }
+
     // no such object found
     Base::Console().Warning("DocumentItem::slotRenamedObject: Cannot rename unknown object.\n");
 }
@@ -970,14 +984,13 @@ void DocumentItem::slotRenameObject(const Gui::ViewProviderDocumentObject& obj)
 void DocumentItem::slotActiveObject(const Gui::ViewProviderDocumentObject& obj)
 {
     std::string objectName = obj.getObject()->getNameInDocument();
-    std::map<std::string, DocumentObjectItem*>::iterator jt = ObjectMap.find(objectName);
-    if (jt == ObjectMap.end())
+    DocumentObjectItem* active = ensureItem(objectName);
+    if (!active)
         return; // signal is emitted before the item gets created
-    for (std::map<std::string, DocumentObjectItem*>::iterator it = ObjectMap.begin();
-         it != ObjectMap.end(); ++it)
+    for (ObjectItemMap::iterator it = ObjectMap.begin(); it != ObjectMap.end(); ++it)
     {
         QFont f = it->second->font(0);
-        f.setBold(it == jt);
+        f.setBold(it->second == active);
         it->second->setFont(0,f);
     }
 }
@@ -985,11 +998,19 @@ void DocumentItem::slotActiveObject(const Gui::ViewProviderDocumentObject& obj)
 void DocumentItem::slotHighlightObject (const Gui::ViewProviderDocumentObject& obj,const Gui::HighlightMode& high,bool set)
 {
     std::string objectName = obj.getObject()->getNameInDocument();
-    std::map<std::string, DocumentObjectItem*>::iterator jt = ObjectMap.find(objectName);
-    if (jt == ObjectMap.end())
+    DocumentObjectItem* item = 0;
+    if (set) {
+        item = ensureItem(objectName);
+    }
+    else {
+        ObjectItemMap::iterator jt = ObjectMap.find(objectName);
+        if (jt != ObjectMap.end())
+            item = jt->second;
+    }
+    if (!item)
         return; // signal is emitted before the item gets created
 
-    QFont f = jt->second->font(0);
+    QFont f = item->font(0);
     switch (high) {
     case Gui::Bold: f.setBold(set);             break;
     case Gui::Italic: f.setItalic(set);         break;
@@ -997,36 +1018,40 @@ void DocumentItem::slotHighlightObject (const Gui::ViewProviderDocumentObject& o
     case Gui::Overlined: f.setOverline(set);    break;
     case Gui::Blue:
         if(set)
-            jt->second->setBackgroundColor(0,QColor(200,200,255));
+            item->setBackgroundColor(0,QColor(200,200,255));
         else
-            jt->second->setData(0, Qt::BackgroundColorRole,QVariant());
+            item->setData(0, Qt::BackgroundColorRole,QVariant());
         break;
     default:
         break;
     }
 
-    jt->second->setFont(0,f);
+    item->setFont(0,f);
 }
 
 void DocumentItem::slotExpandObject (const Gui::ViewProviderDocumentObject& obj,const Gui::TreeItemMode& mode)
 {
     std::string objectName = obj.getObject()->getNameInDocument();
-    std::map<std::string, DocumentObjectItem*>::iterator jt = ObjectMap.find(objectName);
-    if (jt == ObjectMap.end())
+    DocumentObjectItem* item = ensureItem(objectName);
+    if (!item)
         return; // signal is emitted before the item gets created
 
     switch (mode) {
     case Gui::Expand:
-        jt->second->setExpanded(true);
+        populateItem(item);
+        item->setExpanded(true);
         break;
     case Gui::Collapse:
-        jt->second->setExpanded(false);
+        item->setExpanded(false);
         break;
     case Gui::Toggle:
-        if (jt->second->isExpanded())
-            jt->second->setExpanded(false);
-        else
-            jt->second->setExpanded(true);
+        if (item->isExpanded()) {
+            item->setExpanded(false);
+        }
+        else {
+            populateItem(item);
+            item->setExpanded(true);
+        }
         break;
 
     default:
@@ -1035,6 +1060,231 @@ void DocumentItem::slotExpandObject (const Gui::ViewProviderDocumentObject& obj,
     }
 }
 
+DocumentObjectItem* DocumentItem::createItem(HiddenObjectMap::iterator jt, QTreeWidgetItem* parent)
+{
+    Gui::ViewProviderDocumentObject* view = jt->second.first;
+    std::string objectName = jt->first;
+    HiddenMap.erase(jt);
+
+    std::string displayName = view->getObject()->Label.getValue();
+    DocumentObjectItem* item = new DocumentObjectItem(view, parent);
+    item->setIcon(0, view->getIcon());
+    item->setText(0, QString::fromUtf8(displayName.c_str()));
+    ObjectMap[objectName] = item;
+    updateChildren(item);
+    return item;
+}
+
+DocumentObjectItem* DocumentItem::ensureItem(const std::string& name)
+{
+    ObjectItemMap::iterator it = ObjectMap.find(name);
+    if (it != ObjectMap.end())
+        return it->second;
+    HiddenObjectMap::iterator jt = HiddenMap.find(name);
+    if (jt == HiddenMap.end())
+        return 0;
+
+    if (!jt->second.second) {
+        // a new object
+        createPendingItems();
+        it = ObjectMap.find(name);
+        if (it != ObjectMap.end())
+            return it->second;
+        jt = HiddenMap.find(name);
+        if (jt == HiddenMap.end() || !jt->second.second)
+            return 0;
+    }
+
+    // the object is claimed by an object whose item is collapsed or not created yet
+    DocumentObjectItem* parent = ensureItem(jt->second.second->getObject()->getNameInDocument());
+    if (parent)
+        populateItem(parent);
+    it = ObjectMap.find(name);
+    return it != ObjectMap.end() ? it->second : 0;
+}
+
+void DocumentItem::scheduleItem(const std::string& name)
+{
+    if (NewObjects.empty())
+        QTimer::singleShot(0, treeWidget(), SLOT(onCreateItems()));
+    NewObjects.push_back(name);
+}
+
+void DocumentItem::createPendingItems()
+{
+    std::vector<std::string> names;
+    names.swap(NewObjects);
+
+    // objects claimed by another new object get created with the item of it
+    for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); ++it) {
+        HiddenObjectMap::iterator jt = HiddenMap.find(*it);
+        if (jt != HiddenMap.end() && !jt->second.second)
+            claimObjects(jt->second.first, jt->second.first->claimChildren());
+    }
+    for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); ++it) {
+        HiddenObjectMap::iterator jt = HiddenMap.find(*it);
+        if (jt != HiddenMap.end() && !jt->second.second)
+            createItem(jt, this);
+    }
+}
+
+void DocumentItem::populateItem(DocumentObjectItem* item)
+{
+    const Gui::ViewProviderDocumentObject* view = item->object();
+    ClaimedObjectMap::iterator ct = ClaimMap.find(view);
+    if (ct == ClaimMap.end())
+        return;
+
+    std::vector<std::string> names;
+    names.swap(ct->second);
+    ClaimMap.erase(ct);
+    item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
+    for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); ++it) {
+        HiddenObjectMap::iterator jt = HiddenMap.find(*it);
+        if (jt != HiddenMap.end() && jt->second.second == view)
+            createItem(jt, item);
+    }
+}
+
+bool DocumentItem::claimObjects(const Gui::ViewProviderDocumentObject* view,
+                                const std::vector<App::DocumentObject*>& group)
+{
+    // forget the objects claimed so far
+    std::vector<std::string> released;
+    ClaimedObjectMap::iterator ct = ClaimMap.find(view);
+    if (ct != ClaimMap.end()) {
+        released.swap(ct->second);
+        ClaimMap.erase(ct);
+        for (std::vector<std::string>::iterator it = released.begin(); it != released.end(); ++it) {
+            HiddenObjectMap::iterator jt = HiddenMap.find(*it);
+            if (jt != HiddenMap.end() && jt->second.second == view)
+                jt->second.second = 0;
+        }
+    }
+
+    bool hasItems = false;
+    std::vector<std::string> names;
+    for (std::vector<App::DocumentObject*>::const_iterator it = group.begin(); it != group.end(); ++it) {
+        if (*it) {
+            const char* internalName = (*it)->getNameInDocument();
+            if (internalName) {
+                if (ObjectMap.find(internalName) != ObjectMap.end()) {
+                    hasItems = true;
+                    continue;
+                }
+                HiddenObjectMap::iterator jt = HiddenMap.find(internalName);
+                if (jt == HiddenMap.end()) {
+                    Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Cannot reparent unknown object.\n");
+                }
+                else if (jt->second.first == view) {
+                    Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Object references to itself.\n");
+                }
+                else {
+                    jt->second.second = view;
+                    names.push_back(internalName);
+                }
+            }
+            else {
+                Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Group references unknown object.\n");
+            }
+        }
+    }
+
+    if (!names.empty())
+        ClaimMap[view].swap(names);
+
+    // objects which are not claimed anymore get their own items
+    releaseObjects(0, released);
+    return hasItems;
+}
+
+void DocumentItem::releaseObjects(const Gui::ViewProviderDocumentObject* view,
+                                  const std::vector<std::string>& names)
+{
+    for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it) {
+        HiddenObjectMap::iterator jt = HiddenMap.find(*it);
+        if (jt != HiddenMap.end() && jt->second.second == view) {
+            jt->second.second = 0;
+            scheduleItem(*it);
+        }
+    }
+}
+
+void DocumentItem::updateChildren(DocumentObjectItem* item)
+{
+    // check here which item (this or a DocumentObjectItem) is the parent of the
+    // items of the objects claimed by 'item'
+    const Gui::ViewProviderDocumentObject* view = item->object();
+    std::vector<App::DocumentObject*> group = view->claimChildren();
+
+    // A collapsed item without child items only remembers the claimed objects.
+    // Their items are created when it gets expanded.
+    if (!item->isExpanded() && item->childCount() == 0) {
+        if (!claimObjects(view, group)) {
+            item->setChildIndicatorPolicy(ClaimMap.find(view) != ClaimMap.end()
+                ? QTreeWidgetItem::ShowIndicator
+                : QTreeWidgetItem::DontShowIndicatorWhenChildless);
+            return;
+        }
+    }
+
+    std::vector<std::string> hidden;
+    ClaimedObjectMap::iterator ct = ClaimMap.find(view);
+    if (ct != ClaimMap.end()) {
+        hidden.swap(ct->second);
+        ClaimMap.erase(ct);
+    }
+    item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
+
+    // use new grouping style
+    std::set<QTreeWidgetItem*> children;
+    for (std::vector<App::DocumentObject*>::iterator jt = group.begin(); jt != group.end(); ++jt) {
+        if (*jt) {
+            const char* internalName = (*jt)->getNameInDocument();
+            if (internalName) {
+                ObjectItemMap::iterator kt = ObjectMap.find(internalName);
+                HiddenObjectMap::iterator ht = HiddenMap.find(internalName);
+                if (kt != ObjectMap.end()) {
+                    children.insert(kt->second);
+                    QTreeWidgetItem* parent = kt->second->parent();
+                    if (parent && parent != item) {
+                        if (item != kt->second) {
+                            int index = parent->indexOfChild(kt->second);
+                            parent->takeChild(index);
+                            item->addChild(kt->second);
+                        }
+                        else {
+                            Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Object references to itself.\n");
+                        }
+                    }
+                }
+                else if (ht != HiddenMap.end()) {
+                    children.insert(createItem(ht, item));
+                }
+                else {
+                    Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Cannot reparent unknown object.\n");
+                }
+            }
+            else {
+                Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Group references unknown object.\n");
+            }
+        }
+    }
+    // move all children which are not part of the group anymore to this item
+    for (int i=0; i < item->childCount();) {
+        QTreeWidgetItem* child = item->child(i);
+        if (children.find(child) == children.end()) {
+            item->takeChild(i);
+            this->addChild(child);
+        }
+        else {
+            i++;
+        }
+    }
+    // and the same for the objects claimed while the item was collapsed
+    releaseObjects(view, hidden);
+}
+
 const Gui::Document* DocumentItem::document() const
 {
     return this->pDocument;
@@ -1057,7 +1307,7 @@ const Gui::Document* DocumentItem::document() const
 
 void DocumentItem::testStatus(void)
 {
-    for (std::map<std::string,DocumentObjectItem*>::iterator pos = ObjectMap.begin();pos!=ObjectMap.end();++pos) {
+    for (ObjectItemMap::iterator pos = ObjectMap.begin();pos!=ObjectMap.end();++pos) {
         pos->second->testStatus();
     }
 }
@@ -1074,7 +1324,7 @@ void DocumentItem::setData (int column, int role, const QVariant & value)
 
 void DocumentItem::setObjectHighlighted(const char* name, bool select)
 {
-    std::map<std::string,DocumentObjectItem*>::iterator pos;
+    ObjectItemMap::iterator pos;
     pos = ObjectMap.find(name);
     if (pos != ObjectMap.end()) {
         //pos->second->setData(0, Qt::TextColorRole, QVariant(Qt::red));
@@ -1084,7 +1334,15 @@ void DocumentItem::setObjectHighlighted(const char* name, bool select)
 
 void DocumentItem::setObjectSelected(const char* name, bool select)
 {
-    std::map<std::string,DocumentObjectItem*>::iterator pos;
+    // the items of selected objects always exist
+    if (select) {
+        DocumentObjectItem* item = ensureItem(name);
+        if (item)
+            treeWidget()->setItemSelected(item, true);
+        return;
+    }
+
+    ObjectItemMap::iterator pos;
     pos = ObjectMap.find(name);
     if (pos != ObjectMap.end()) {
         treeWidget()->setItemSelected(pos->second, select);
@@ -1095,7 +1353,7 @@ void DocumentItem::clearSelection(void)
 {
     // Block signals here otherwise we get a recursion and quadratic runtime
     bool ok = treeWidget()->blockSignals(true);
-    for (std::map<std::string,DocumentObjectItem*>::iterator pos = ObjectMap.begin();pos!=ObjectMap.end();++pos) {
+    for (ObjectItemMap::iterator pos = ObjectMap.begin();pos!=ObjectMap.end();++pos) {
         pos->second->setSelected(false);
     }
     treeWidget()->blockSignals(ok);
@@ -1104,7 +1362,7 @@ void DocumentItem::clearSelection(void)
 void DocumentItem::updateSelection(void)
 {
     std::vector<App::DocumentObject*> sel;
-    for (std::map<std::string,DocumentObjectItem*>::iterator pos = ObjectMap.begin();pos!=ObjectMap.end();++pos) {
+    for (ObjectItemMap::iterator pos = ObjectMap.begin();pos!=ObjectMap.end();++pos) {
         if (treeWidget()->isItemSelected(pos->second)) {
             sel.push_back(pos->second->object()->getObject());
         }
@@ -1135,20 +1393,23 @@ struct ObjectItem_Equal : public std::binary_function<DocumentObjectItem*,
 
 void DocumentItem::selectItems(void)
 {
+    // get all selected document objects of the given document and make sure they have their items
+    std::vector<App::DocumentObject*> objs;
+    std::vector<SelectionSingleton::SelObj> obj = Selection().getSelection(pDocument->getDocument()->getName());
+    for (std::vector<SelectionSingleton::SelObj>::iterator jt = obj.begin(); jt != obj.end(); ++jt) {
+        ensureItem(jt->FeatName);
+        objs.push_back(jt->pObject);
+    }
+
     // get an array of all tree items of the document and sort it in ascending order
     // with regard to their document object
     std::vector<DocumentObjectItem*> items;
-    for (std::map<std::string,DocumentObjectItem*>::iterator it = ObjectMap.begin(); it != ObjectMap.end(); ++it) {
+    for (ObjectItemMap::iterator it = ObjectMap.begin(); it != ObjectMap.end(); ++it) {
         items.push_back(it->second);
     }
     std::sort(items.begin(), items.end(), ObjectItem_Less());
 
-    // get and sort all selected document objects of the given document
-    std::vector<App::DocumentObject*> objs;
-    std::vector<SelectionSingleton::SelObj> obj = Selection().getSelection(pDocument->getDocument()->getName());
-    for (std::vector<SelectionSingleton::SelObj>::iterator jt = obj.begin(); jt != obj.end(); ++jt) {
-        objs.push_back(jt->pObject);
-    }
+    // sort the selected document objects
     std::sort(objs.begin(), objs.end());
 
     // The document objects in 'objs' is a subset of the document objects stored
@@ -25,6 +25,7 @@
 #define GUI_TREE_H
 
 #include <QTreeWidget>
+#include <boost/unordered_map.hpp>
 
 #include <App/Document.h>
 #include <App/Application.h>
@@ -57,7 +58,7 @@ enum TreeItemMode {  Expand,
 /** Tree view that allows drag & drop of document objects.
  * @author Werner Mayer
  */
-class TreeWidget : public QTreeWidget, public SelectionObserver
+class TreeWidget : public QTreeWidget, public SelectionObserver, public SelectionBatchObserver
 {
     Q_OBJECT
 
@@ -106,6 +107,7 @@ private Q_SLOTS:
     void onItemEntered(QTreeWidgetItem * item);
     void onItemCollapsed(QTreeWidgetItem * item);
     void onItemExpanded(QTreeWidgetItem * item);
+    void onCreateItems(void);
     void onTestStatus(void);
 
 private:
@@ -149,6 +151,10 @@ public:
     void selectItems(void);
     void testStatus(void);
     void setData(int column, int role, const QVariant & value);
+    /// Creates the items of the objects claimed by \a item if not done yet.
+    void populateItem(DocumentObjectItem* item);
+    /// Creates the items of the new objects which are not claimed by another object.
+    void createPendingItems(void);
 
 protected:
     /** Adds a view provider to the document item.
@@ -167,9 +173,32 @@ protected:
     void slotHighlightObject (const Gui::ViewProviderDocumentObject&,const Gui::HighlightMode&,bool);
     void slotExpandObject    (const Gui::ViewProviderDocumentObject&,const Gui::TreeItemMode&);
 
+private:
+    typedef boost::unordered_map<std::string,DocumentObjectItem*> ObjectItemMap;
+    /// An object without item and the object claiming it, or 0 if it is new
+    typedef std::pair<Gui::ViewProviderDocumentObject*,
+                      const Gui::ViewProviderDocumentObject*> HiddenObject;
+    typedef boost::unordered_map<std::string,HiddenObject> HiddenObjectMap;
+    typedef boost::unordered_map<const Gui::ViewProviderDocumentObject*,
+                                 std::vector<std::string> > ClaimedObjectMap;
+
+    DocumentObjectItem* createItem(HiddenObjectMap::iterator, QTreeWidgetItem*);
+    DocumentObjectItem* ensureItem(const std::string&);
+    void scheduleItem(const std::string&);
+    void updateChildren(DocumentObjectItem*);
+    bool claimObjects(const Gui::ViewProviderDocumentObject*,
+                      const std::vector<App::DocumentObject*>&);
+    void releaseObjects(const Gui::ViewProviderDocumentObject*,
+                        const std::vector<std::string>&);
+
 private:
     const Gui::Document* pDocument;
-    std::map<std::string,DocumentObjectItem*> ObjectMap;
+    ObjectItemMap ObjectMap;
+    /// objects whose items are not created yet
+    HiddenObjectMap HiddenMap;
+    /// objects without items claimed by an object with a collapsed or no item
+    ClaimedObjectMap ClaimMap;
+    std::vector<std::string> NewObjects;
 };
 
 /** The link between the tree and a document object.
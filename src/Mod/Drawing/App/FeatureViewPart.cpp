@@ -59,6 +59,7 @@
 #include <Mod/Part/App/PartFeature.h>
 
 #include "FeatureViewPart.h"
+#include "FeaturePage.h"
 #include "ProjectionAlgos.h"
 
 using namespace Drawing;
@@ -87,6 +88,7 @@ FeatureViewPart::FeatureViewPart(void)
     ADD_PROPERTY_TYPE(HiddenWidth,(0.15),vgroup,App::Prop_None,"The thickness of the hidden lines, if enabled");
     ADD_PROPERTY_TYPE(Tolerance,(0.05),vgroup,App::Prop_None,"The tessellation tolerance");
     Tolerance.setConstraints(&floatRange);
+    ADD_PROPERTY_TYPE(FastHLR ,(false),group,App::Prop_None,"Remove the hidden lines of the tessellated shape, which is faster but less precise");
 }
 
 FeatureViewPart::~FeatureViewPart()
@@ -111,7 +113,8 @@ App::DocumentObjectExecReturn *FeatureViewPart::execute(void)
     bool smooth = ShowSmoothLines.getValue();
 
     try {
-        ProjectionAlgos Alg(shape,Dir);
+        prefetchProjections();
+        ProjectionAlgos Alg(shape,Dir,FastHLR.getValue(),Tolerance.getValue());
         result  << "<g" 
                 << " id=\"" << ViewName << "\"" << endl
                 << "   transform=\"rotate("<< Rotation.getValue() << ","<< X.getValue()<<","<<Y.getValue()<<") translate("<< X.getValue()<<","<<Y.getValue()<<") scale("<< Scale.getValue()<<","<<Scale.getValue()<<")\"" << endl
@@ -136,6 +139,39 @@ App::DocumentObjectExecReturn *FeatureViewPart::execute(void)
 }
 
 
+void FeatureViewPart::prefetchProjections() const
+{
+    // Compute the projections of all views of the page that are going to be recomputed at once
+    // and concurrently. The views then find their result in the cache of ProjectionAlgos.
+    std::vector<ProjectionAlgos::Projection> projections;
+    std::vector<App::DocumentObject*> parents = getInList();
+    for (std::vector<App::DocumentObject*>::iterator it = parents.begin(); it != parents.end(); ++it) {
+        if (!(*it)->getTypeId().isDerivedFrom(Drawing::FeaturePage::getClassTypeId()))
+            continue;
+        const std::vector<App::DocumentObject*>& views = static_cast<Drawing::FeaturePage*>(*it)->Group.getValues();
+        for (std::vector<App::DocumentObject*>::const_iterator jt = views.begin(); jt != views.end(); ++jt) {
+            if (!(*jt)->getTypeId().isDerivedFrom(Drawing::FeatureViewPart::getClassTypeId()))
+                continue;
+            const FeatureViewPart* view = static_cast<const FeatureViewPart*>(*jt);
+            if (view != this && !view->isTouched() && !view->mustExecute())
+                continue;
+            App::DocumentObject* link = view->Source.getValue();
+            if (!link || !link->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId()))
+                continue;
+
+            ProjectionAlgos::Projection projection;
+            projection.Input = static_cast<Part::Feature*>(link)->Shape.getShape()._Shape;
+            projection.Direction = view->Direction.getValue();
+            projection.Poly = view->FastHLR.getValue();
+            projection.Deflection = view->Tolerance.getValue();
+            projections.push_back(projection);
+        }
+    }
+
+    if (projections.size() > 1)
+        ProjectionAlgos::computeProjections(projections);
+}
+
 
 // Python Drawing feature ---------------------------------------------------------
 
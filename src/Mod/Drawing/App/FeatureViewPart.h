@@ -55,6 +55,7 @@ public:
     App::PropertyFloat  LineWidth;
     App::PropertyFloat  HiddenWidth;
     App::PropertyFloatConstraint  Tolerance;
+    App::PropertyBool   FastHLR;
 
 
     /** @name methods overide Feature */
@@ -68,6 +69,9 @@ public:
         return "DrawingGui::ViewProviderDrawingView";
     }
 
+private:
+    void prefetchProjections() const;
+
 private:
     static App::PropertyFloatConstraint::Constraints floatRange;
 };
@@ -33,8 +33,11 @@
 
 #include <Bnd_Box.hxx>
 #include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
 #include <HLRBRep_Algo.hxx>
+#include <HLRBRep_PolyAlgo.hxx>
+#include <HLRBRep_PolyHLRToShape.hxx>
 #include <TopoDS_Shape.hxx>
 #include <HLRTopoBRep_OutLiner.hxx>
 //#include <BRepAPI_MakeOutLine.hxx>
@@ -72,6 +75,13 @@
 #include <GeomConvert_BSplineCurveToBezierCurve.hxx>
 #include <GeomConvert_BSplineCurveKnotSplitting.hxx>
 #include <Geom2d_BSplineCurve.hxx>
+#include <Standard_Failure.hxx>
+
+#include <algorithm>
+#include <list>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrentMap>
 
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
@@ -91,7 +101,14 @@ using namespace std;
 
 
 ProjectionAlgos::ProjectionAlgos(const TopoDS_Shape &Input, const Base::Vector3d &Dir)
-  : Input(Input), Direction(Dir)
+  : Input(Input), Direction(Dir), PolyHLR(false), Deflection(0.0)
+{
+    execute();
+}
+
+ProjectionAlgos::ProjectionAlgos(const TopoDS_Shape &Input, const Base::Vector3d &Dir,
+                                 bool poly, double deflection)
+  : Input(Input), Direction(Dir), PolyHLR(poly), Deflection(deflection)
 {
     execute();
 }
@@ -134,13 +151,94 @@ static const TopoDS_Shape& build3dCurves(const TopoDS_Shape &shape)
   return shape;
 }
 
-void ProjectionAlgos::execute(void)
+namespace Drawing {
+// The result sets of a hidden line removal
+struct ProjectionResult {
+    TopoDS_Shape input;
+    TopoDS_Shape work; // the shape the projection is computed from, not cached
+    Base::Vector3d direction;
+    bool poly;
+    double deflection;
+    bool failed;
+    TopoDS_Shape shapes[10]; // V, V1, VN, VO, VI, H, H1, HN, HO, HI
+};
+}
+
+// The hidden line removal is by far the most expensive step of a view. Its results are cached
+// by the identity of the input shape and the direction, so that changing the scale, position or
+// line style of a view or a second view of the same projection doesn't compute it again.
+// The cache grows to the size of the largest batch of computeProjections(), otherwise the
+// prefetched results would be evicted before their views use them.
+static const std::size_t maxCachedProjections = 32;
+static std::size_t projectionCacheSize = maxCachedProjections;
+static std::list<ProjectionResult> projectionCache; // most recently used first
+static QMutex projectionMutex;
+
+static bool isSameProjection(const ProjectionResult& result, const TopoDS_Shape& input,
+                             const Base::Vector3d& dir, bool poly, double deflection)
 {
-    Handle( HLRBRep_Algo ) brep_hlr = new HLRBRep_Algo;
-    brep_hlr->Add(Input);
+    return result.input.IsEqual(input) && result.direction == dir &&
+           result.poly == poly && (!poly || result.deflection == deflection);
+}
+
+static bool findProjection(const TopoDS_Shape& input, const Base::Vector3d& dir,
+                           bool poly, double deflection, ProjectionResult* result)
+{
+    QMutexLocker locker(&projectionMutex);
+    for (std::list<ProjectionResult>::iterator it = projectionCache.begin(); it != projectionCache.end(); ++it) {
+        if (isSameProjection(*it, input, dir, poly, deflection)) {
+            projectionCache.splice(projectionCache.begin(), projectionCache, it);
+            if (result)
+                *result = projectionCache.front();
+            return true;
+        }
+    }
+    return false;
+}
+
+static void storeProjection(const ProjectionResult& result)
+{
+    QMutexLocker locker(&projectionMutex);
+    projectionCache.push_front(result);
+    projectionCache.front().work.Nullify();
+    if (projectionCache.size() > projectionCacheSize)
+        projectionCache.pop_back();
+}
+
+// Tessellating writes the triangulation into the shape and the views of a page may share
+// their input, so the polygonal algorithm and concurrent projections work on a private copy
+// instead of the shape of the document
+static void computeProjection(ProjectionResult& result, bool copy)
+{
+    result.work = copy ? BRepBuilderAPI_Copy(result.input).Shape() : result.input;
+    if (result.poly)
+        BRepMesh_IncrementalMesh(result.work, result.deflection);
 
-    gp_Ax2 transform(gp_Pnt(0,0,0),gp_Dir(Direction.x,Direction.y,Direction.z));
+    gp_Ax2 transform(gp_Pnt(0,0,0),gp_Dir(result.direction.x,result.direction.y,result.direction.z));
     HLRAlgo_Projector projector( transform );
+
+    if (result.poly) {
+        Handle( HLRBRep_PolyAlgo ) poly_hlr = new HLRBRep_PolyAlgo(result.work);
+        poly_hlr->Projector(projector);
+        poly_hlr->Update();
+
+        // extracting the result sets, there are no iso lines:
+        HLRBRep_PolyHLRToShape shapes;
+        shapes.Update(poly_hlr);
+
+        result.shapes[0] = build3dCurves(shapes.VCompound       ());
+        result.shapes[1] = build3dCurves(shapes.Rg1LineVCompound());
+        result.shapes[2] = build3dCurves(shapes.RgNLineVCompound());
+        result.shapes[3] = build3dCurves(shapes.OutLineVCompound());
+        result.shapes[5] = build3dCurves(shapes.HCompound       ());
+        result.shapes[6] = build3dCurves(shapes.Rg1LineHCompound());
+        result.shapes[7] = build3dCurves(shapes.RgNLineHCompound());
+        result.shapes[8] = build3dCurves(shapes.OutLineHCompound());
+        return;
+    }
+
+    Handle( HLRBRep_Algo ) brep_hlr = new HLRBRep_Algo;
+    brep_hlr->Add(result.work);
     brep_hlr->Projector(projector);
     brep_hlr->Update();
     brep_hlr->Hide();
@@ -148,16 +246,99 @@ void ProjectionAlgos::execute(void)
     // extracting the result sets:
     HLRBRep_HLRToShape shapes( brep_hlr );
 
-    V  = build3dCurves(shapes.VCompound       ());// hard edge visibly
-    V1 = build3dCurves(shapes.Rg1LineVCompound());// Smoth edges visibly
-    VN = build3dCurves(shapes.RgNLineVCompound());// contour edges visibly
-    VO = build3dCurves(shapes.OutLineVCompound());// contours apparents visibly
-    VI = build3dCurves(shapes.IsoLineVCompound());// isoparamtriques   visibly
-    H  = build3dCurves(shapes.HCompound       ());// hard edge       invisibly
-    H1 = build3dCurves(shapes.Rg1LineHCompound());// Smoth edges  invisibly
-    HN = build3dCurves(shapes.RgNLineHCompound());// contour edges invisibly
-    HO = build3dCurves(shapes.OutLineHCompound());// contours apparents invisibly
-    HI = build3dCurves(shapes.IsoLineHCompound());// isoparamtriques   invisibly
+    result.shapes[0] = build3dCurves(shapes.VCompound       ());// hard edge visibly
+    result.shapes[1] = build3dCurves(shapes.Rg1LineVCompound());// Smoth edges visibly
+    result.shapes[2] = build3dCurves(shapes.RgNLineVCompound());// contour edges visibly
+    result.shapes[3] = build3dCurves(shapes.OutLineVCompound());// contours apparents visibly
+    result.shapes[4] = build3dCurves(shapes.IsoLineVCompound());// isoparamtriques   visibly
+    result.shapes[5] = build3dCurves(shapes.HCompound       ());// hard edge       invisibly
+    result.shapes[6] = build3dCurves(shapes.Rg1LineHCompound());// Smoth edges  invisibly
+    result.shapes[7] = build3dCurves(shapes.RgNLineHCompound());// contour edges invisibly
+    result.shapes[8] = build3dCurves(shapes.OutLineHCompound());// contours apparents invisibly
+    result.shapes[9] = build3dCurves(shapes.IsoLineHCompound());// isoparamtriques   invisibly
+}
+
+static void computeProjectionNoThrow(ProjectionResult& result)
+{
+    try {
+        computeProjection(result, true);
+    }
+    catch (Standard_Failure) {
+        // the view reports the error when it computes the projection itself
+        result.failed = true;
+    }
+}
+
+void ProjectionAlgos::execute(void)
+{
+    ProjectionResult result;
+    if (!findProjection(Input, Direction, PolyHLR, Deflection, &result)) {
+        result.input = Input;
+        result.direction = Direction;
+        result.poly = PolyHLR;
+        result.deflection = Deflection;
+        result.failed = false;
+        computeProjection(result, PolyHLR);
+        storeProjection(result);
+    }
+
+    V  = result.shapes[0];
+    V1 = result.shapes[1];
+    VN = result.shapes[2];
+    VO = result.shapes[3];
+    VI = result.shapes[4];
+    H  = result.shapes[5];
+    H1 = result.shapes[6];
+    HN = result.shapes[7];
+    HO = result.shapes[8];
+    HI = result.shapes[9];
+}
+
+void ProjectionAlgos::computeProjections(const std::vector<Projection>& projections)
+{
+    {
+        QMutexLocker locker(&projectionMutex);
+        projectionCacheSize = std::max<std::size_t>(projectionCacheSize, projections.size());
+    }
+
+    std::vector<ProjectionResult> results;
+    for (std::vector<Projection>::const_iterator it = projections.begin(); it != projections.end(); ++it) {
+        if (it->Input.IsNull() || findProjection(it->Input, it->Direction, it->Poly, it->Deflection, 0))
+            continue;
+        bool duplicate = false;
+        for (std::vector<ProjectionResult>::iterator jt = results.begin(); jt != results.end() && !duplicate; ++jt)
+            duplicate = isSameProjection(*jt, it->Input, it->Direction, it->Poly, it->Deflection);
+        if (duplicate)
+            continue;
+
+        ProjectionResult result;
+        result.input = it->Input;
+        result.direction = it->Direction;
+        result.poly = it->Poly;
+        result.deflection = it->Deflection;
+        result.failed = false;
+        results.push_back(result);
+    }
+
+    if (results.empty())
+        return;
+
+    if (results.size() > 1)
+        QtConcurrent::blockingMap(results, computeProjectionNoThrow);
+    else
+        computeProjectionNoThrow(results.front());
+
+    for (std::vector<ProjectionResult>::iterator it = results.begin(); it != results.end(); ++it) {
+        if (!it->failed)
+            storeProjection(*it);
+    }
+}
+
+void ProjectionAlgos::clearCache()
+{
+    QMutexLocker locker(&projectionMutex);
+    projectionCache.clear();
+    projectionCacheSize = maxCachedProjections;
 }
 
 std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double tolerance, double hiddenscale)
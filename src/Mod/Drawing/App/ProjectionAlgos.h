@@ -27,6 +27,7 @@
 #include <TopoDS_Shape.hxx>
 #include <Base/Vector3D.h>
 #include <string>
+#include <vector>
 
 class BRepAdaptor_Curve;
 
@@ -40,6 +41,11 @@ class DrawingExport ProjectionAlgos
 public:
     /// Constructor
     ProjectionAlgos(const TopoDS_Shape &Input,const Base::Vector3d &Dir);
+    /** Constructor
+     * With \a poly set the hidden lines are removed from the tessellation of the shape with the
+     * given deflection. This is much faster but less precise, e.g. for previews.
+     */
+    ProjectionAlgos(const TopoDS_Shape &Input,const Base::Vector3d &Dir,bool poly,double deflection);
     virtual ~ProjectionAlgos();
 
     void execute(void);
@@ -54,9 +60,26 @@ public:
     std::string getSVG(ExtractionType type, double scale=0.35, double tolerance=0.05, double hiddenscale=0.15);
     std::string getDXF(ExtractionType type, double scale, double tolerance);//added by Dan Falck 2011/09/25
 
+    /// A projection to be computed by computeProjections()
+    struct Projection {
+        TopoDS_Shape Input;
+        Base::Vector3d Direction;
+        bool Poly;
+        double Deflection;
+    };
+    /** Computes the hidden line removal of several projections concurrently. The results are
+     * cached like the ones of execute(), so that the ProjectionAlgos instances created
+     * afterwards for the same shapes and directions don't compute them again.
+     */
+    static void computeProjections(const std::vector<Projection>&);
+    /// Releases the cached projections, done whenever a document is closed
+    static void clearCache();
+
 
     const TopoDS_Shape &Input;
     const Base::Vector3d &Direction;
+    bool PolyHLR;
+    double Deflection;
 
     TopoDS_Shape V ;// hard edge visibly
     TopoDS_Shape V1;// Smoth edges visibly
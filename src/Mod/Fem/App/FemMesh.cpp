@@ -46,6 +46,7 @@
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/Core/Evaluation.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/NastranReader.h>
 
 #include "FemMesh.h"
 
@@ -444,6 +445,25 @@ std::set<long> FemMesh::getSurfaceNodes(const TopoDS_Face &face)const
 
 
 
+namespace Fem {
+// Node order of the Nastran elements in SMESH, indexed by NastranReader::ElementType
+static const int nastranTria3[]   = {0,1,2};
+static const int nastranTria6[]   = {0,1,2,3,4,5};
+static const int nastranQuad4[]   = {0,1,2,3};
+static const int nastranQuad8[]   = {0,1,2,3,4,5,6,7};
+static const int nastranTetra4[]  = {1,0,2,3};
+static const int nastranTetra10[] = {1,0,2,3,4,6,5,8,7,9};
+static const int nastranPenta6[]  = {0,2,1,3,5,4};
+static const int nastranPenta15[] = {0,2,1,3,5,4,8,7,6,14,13,12,9,11,10};
+static const int nastranHexa8[]   = {0,3,2,1,4,7,6,5};
+static const int nastranHexa20[]  = {0,3,2,1,4,7,6,5,11,10,9,8,19,18,17,16,12,15,14,13};
+static const int* nastranNodeOrder[] = {
+    nastranTria3, nastranTria6, nastranQuad4, nastranQuad8,
+    nastranTetra4, nastranTetra10, nastranPenta6, nastranPenta15,
+    nastranHexa8, nastranHexa20
+};
+}
+
 void FemMesh::readNastran(const std::string &Filename)
 {
     Base::TimeInfo Start;
@@ -451,171 +471,99 @@ void FemMesh::readNastran(const std::string &Filename)
 
     _Mtrx = Base::Matrix4D();
 
-	std::ifstream inputfile;
-	inputfile.open(Filename.c_str());
-	inputfile.seekg(std::ifstream::beg);
-	std::string line1,line2,temp;
-	std::vector<string> token_results;
-	token_results.clear();
-	Base::Vector3d current_node;
-	std::vector<Base::Vector3d> vertices;
-	vertices.clear();
-	std::vector<unsigned int> nodal_id;
-	nodal_id.clear();
-	std::vector<unsigned int> tetra_element;
-	std::vector<std::vector<unsigned int> > all_elements;
-	std::vector<unsigned int> element_id;
-	element_id.clear();
-	bool nastran_free_format = false;
-	do
-	{
-		std::getline(inputfile,line1);
-		if (line1.size() == 0) continue;
-		if (!nastran_free_format && line1.find(",")!= std::string::npos)
-			nastran_free_format = true;
-		if (!nastran_free_format && line1.find("GRID*")!= std::string::npos ) //We found a Grid line
-		{
-			//Now lets extract the GRID Points = Nodes
-			//As each GRID Line consists of two subsequent lines we have to
-			//take care of that as well
-			std::getline(inputfile,line2);
-			//Get the Nodal ID
-			nodal_id.push_back(atoi(line1.substr(8,24).c_str()));
-			//Extract X Value
-			current_node.x = atof(line1.substr(40,56).c_str());
-			//Extract Y Value
-			current_node.y = atof(line1.substr(56,72).c_str());
-			//Extract Z Value
-			current_node.z = atof(line2.substr(8,24).c_str());
-
-			vertices.push_back(current_node);
-		}
-		else if (!nastran_free_format && line1.find("CTETRA")!= std::string::npos)
-		{
-			tetra_element.clear();
-			//Lets extract the elements
-			//As each Element Line consists of two subsequent lines as well 
-			//we have to take care of that
-			//At a first step we only extract Quadratic Tetrahedral Elements
-			std::getline(inputfile,line2);
-            unsigned int id = atoi(line1.substr(8,16).c_str());
-            int offset = 0;
-
-            if(id < 1000000)
-                offset = 0;
-            else if (id < 10000000)
-                offset = 1;
-            else if (id < 100000000)
-                offset = 2;
-            
+    MeshCore::NastranReader reader;
+    if (!reader.readFile(Filename))
+        throw Base::FileException("Cannot read Nastran file", Filename.c_str());
 
-			element_id.push_back(id);
-			tetra_element.push_back(atoi(line1.substr(24,32).c_str()));
-			tetra_element.push_back(atoi(line1.substr(32,40).c_str()));
-			tetra_element.push_back(atoi(line1.substr(40,48).c_str()));
-			tetra_element.push_back(atoi(line1.substr(48,56).c_str()));
-			tetra_element.push_back(atoi(line1.substr(56,64).c_str()));
-			tetra_element.push_back(atoi(line1.substr(64,72).c_str()));
-			tetra_element.push_back(atoi(line2.substr(8+offset,16+offset).c_str()));
-			tetra_element.push_back(atoi(line2.substr(16+offset,24+offset).c_str()));
-			tetra_element.push_back(atoi(line2.substr(24+offset,32+offset).c_str()));
-			tetra_element.push_back(atoi(line2.substr(32+offset,40+offset).c_str()));
-
-			all_elements.push_back(tetra_element);
-		}
-		else if (nastran_free_format && line1.find("GRID")!= std::string::npos ) //We found a Grid line
-		{
-			char_separator<char> sep(",");
-			tokenizer<char_separator<char> > tokens(line1, sep);
-			token_results.assign(tokens.begin(),tokens.end());
-			if (token_results.size() < 3)
-				continue;//Line does not include Nodal coordinates
-			nodal_id.push_back(atoi(token_results[1].c_str()));
-			current_node.x = atof(token_results[3].c_str());
-			current_node.y = atof(token_results[4].c_str());		
-			current_node.z = atof(token_results[5].c_str());
-			vertices.push_back(current_node);
-		}
-		else if (nastran_free_format && line1.find("CTETRA")!= std::string::npos)
-		{
-			tetra_element.clear();
-			//Lets extract the elements
-			//As each Element Line consists of two subsequent lines as well 
-			//we have to take care of that
-			//At a first step we only extract Quadratic Tetrahedral Elements
-			std::getline(inputfile,line2);
-			char_separator<char> sep(",");
-			tokenizer<char_separator<char> > tokens(line1.append(line2), sep);
-			token_results.assign(tokens.begin(),tokens.end());
-			if (token_results.size() < 11)
-				continue;//Line does not include enough nodal IDs
-			element_id.push_back(atoi(token_results[1].c_str()));
-			tetra_element.push_back(atoi(token_results[3].c_str()));
-			tetra_element.push_back(atoi(token_results[4].c_str()));
-			tetra_element.push_back(atoi(token_results[5].c_str()));
-			tetra_element.push_back(atoi(token_results[6].c_str()));
-			tetra_element.push_back(atoi(token_results[7].c_str()));
-			tetra_element.push_back(atoi(token_results[8].c_str()));
-			tetra_element.push_back(atoi(token_results[10].c_str()));
-			tetra_element.push_back(atoi(token_results[11].c_str()));
-			tetra_element.push_back(atoi(token_results[12].c_str()));
-			tetra_element.push_back(atoi(token_results[13].c_str()));
-
-			all_elements.push_back(tetra_element);
-		}
+    Base::Console().Timing("FemMesh::readNastran: file read",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
-	}
-	while (inputfile.good());
-	inputfile.close();
+    const std::vector<MeshCore::NastranReader::Node>& nodes = reader.getNodes();
+    const std::vector<MeshCore::NastranReader::Element>& elements = reader.getElements();
+    const std::vector<int>& grids = reader.getElementNodes();
 
-    Base::Console().Log("    %f: File read, start building mesh\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
+    //Now fill the SMESH datastructure
+    SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
+    meshds->ClearMesh();
 
-	//Now fill the SMESH datastructure
-	std::vector<Base::Vector3d>::const_iterator anodeiterator;
-	SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
-	meshds->ClearMesh();
-	unsigned int j=0;
-	for(anodeiterator=vertices.begin(); anodeiterator!=vertices.end(); anodeiterator++)
-	{
-		meshds->AddNodeWithID((*anodeiterator).x,(*anodeiterator).y,(*anodeiterator).z,nodal_id[j]);
-		j++;
-	}
+    // As long as the node ids are reasonably dense the created nodes are kept
+    // in a table to avoid a search in the node map for each element grid
+    int maxId = 0;
+    for (std::vector<MeshCore::NastranReader::Node>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+        maxId = std::max<int>(maxId, it->id);
+    std::vector<const SMDS_MeshNode*> nodeTable;
+    if (maxId > 0 && static_cast<std::size_t>(maxId) <= 4 * nodes.size() + 1024)
+        nodeTable.resize(maxId + 1, 0);
+
+    // The nodes are added in one go to the underlying SMDS_Mesh which skips
+    // recording an AddNode command in the edit script for each single node.
+    // The script is only flagged as modified once afterwards.
+    for (std::vector<MeshCore::NastranReader::Node>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
+        const SMDS_MeshNode* node = meshds->SMDS_Mesh::AddNodeWithID(it->x, it->y, it->z, it->id);
+        if (node && it->id >= 0 && it->id < (int)nodeTable.size())
+            nodeTable[it->id] = node;
+    }
+    meshds->GetScript()->SetModified(true);
+
+    std::size_t skipped = 0;
+    const SMDS_MeshNode* n[20];
+    for (std::vector<MeshCore::NastranReader::Element>::const_iterator it = elements.begin(); it != elements.end(); ++it) {
+        const int* order = nastranNodeOrder[it->type];
+        bool valid = true;
+        for (int i = 0; i < it->count && valid; i++) {
+            int id = grids[it->first + order[i]];
+            if (nodeTable.empty())
+                n[i] = meshds->FindNode(id);
+            else if (id >= 0 && id < (int)nodeTable.size())
+                n[i] = nodeTable[id];
+            else
+                n[i] = 0;
+            valid = (n[i] != 0);
+        }
+        if (!valid) {
+            skipped++;
+            continue;
+        }
 
-	for(unsigned int i=0;i<all_elements.size();i++)
-	{
-		//Die Reihenfolge wie hier die Elemente hinzugefgt werden ist sehr wichtig. 
-		//Ansonsten ist eine konsistente Datenstruktur nicht mglich
-		//meshds->AddVolumeWithID
-		//(
-		//	meshds->FindNode(all_elements[i][0]),
-		//	meshds->FindNode(all_elements[i][2]),
-		//	meshds->FindNode(all_elements[i][1]),
-		//	meshds->FindNode(all_elements[i][3]),
-		//	meshds->FindNode(all_elements[i][6]),
-		//	meshds->FindNode(all_elements[i][5]),
-		//	meshds->FindNode(all_elements[i][4]),
-		//	meshds->FindNode(all_elements[i][9]),
-		//	meshds->FindNode(all_elements[i][7]),
-		//	meshds->FindNode(all_elements[i][8]),
-		//	element_id[i]
-		//);
-		meshds->AddVolumeWithID
-		(
-			meshds->FindNode(all_elements[i][1]),
-			meshds->FindNode(all_elements[i][0]),
-			meshds->FindNode(all_elements[i][2]),
-			meshds->FindNode(all_elements[i][3]),
-			meshds->FindNode(all_elements[i][4]),
-			meshds->FindNode(all_elements[i][6]),
-			meshds->FindNode(all_elements[i][5]),
-			meshds->FindNode(all_elements[i][8]),
-			meshds->FindNode(all_elements[i][7]),
-			meshds->FindNode(all_elements[i][9]),
-			element_id[i]
-		);
-	}
-    Base::Console().Log("    %f: Done \n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
+        switch (it->type) {
+        case MeshCore::NastranReader::Tria3:
+            meshds->AddFaceWithID(n[0],n[1],n[2],it->id);
+            break;
+        case MeshCore::NastranReader::Tria6:
+            meshds->AddFaceWithID(n[0],n[1],n[2],n[3],n[4],n[5],it->id);
+            break;
+        case MeshCore::NastranReader::Quad4:
+            meshds->AddFaceWithID(n[0],n[1],n[2],n[3],it->id);
+            break;
+        case MeshCore::NastranReader::Quad8:
+            meshds->AddFaceWithID(n[0],n[1],n[2],n[3],n[4],n[5],n[6],n[7],it->id);
+            break;
+        case MeshCore::NastranReader::Tetra4:
+            meshds->AddVolumeWithID(n[0],n[1],n[2],n[3],it->id);
+            break;
+        case MeshCore::NastranReader::Tetra10:
+            meshds->AddVolumeWithID(n[0],n[1],n[2],n[3],n[4],n[5],n[6],n[7],n[8],n[9],it->id);
+            break;
+        case MeshCore::NastranReader::Penta6:
+            meshds->AddVolumeWithID(n[0],n[1],n[2],n[3],n[4],n[5],it->id);
+            break;
+        case MeshCore::NastranReader::Penta15:
+            meshds->AddVolumeWithID(n[0],n[1],n[2],n[3],n[4],n[5],n[6],n[7],
+                                    n[8],n[9],n[10],n[11],n[12],n[13],n[14],it->id);
+            break;
+        case MeshCore::NastranReader::Hexa8:
+            meshds->AddVolumeWithID(n[0],n[1],n[2],n[3],n[4],n[5],n[6],n[7],it->id);
+            break;
+        case MeshCore::NastranReader::Hexa20:
+            meshds->AddVolumeWithID(n[0],n[1],n[2],n[3],n[4],n[5],n[6],n[7],n[8],n[9],
+                                    n[10],n[11],n[12],n[13],n[14],n[15],n[16],n[17],n[18],n[19],it->id);
+            break;
+        }
+    }
 
+    if (skipped > 0)
+        Base::Console().Warning("%lu elements of '%s' refer to undefined nodes and were skipped\n",
+            (unsigned long)skipped, Filename.c_str());
+    Base::Console().Timing("FemMesh::readNastran: done",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 }
 
 
@@ -36,6 +36,7 @@
 #include <Base/MatrixPy.h>
 #include <Base/PlacementPy.h>
 #include <Base/QuantityPy.h>
+#include <Base/PyBuffer.h>
 
 #include <Mod/Part/App/TopoShapePy.h>
 #include <Mod/Part/App/TopoShapeFacePy.h>
@@ -560,6 +561,77 @@ PyObject* FemMeshPy::getNodesByFace(PyObject *args)
   
 }
 
+PyObject* FemMeshPy::getNodeData(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    PY_TRY {
+        Base::Matrix4D Mtrx = getFemMeshPtr()->getTransform();
+        SMESHDS_Mesh* meshDS = getFemMeshPtr()->getSMesh()->GetMeshDS();
+        Py_ssize_t count = meshDS->NbNodes();
+
+        char *idData, *xyzData;
+        Py::Object ids(Base::createByteArray(count * sizeof(unsigned int), idData), true);
+        Py::Object xyz(Base::createByteArray(3 * count * sizeof(double), xyzData), true);
+        unsigned int* id = reinterpret_cast<unsigned int*>(idData);
+        double* pnt = reinterpret_cast<double*>(xyzData);
+
+        SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+        for (Py_ssize_t i=0; i<count && aNodeIter->more(); i++) {
+            const SMDS_MeshNode* aNode = aNodeIter->next();
+            Base::Vector3d vec = Mtrx * Base::Vector3d(aNode->X(),aNode->Y(),aNode->Z());
+            *id++ = (unsigned int)aNode->GetID();
+            *pnt++ = vec.x;
+            *pnt++ = vec.y;
+            *pnt++ = vec.z;
+        }
+
+        Py::Tuple tuple(2);
+        tuple.setItem(0, ids);
+        tuple.setItem(1, xyz);
+        return Py::new_reference_to(tuple);
+    } PY_CATCH;
+}
+
+PyObject* FemMeshPy::addNodeData(PyObject *args)
+{
+    PyObject *pxyz, *pids = 0;
+    if (!PyArg_ParseTuple(args, "O|O", &pxyz, &pids))
+        return 0;
+
+    PY_TRY {
+        Base::PyBufferReader xyzBuf(pxyz);
+        if (xyzBuf.size() % 3 != 0)
+            throw Py::ValueError("Number of coordinates is not a multiple of three");
+        std::vector<double> xyz(xyzBuf.size());
+        if (!xyz.empty())
+            xyzBuf.copyTo(&xyz[0]);
+
+        std::size_t count = xyz.size() / 3;
+        std::vector<long> ids;
+        if (pids && pids != Py_None) {
+            Base::PyBufferReader idBuf(pids);
+            if ((std::size_t)idBuf.size() != count)
+                throw Py::ValueError("Number of IDs differs from the number of nodes");
+            ids.resize(count);
+            if (!ids.empty())
+                idBuf.copyTo(&ids[0]);
+        }
+
+        SMESHDS_Mesh* meshDS = getFemMeshPtr()->getSMesh()->GetMeshDS();
+        for (std::size_t i=0; i<count; i++) {
+            SMDS_MeshNode* node = ids.empty()
+                ? meshDS->AddNode(xyz[3*i],xyz[3*i+1],xyz[3*i+2])
+                : meshDS->AddNodeWithID(xyz[3*i],xyz[3*i+1],xyz[3*i+2],(int)ids[i]);
+            if (!node)
+                throw Py::RuntimeError("Failed to add node");
+        }
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 
 
 // ===== Atributes ============================================================
@@ -0,0 +1,98 @@
+#   (c) The FreeCAD developers 2014                            LGPL        *
+#                                                                         *
+#   This file is part of the FreeCAD CAx development system.              *
+#                                                                         *
+#   This program is free software; you can redistribute it and/or modify  *
+#   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#   as published by the Free Software Foundation; either version 2 of     *
+#   the License, or (at your option) any later version.                   *
+#   for detail see the LICENCE text file.                                 *
+#                                                                         *
+#   FreeCAD is distributed in the hope that it will be useful,            *
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#   GNU Library General Public License for more details.                  *
+#                                                                         *
+#   You should have received a copy of the GNU Library General Public     *
+#   License along with FreeCAD; if not, write to the Free Software        *
+#   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#   USA                                                                   *
+#**************************************************************************
+
+import FreeCAD, os, tempfile, unittest, array, ctypes, Fem
+
+#---------------------------------------------------------------------------
+# define the test cases to test the FreeCAD Fem module
+#---------------------------------------------------------------------------
+
+
+class FemMeshBufferTestCases(unittest.TestCase):
+	def setUp(self):
+		self.mesh = Fem.FemMesh()
+		for i in range(10):
+			self.mesh.addNode(i, 2.0 * i, -0.5 * i, 100 + i)
+
+	def unpack(self, data, typecode):
+		values = array.array(typecode)
+		values.fromstring(str(data))
+		return values
+
+	def testNodeData(self):
+		ids, xyz = self.mesh.getNodeData()
+		ids = self.unpack(ids, 'I')
+		xyz = self.unpack(xyz, 'd')
+		self.failUnless(len(ids) == self.mesh.NodeCount)
+		self.failUnless(len(xyz) == 3 * self.mesh.NodeCount)
+		nodes = self.mesh.Nodes
+		for i, id in enumerate(ids):
+			p = FreeCAD.Vector(xyz[3*i], xyz[3*i+1], xyz[3*i+2])
+			self.failUnless((p - nodes[id]).Length < 1e-9)
+
+	def testAddNodeData(self):
+		ids, xyz = self.mesh.getNodeData()
+		ids = self.unpack(ids, 'I')
+		xyz = self.unpack(xyz, 'd')
+		other = Fem.FemMesh()
+		other.addNodeData((ctypes.c_double * len(xyz))(*xyz), (ctypes.c_uint * len(ids))(*ids))
+		self.failUnless(other.NodeCount == self.mesh.NodeCount)
+		nodes = self.mesh.Nodes
+		for id, p in other.Nodes.items():
+			self.failUnless((p - nodes[id]).Length < 1e-9)
+		# without IDs the nodes get new ones
+		other.addNodeData((ctypes.c_float * 3)(1, 2, 3))
+		self.failUnless(other.NodeCount == self.mesh.NodeCount + 1)
+
+	def testInvalidData(self):
+		self.assertRaises(ValueError, Fem.FemMesh().addNodeData, (ctypes.c_double * 4)())
+		self.assertRaises(ValueError, Fem.FemMesh().addNodeData, (ctypes.c_double * 6)(), (ctypes.c_int * 1)(1))
+
+
+class FemMeshNastranTestCases(unittest.TestCase):
+	def setUp(self):
+		# small field and free field cards mixed in one deck
+		lines = ["$ test deck", "BEGIN BULK"]
+		lines.append("%-8s%-8s%-8s%-8s%-8s%-8s" % ("GRID", "1", "", "0.", "0.", "0."))
+		lines.append("%-8s%-8s%-8s%-8s%-8s%-8s" % ("GRID", "2", "", "1.", "0.", "0."))
+		lines.append("GRID,3,,1.,1.,0.")
+		lines.append("GRID, 4, , 0., 1., 0.")
+		lines.append("GRID,10,,0.,0.,1.")
+		lines.append("%-8s%-8s%-8s%-8s%-8s%-8s" % ("CTRIA3", "1", "1", "1", "2", "3"))
+		lines.append("CTRIA3,2,1,1,3,4")
+		lines.append("CTETRA,3,1,1,2,4,10")
+		lines.append("$ refers to an undefined node and is skipped")
+		lines.append("CTRIA3,4,1,1,2,99")
+		lines.append("ENDDATA")
+		self.fileName = tempfile.gettempdir() + os.sep + "FemNastranTest.bdf"
+		file = open(self.fileName, "w")
+		file.write("\n".join(lines) + "\n")
+		file.close()
+
+	def testReadDeck(self):
+		mesh = Fem.read(self.fileName)
+		self.failUnless(mesh.NodeCount == 5)
+		self.failUnless(mesh.TriangleCount == 2)
+		self.failUnless(mesh.TetraCount == 1)
+		self.failUnless(abs(mesh.Nodes[10].z - 1.0) < 1e-9)
+
+	def tearDown(self):
+		os.remove(self.fileName)
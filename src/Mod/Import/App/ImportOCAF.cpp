@@ -57,6 +57,12 @@
 # include <TopoDS_Iterator.hxx>
 # include <APIHeaderSection_MakeHeader.hxx>
 # include <OSD_Exception.hxx>
+# include <Bnd_Box.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <BRepMesh_IncrementalMesh.hxx>
+# include <ShapeFix_Shape.hxx>
+# include <TopExp.hxx>
 #if OCC_VERSION_HEX >= 0x060500
 # include <TDataXtd_Shape.hxx>
 # else
@@ -64,6 +70,8 @@
 # endif
 #endif
 
+#include <QtConcurrentMap>
+
 #include "ImportOCAF.h"
 #include <Base/Console.h>
 #include <App/Application.h>
@@ -79,20 +87,44 @@ using namespace Import;
 
 
 ImportOCAF::ImportOCAF(Handle_TDocStd_Document h, App::Document* d, const std::string& name)
-    : pDoc(h), doc(d), default_name(name)
+    : pDoc(h), doc(d), default_name(name), myMeshDeviation(0.0)
 {
     aShapeTool = XCAFDoc_DocumentTool::ShapeTool (pDoc->Main());
     aColorTool = XCAFDoc_DocumentTool::ColorTool(pDoc->Main());
+
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Import");
+    myFixShapes = hGrp->GetBool("FixShapes", false);
 }
 
 ImportOCAF::~ImportOCAF()
 {
 }
 
+void ImportOCAF::setMeshDeviation(double dev)
+{
+    myMeshDeviation = dev;
+}
+
 void ImportOCAF::loadShapes()
 {
     myRefShapes.clear();
+    myPrototypes.clear();
+    myInstances.clear();
+    myColors.clear();
+    myColorMap.Clear();
+    myShapeMap.Clear();
+    myPrototypeMap.clear();
+
+    // collect the instances and their shared shapes first
     loadShapes(pDoc->Main(), TopLoc_Location(), default_name, "", false);
+
+    // fix and tessellate every shape once, independent of the number of instances
+    if (myFixShapes || myMeshDeviation > 0.0) {
+        QtConcurrent::blockingMap(myPrototypes, &ImportOCAF::prepareShape);
+    }
+
+    createObjects();
 }
 
 void ImportOCAF::loadShapes(const TDF_Label& label, const TopLoc_Location& loc, const std::string& defaultname, const std::string& assembly, bool isRef)
@@ -202,12 +234,60 @@ void ImportOCAF::createShape(const TDF_Label& label, const TopLoc_Location& loc,
 
 void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location& loc, const std::string& name)
 {
-    Part::Feature* part = static_cast<Part::Feature*>(doc->addObject("Part::Feature"));
-    if (!loc.IsIdentity())
-        part->Shape.setValue(aShape.Moved(loc));
-    else
-        part->Shape.setValue(aShape);
-    part->Label.setValue(name);
+    // the location of the shape itself, e.g. of a solid in a compound, moves to the instance
+    Instance inst;
+    inst.prototype = findPrototype(aShape);
+    inst.reversed = (aShape.Orientation() != myPrototypes[inst.prototype].shape.Orientation());
+    inst.loc = loc * aShape.Location();
+    inst.name = name;
+    myInstances.push_back(inst);
+    myPrototypes[inst.prototype].locations.push_back(inst.loc);
+}
+
+int ImportOCAF::findPrototype(const TopoDS_Shape& aShape)
+{
+    // Instances of the same part share the shape and its colors. The colors
+    // are looked up for the shape at its location in the part, e.g. a solid
+    // in a compound, since the copies of a TShape may differ in color. The
+    // maps compare TShape and location, hence the shape key has no location.
+    int colors = findColors(aShape);
+    TopoDS_Shape key = aShape.Located(TopLoc_Location());
+    int shape;
+    if (myShapeMap.IsBound(key)) {
+        shape = myShapeMap.Find(key);
+    }
+    else {
+        shape = myShapeMap.Extent();
+        myShapeMap.Bind(key, shape);
+    }
+
+    std::pair<int,int> id(shape, colors);
+    std::map<std::pair<int,int>, int>::iterator it = myPrototypeMap.find(id);
+    if (it != myPrototypeMap.end())
+        return it->second;
+
+    const ShapeColors& shapeColors = myColors[colors];
+    Prototype proto;
+    proto.shape = key;
+    proto.fix = myFixShapes;
+    proto.deviation = myMeshDeviation;
+    proto.hasColor = shapeColors.hasColor;
+    proto.color = shapeColors.color;
+    proto.faceColors = shapeColors.faceColors;
+
+    int index = (int)myPrototypes.size();
+    myPrototypes.push_back(proto);
+    myPrototypeMap[id] = index;
+    return index;
+}
+
+int ImportOCAF::findColors(const TopoDS_Shape& aShape)
+{
+    if (myColorMap.IsBound(aShape))
+        return myColorMap.Find(aShape);
+
+    ShapeColors colors;
+    colors.hasColor = false;
 
     Quantity_Color aColor;
     App::Color color(0.8f,0.8f,0.8f);
@@ -217,19 +297,9 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
         color.r = (float)aColor.Red();
         color.g = (float)aColor.Green();
         color.b = (float)aColor.Blue();
-        std::vector<App::Color> colors;
-        colors.push_back(color);
-        applyColors(part, colors);
-#if 0//TODO
-        Gui::ViewProvider* vp = Gui::Application::Instance->getViewProvider(part);
-        if (vp && vp->isDerivedFrom(PartGui::ViewProviderPart::getClassTypeId())) {
-            color.r = aColor.Red();
-            color.g = aColor.Green();
-            color.b = aColor.Blue();
-            static_cast<PartGui::ViewProviderPart*>(vp)->ShapeColor.setValue(color);
-        }
-#endif
+        colors.hasColor = true;
     }
+    colors.color = color;
 
     TopTools_IndexedMapOfShape faces;
     TopExp_Explorer xp(aShape,TopAbs_FACE);
@@ -254,15 +324,103 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
         }
         xp.Next();
     }
+    if (found_face_color)
+        colors.faceColors.swap(faceColors);
 
-    if (found_face_color) {
-        applyColors(part, faceColors);
-#if 0//TODO
-        Gui::ViewProvider* vp = Gui::Application::Instance->getViewProvider(part);
-        if (vp && vp->isDerivedFrom(PartGui::ViewProviderPartExt::getClassTypeId())) {
-            static_cast<PartGui::ViewProviderPartExt*>(vp)->DiffuseColor.setValues(faceColors);
+    int index = (int)myColors.size();
+    myColors.push_back(colors);
+    myColorMap.Bind(aShape, index);
+    return index;
+}
+
+void ImportOCAF::prepareShape(Prototype& proto)
+{
+    try {
+        // Fixing and meshing modify the shape in place and prototypes may share
+        // sub-shapes, e.g. the solids of a compound, hence each job has its own
+        // copy. The copy keeps the order of the faces and thus the face colors.
+        TopAbs_Orientation orient = proto.shape.Orientation();
+        proto.shape = BRepBuilderAPI_Copy(proto.shape).Shape();
+        proto.shape.Orientation(orient);
+
+        if (proto.fix) {
+            ShapeFix_Shape fix(proto.shape);
+            fix.Perform();
+            proto.shape = fix.Shape();
+
+            // the face colors are lost if fixing changed the faces
+            if (!proto.faceColors.empty()) {
+                TopTools_IndexedMapOfShape faces;
+                TopExp::MapShapes(proto.shape, TopAbs_FACE, faces);
+                if (faces.Extent() != (int)proto.faceColors.size())
+                    proto.faceColors.clear();
+            }
         }
+
+        if (proto.deviation > 0.0) {
+            // The part view provider computes the deflection from the bounding
+            // box of the placed shape and re-uses a triangulation that is at
+            // least as fine, so the smallest deflection of all instances is used
+            Standard_Real deflection = -1.0;
+            for (std::vector<TopLoc_Location>::const_iterator it = proto.locations.begin(); it != proto.locations.end(); ++it) {
+                Bnd_Box bounds;
+                BRepBndLib::Add(proto.shape.Moved(*it), bounds);
+                bounds.SetGap(0.0);
+                Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+                bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+                Standard_Real value = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
+                    proto.deviation;
+                if (deflection < 0.0 || value < deflection)
+                    deflection = value;
+            }
+            if (deflection > 0.0) {
+#if OCC_VERSION_HEX >= 0x060600
+                BRepMesh_IncrementalMesh mesh(proto.shape,deflection,Standard_False,0.5,Standard_False);
+#else
+                BRepMesh_IncrementalMesh mesh(proto.shape,deflection);
 #endif
+            }
+        }
+    }
+    catch (Standard_Failure) {
+        // keep the shape as it is
+    }
+}
+
+void ImportOCAF::createObjects()
+{
+    std::vector<std::pair<Part::Feature*, int> > colored;
+    {
+        // the views of the shapes are updated once when the batch is closed
+        App::NotificationBatch batch(doc);
+        for (std::vector<Instance>::const_iterator it = myInstances.begin(); it != myInstances.end(); ++it) {
+            const Prototype& proto = myPrototypes[it->prototype];
+            TopoDS_Shape aShape = proto.shape;
+            if (it->reversed)
+                aShape.Reverse();
+
+            Part::Feature* part = static_cast<Part::Feature*>(doc->addObject("Part::Feature"));
+            if (!it->loc.IsIdentity())
+                part->Shape.setValue(aShape.Moved(it->loc));
+            else
+                part->Shape.setValue(aShape);
+            part->Label.setValue(it->name);
+
+            if (proto.hasColor || !proto.faceColors.empty())
+                colored.push_back(std::make_pair(part, it->prototype));
+        }
+    }
+
+    // face colors need the faces of the shown shape, so they are set afterwards
+    for (std::vector<std::pair<Part::Feature*, int> >::iterator it = colored.begin(); it != colored.end(); ++it) {
+        const Prototype& proto = myPrototypes[it->second];
+        if (proto.hasColor) {
+            std::vector<App::Color> colors;
+            colors.push_back(proto.color);
+            applyColors(it->first, colors);
+        }
+        if (!proto.faceColors.empty())
+            applyColors(it->first, proto.faceColors);
     }
 }
 
@@ -29,6 +29,8 @@
 #include <Handle_XCAFDoc_ShapeTool.hxx>
 #include <Quantity_Color.hxx>
 #include <TopoDS_Shape.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_DataMapOfShapeInteger.hxx>
 #include <climits>
 #include <string>
 #include <set>
@@ -55,11 +57,42 @@ public:
     ImportOCAF(Handle_TDocStd_Document h, App::Document* d, const std::string& name);
     virtual ~ImportOCAF();
     void loadShapes();
+    /** Tessellate the imported shapes with the given deviation, as done by the
+     * part view provider. By default (0) no tessellation is done.
+     */
+    void setMeshDeviation(double);
 
 private:
+    /// the colors of a shape, looked up once for all its instances
+    struct ShapeColors {
+        bool hasColor;
+        App::Color color;
+        std::vector<App::Color> faceColors;
+    };
+    /// a shape shared by all its instances in the assembly, without location
+    struct Prototype {
+        TopoDS_Shape shape;
+        std::vector<TopLoc_Location> locations; /**< of the instances */
+        bool fix;
+        double deviation;
+        bool hasColor;
+        App::Color color;
+        std::vector<App::Color> faceColors;
+    };
+    struct Instance {
+        int prototype;
+        bool reversed;
+        TopLoc_Location loc;
+        std::string name;
+    };
+
     void loadShapes(const TDF_Label& label, const TopLoc_Location&, const std::string& partname, const std::string& assembly, bool isRef);
     void createShape(const TDF_Label& label, const TopLoc_Location&, const std::string&);
     void createShape(const TopoDS_Shape& label, const TopLoc_Location&, const std::string&);
+    int findPrototype(const TopoDS_Shape&);
+    int findColors(const TopoDS_Shape&);
+    static void prepareShape(Prototype&);
+    void createObjects();
     virtual void applyColors(Part::Feature*, const std::vector<App::Color>&){}
 
 private:
@@ -69,6 +102,14 @@ private:
     Handle_XCAFDoc_ColorTool aColorTool;
     std::string default_name;
     std::set<int> myRefShapes;
+    std::vector<Prototype> myPrototypes;
+    std::vector<Instance> myInstances;
+    std::vector<ShapeColors> myColors;
+    TopTools_DataMapOfShapeInteger myColorMap;
+    TopTools_DataMapOfShapeInteger myShapeMap;
+    std::map<std::pair<int,int>, int> myPrototypeMap;
+    bool myFixShapes;
+    double myMeshDeviation;
     static const int HashUpper = INT_MAX;
 };
 
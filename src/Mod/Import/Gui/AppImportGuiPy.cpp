@@ -87,6 +87,10 @@ public:
     ImportOCAFExt(Handle_TDocStd_Document h, App::Document* d, const std::string& name)
         : ImportOCAF(h, d, name)
     {
+        // prepare the tessellation for the part view providers
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part");
+        setMeshDeviation(hGrp->GetFloat("MeshDeviation",0.2));
     }
 
 private:
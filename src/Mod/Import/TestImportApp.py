@@ -0,0 +1,173 @@
+#   (c) The FreeCAD developers 2014                            LGPL        *
+#                                                                         *
+#   This file is part of the FreeCAD CAx development system.              *
+#                                                                         *
+#   This program is free software; you can redistribute it and/or modify  *
+#   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#   as published by the Free Software Foundation; either version 2 of     *
+#   the License, or (at your option) any later version.                   *
+#   for detail see the LICENCE text file.                                 *
+#                                                                         *
+#   FreeCAD is distributed in the hope that it will be useful,            *
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#   GNU Library General Public License for more details.                  *
+#                                                                         *
+#   You should have received a copy of the GNU Library General Public     *
+#   License along with FreeCAD; if not, write to the Free Software        *
+#   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#   USA                                                                   *
+#**************************************************************************
+
+import FreeCAD, unittest, os, tempfile, Import
+
+#---------------------------------------------------------------------------
+# define the test cases to test the FreeCAD Import module
+#---------------------------------------------------------------------------
+
+
+class StepWriter:
+	"""Writes a STEP assembly with two instances of a red box"""
+	def __init__(self):
+		self.entities = []
+
+	def add(self, text):
+		self.entities.append(text)
+		return "#%d" % len(self.entities)
+
+	def real(self, value):
+		return "%.6f" % value
+
+	def point(self, p):
+		return self.add("CARTESIAN_POINT('',(%s))" % ",".join([self.real(v) for v in p]))
+
+	def direction(self, d):
+		return self.add("DIRECTION('',(%s))" % ",".join([self.real(v) for v in d]))
+
+	def axis(self, origin, normal=(0,0,1), ref=(1,0,0)):
+		return self.add("AXIS2_PLACEMENT_3D('',%s,%s,%s)" % (self.point(origin), self.direction(normal), self.direction(ref)))
+
+	def box(self, size):
+		pts = [((i & 1) * size, ((i >> 1) & 1) * size, ((i >> 2) & 1) * size) for i in range(8)]
+		vertexes = [self.add("VERTEX_POINT('',%s)" % self.point(p)) for p in pts]
+		# the loops are counter-clockwise seen from outside
+		loops = [(0,2,3,1), (4,5,7,6), (0,1,5,4), (2,6,7,3), (0,4,6,2), (1,3,7,5)]
+		edges = {}
+		faces = []
+		for loop in loops:
+			oriented = []
+			for i in range(4):
+				a, b = loop[i], loop[(i + 1) % 4]
+				key = (min(a, b), max(a, b))
+				if not edges.has_key(key):
+					d = [(q - p) / size for p, q in zip(pts[key[0]], pts[key[1]])]
+					line = self.add("LINE('',%s,%s)" % (self.point(pts[key[0]]),
+						self.add("VECTOR('',%s,%s)" % (self.direction(d), self.real(size)))))
+					edges[key] = self.add("EDGE_CURVE('',%s,%s,%s,.T.)" % (vertexes[key[0]], vertexes[key[1]], line))
+				oriented.append(self.add("ORIENTED_EDGE('',*,*,%s,%s)" % (edges[key], a < b and ".T." or ".F.")))
+			p0, p1, p2 = pts[loop[0]], pts[loop[1]], pts[loop[2]]
+			u = [(q - p) / size for p, q in zip(p0, p1)]
+			v = [(q - p) / size for p, q in zip(p1, p2)]
+			n = (u[1]*v[2] - u[2]*v[1], u[2]*v[0] - u[0]*v[2], u[0]*v[1] - u[1]*v[0])
+			plane = self.add("PLANE('',%s)" % self.axis(p0, n, u))
+			bound = self.add("FACE_OUTER_BOUND('',%s,.T.)" % self.add("EDGE_LOOP('',(%s))" % ",".join(oriented)))
+			faces.append(self.add("ADVANCED_FACE('',(%s),%s,.T.)" % (bound, plane)))
+		return self.add("MANIFOLD_SOLID_BREP('Box',%s)" % self.add("CLOSED_SHELL('',(%s))" % ",".join(faces)))
+
+	def product(self, name, app, context, pdc):
+		prod = self.add("PRODUCT('%s','%s','',(%s))" % (name, name, context))
+		self.add("PRODUCT_RELATED_PRODUCT_CATEGORY('part',$,(%s))" % prod)
+		pdf = self.add("PRODUCT_DEFINITION_FORMATION('','',%s)" % prod)
+		return self.add("PRODUCT_DEFINITION('design','',%s,%s)" % (pdf, pdc))
+
+	def write(self, fileName, offsets, size=10.0):
+		app = self.add("APPLICATION_CONTEXT('core data for automotive mechanical design processes')")
+		self.add("APPLICATION_PROTOCOL_DEFINITION('international standard','automotive_design',2000,%s)" % app)
+		context = self.add("PRODUCT_CONTEXT('',%s,'mechanical')" % app)
+		pdc = self.add("PRODUCT_DEFINITION_CONTEXT('part definition',%s,'design')" % app)
+		mm = self.add("( LENGTH_UNIT() NAMED_UNIT(*) SI_UNIT(.MILLI.,.METRE.) )")
+		rad = self.add("( NAMED_UNIT(*) PLANE_ANGLE_UNIT() SI_UNIT($,.RADIAN.) )")
+		sr = self.add("( NAMED_UNIT(*) SI_UNIT($,.STERADIAN.) SOLID_ANGLE_UNIT() )")
+		unc = self.add("UNCERTAINTY_MEASURE_WITH_UNIT(LENGTH_MEASURE(1.E-07),%s,'distance_accuracy_value','confusion accuracy')" % mm)
+		ctx = self.add("( GEOMETRIC_REPRESENTATION_CONTEXT(3) GLOBAL_UNCERTAINTY_ASSIGNED_CONTEXT((%s)) "
+			"GLOBAL_UNIT_ASSIGNED_CONTEXT((%s,%s,%s)) REPRESENTATION_CONTEXT('','') )" % (unc, mm, rad, sr))
+
+		# the part
+		part = self.product("Box", app, context, pdc)
+		partOrigin = self.axis((0,0,0))
+		brep = self.box(size)
+		partRep = self.add("ADVANCED_BREP_SHAPE_REPRESENTATION('',(%s,%s),%s)" % (partOrigin, brep, ctx))
+		self.add("SHAPE_DEFINITION_REPRESENTATION(%s,%s)" % (self.add("PRODUCT_DEFINITION_SHAPE('','',%s)" % part), partRep))
+		color = self.add("COLOUR_RGB('',1.,0.,0.)")
+		style = self.add("FILL_AREA_STYLE('',(%s))" % self.add("FILL_AREA_STYLE_COLOUR('',%s)" % color))
+		style = self.add("SURFACE_SIDE_STYLE('',(%s))" % self.add("SURFACE_STYLE_FILL_AREA(%s)" % style))
+		style = self.add("PRESENTATION_STYLE_ASSIGNMENT((%s))" % self.add("SURFACE_STYLE_USAGE(.BOTH.,%s)" % style))
+		styled = self.add("STYLED_ITEM('color',(%s),%s)" % (style, brep))
+		self.add("MECHANICAL_DESIGN_GEOMETRIC_PRESENTATION_REPRESENTATION('',(%s),%s)" % (styled, ctx))
+
+		# the assembly with the instances of the part
+		asm = self.product("Assembly", app, context, pdc)
+		placements = [self.axis(offset) for offset in offsets]
+		asmRep = self.add("SHAPE_REPRESENTATION('',(%s,%s),%s)" % (self.axis((0,0,0)), ",".join(placements), ctx))
+		self.add("SHAPE_DEFINITION_REPRESENTATION(%s,%s)" % (self.add("PRODUCT_DEFINITION_SHAPE('','',%s)" % asm), asmRep))
+		for i, placement in enumerate(placements):
+			nauo = self.add("NEXT_ASSEMBLY_USAGE_OCCURRENCE('%d','Box %d','',%s,%s,$)" % (i + 1, i + 1, asm, part))
+			pds = self.add("PRODUCT_DEFINITION_SHAPE('Placement','Placement of an item',%s)" % nauo)
+			trsf = self.add("ITEM_DEFINED_TRANSFORMATION('','',%s,%s)" % (partOrigin, placement))
+			rel = self.add("( REPRESENTATION_RELATIONSHIP('','',%s,%s) REPRESENTATION_RELATIONSHIP_WITH_TRANSFORMATION(%s) "
+				"SHAPE_REPRESENTATION_RELATIONSHIP() )" % (partRep, asmRep, trsf))
+			self.add("CONTEXT_DEPENDENT_SHAPE_REPRESENTATION(%s,%s)" % (rel, pds))
+
+		f = open(fileName, "w")
+		f.write("ISO-10303-21;\nHEADER;\n")
+		f.write("FILE_DESCRIPTION(('FreeCAD Model'),'2;1');\n")
+		f.write("FILE_NAME('%s','2014-01-01T00:00:00',('FreeCAD'),('FreeCAD'),'','FreeCAD','Unknown');\n" % os.path.basename(fileName))
+		f.write("FILE_SCHEMA(('AUTOMOTIVE_DESIGN { 1 0 10303 214 1 1 1 1 }'));\nENDSEC;\nDATA;\n")
+		for i, text in enumerate(self.entities):
+			f.write("#%d=%s;\n" % (i + 1, text))
+		f.write("ENDSEC;\nEND-ISO-10303-21;\n")
+		f.close()
+
+
+class ImportStepInstancesTestCases(unittest.TestCase):
+	def setUp(self):
+		self.offsets = [(0,0,0), (20,0,0), (0,20,0)]
+		self.fileName = os.path.join(tempfile.gettempdir(), "ImportInstances.step")
+		StepWriter().write(self.fileName, self.offsets)
+		self.doc = FreeCAD.newDocument("ImportInstances")
+
+	def features(self):
+		return [obj for obj in self.doc.Objects if obj.isDerivedFrom("Part::Feature")]
+
+	def checkInstances(self):
+		parts = self.features()
+		self.failUnless(len(parts) == len(self.offsets))
+		# all instances share the shape of the part at their own location
+		for part in parts[1:]:
+			self.failUnless(part.Shape.isPartner(parts[0].Shape))
+			self.failUnless(not part.Shape.isSame(parts[0].Shape))
+		origins = [(part.Shape.BoundBox.XMin, part.Shape.BoundBox.YMin, part.Shape.BoundBox.ZMin) for part in parts]
+		for offset in self.offsets:
+			self.failUnless(len([o for o in origins if FreeCAD.Vector(o).sub(FreeCAD.Vector(offset)).Length < 1e-6]) == 1)
+		for part in parts:
+			self.failUnless(abs(part.Shape.Volume - 1000.0) < 1e-6)
+		return parts
+
+	def testSharedShapes(self):
+		Import.insert(self.fileName, self.doc.Name)
+		self.checkInstances()
+
+	def testColors(self):
+		if not FreeCAD.GuiUp:
+			return
+		import ImportGui
+		ImportGui.insert(self.fileName, self.doc.Name)
+		for part in self.checkInstances():
+			colors = part.ViewObject.DiffuseColor
+			self.failUnless(len(colors) > 0)
+			for color in colors:
+				self.failUnless(abs(color[0] - 1.0) < 1e-3 and color[1] < 1e-3 and color[2] < 1e-3)
+
+	def tearDown(self):
+		FreeCAD.closeDocument(self.doc.Name)
+		os.remove(self.fileName)
@@ -705,6 +705,8 @@ App::DocumentObjectExecReturn* Feature::execute(void)
     QFutureWatcher<float> watcher;
     QObject::connect(&watcher, SIGNAL(progressValueChanged(int)),
                      &progress, SLOT(progressValueChanged(int)));
+    QObject::connect(&progress, SIGNAL(canceled()),
+                     &watcher, SLOT(cancel()));
     watcher.setFuture(future);
 
     // keep it responsive during computation
@@ -25,13 +25,20 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <deque>
 #endif
 
+#include <QtConcurrentMap>
+#include <boost/bind.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Elements.h"
 #include "Iterator.h"
 #include "Grid.h"
+#include "Slicer.h"
 #include "Triangulation.h"
 
 #include <Base/Console.h>
@@ -1451,6 +1458,241 @@ bool MeshAlgorithm::CutWithPlane (const Base::Vector3f &clBase, const Base::Vect
   return ConnectLines(clTempPoly, rclResult, fMinEps);
 }
 
+namespace MeshCore {
+namespace CutPlanes {
+
+struct Plane {
+    Base::Vector3f normal;
+    float dist;
+    std::size_t index;
+};
+
+inline bool sameNormal(const Plane& p, const Plane& q)
+{
+    return p.normal.x == q.normal.x && p.normal.y == q.normal.y && p.normal.z == q.normal.z;
+}
+
+struct PlaneLess {
+    bool operator()(const Plane& p, const Plane& q) const
+    {
+        if (p.normal.x != q.normal.x)
+            return p.normal.x < q.normal.x;
+        if (p.normal.y != q.normal.y)
+            return p.normal.y < q.normal.y;
+        if (p.normal.z != q.normal.z)
+            return p.normal.z < q.normal.z;
+        return p.dist < q.dist;
+    }
+};
+
+struct Cell {
+    double x, y, z;
+    bool operator==(const Cell& c) const
+    { return x == c.x && y == c.y && z == c.z; }
+};
+
+struct CellHash {
+    std::size_t operator()(const Cell& c) const
+    {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, c.x);
+        boost::hash_combine(seed, c.y);
+        boost::hash_combine(seed, c.z);
+        return seed;
+    }
+};
+
+/**
+ * Hash of the end points of line segments over cells of the size of the search radius.
+ * The end point 2*i is the first point of the i-th segment, 2*i+1 the second one.
+ */
+class EndPointHash
+{
+public:
+    EndPointHash(const std::vector<std::pair<Base::Vector3f, Base::Vector3f> >& lines, float size)
+      : _lines(lines), _size(size > 0.0f ? size : 1.0)
+    {
+    }
+    void Insert(unsigned long ulEnd)
+    {
+        _map.insert(std::make_pair(GetCell(GetPoint(ulEnd)), ulEnd));
+    }
+    const Base::Vector3f& GetPoint(unsigned long ulEnd) const
+    {
+        return (ulEnd % 2 == 0) ? _lines[ulEnd / 2].first : _lines[ulEnd / 2].second;
+    }
+    /// nearest end point of an unused segment closer than sqrt(fMaxDist2), or -1
+    long FindNearest(const Base::Vector3f& rclPt, float fMaxDist2, const std::vector<bool>& used) const
+    {
+        long nearest = -1;
+        Cell c = GetCell(rclPt);
+        for (int i = -1; i <= 1; i++) {
+            for (int j = -1; j <= 1; j++) {
+                for (int k = -1; k <= 1; k++) {
+                    Cell n = { c.x + i, c.y + j, c.z + k };
+                    std::pair<TMap::const_iterator, TMap::const_iterator> range = _map.equal_range(n);
+                    for (TMap::const_iterator it = range.first; it != range.second; ++it) {
+                        if (used[it->second / 2])
+                            continue;
+                        float fDist2 = Base::DistanceP2(rclPt, GetPoint(it->second));
+                        if (fDist2 < fMaxDist2) {
+                            fMaxDist2 = fDist2;
+                            nearest = (long)it->second;
+                        }
+                    }
+                }
+            }
+        }
+        return nearest;
+    }
+
+private:
+    Cell GetCell(const Base::Vector3f& rclPt) const
+    {
+        Cell c = { floor(rclPt.x / _size), floor(rclPt.y / _size), floor(rclPt.z / _size) };
+        return c;
+    }
+
+    typedef boost::unordered_multimap<Cell, unsigned long, CellHash> TMap;
+    const std::vector<std::pair<Base::Vector3f, Base::Vector3f> >& _lines;
+    double _size;
+    TMap _map;
+};
+
+} // namespace CutPlanes
+} // namespace MeshCore
+
+/// a plane of CutWithPlanes without parallel ones
+struct MeshAlgorithm::SinglePlane {
+    const MeshFacetGrid* grid;
+    CutPlanes::Plane plane;
+    float eps;
+    std::list<std::vector<Base::Vector3f> >* result;
+};
+
+void MeshAlgorithm::CutWithPlanes (const std::vector<std::pair<Base::Vector3f, Base::Vector3f> > &rclPlanes, const MeshFacetGrid &rclGrid,
+                                   std::vector<std::list<std::vector<Base::Vector3f> > > &rclResult, float fMinEps) const
+{
+    rclResult.clear();
+    rclResult.resize(rclPlanes.size());
+
+    // normalized planes, sorted to get the parallel ones in a row
+    std::vector<CutPlanes::Plane> planes;
+    planes.reserve(rclPlanes.size());
+    for (std::size_t i = 0; i < rclPlanes.size(); i++) {
+        CutPlanes::Plane plane;
+        plane.normal = rclPlanes[i].second;
+        if (plane.normal.Length() == 0.0f)
+            continue;
+        plane.normal.Normalize();
+        plane.dist = plane.normal * rclPlanes[i].first;
+        plane.index = i;
+        planes.push_back(plane);
+    }
+    std::sort(planes.begin(), planes.end(), CutPlanes::PlaneLess());
+
+    MeshSlicer slicer(_rclMesh);
+    std::vector<SinglePlane> singles;
+    for (std::size_t first = 0; first < planes.size(); ) {
+        std::size_t last = first + 1;
+        while (last < planes.size() && CutPlanes::sameNormal(planes[first], planes[last]))
+            last++;
+
+        if (last - first > 1) {
+            // a group of parallel planes is sliced in one sweep over the facets
+            std::vector<float> dist;
+            dist.reserve(last - first);
+            for (std::size_t i = first; i < last; i++)
+                dist.push_back(planes[i].dist);
+            std::vector<MeshSlicer::TPolylines> sections;
+            slicer.Slice(planes[first].normal, dist, sections);
+            for (std::size_t i = first; i < last; i++)
+                rclResult[planes[i].index].swap(sections[i - first]);
+        }
+        else {
+            SinglePlane single;
+            single.grid = &rclGrid;
+            single.plane = planes[first];
+            single.eps = fMinEps;
+            single.result = &rclResult[planes[first].index];
+            singles.push_back(single);
+        }
+        first = last;
+    }
+
+    QtConcurrent::blockingMap(singles, boost::bind(&MeshAlgorithm::CutWithSinglePlane, this, _1));
+}
+
+void MeshAlgorithm::CutWithSinglePlane (SinglePlane &rclPlane) const
+{
+    const CutPlanes::Plane& plane = rclPlane.plane;
+    Base::Vector3f clBase = plane.normal * plane.dist;
+
+    // collect the facets of all grid cells cut by the plane, as CutWithPlane does
+    std::vector<unsigned long> aulFacets;
+    MeshGridIterator clGridIter(*rclPlane.grid);
+    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
+        if (clGridIter.GetBoundBox().IsCutPlane(clBase, plane.normal) == true)
+            clGridIter.GetElements(aulFacets);
+    }
+    std::sort(aulFacets.begin(), aulFacets.end());
+    aulFacets.erase(std::unique(aulFacets.begin(), aulFacets.end()), aulFacets.end());
+
+    std::vector<std::pair<Base::Vector3f, Base::Vector3f> > lines;
+    for (std::vector<unsigned long>::iterator it = aulFacets.begin(); it != aulFacets.end(); ++it) {
+        Base::Vector3f clE1, clE2;
+        const MeshGeomFacet clF(_rclMesh.GetFacet(*it));
+        if (clF.IntersectWithPlane(clBase, plane.normal, clE1, clE2) == true)
+            lines.push_back(std::make_pair(clE1, clE2));
+    }
+
+    ConnectSegments(lines, *rclPlane.result, rclPlane.eps);
+}
+
+void MeshAlgorithm::ConnectSegments (const std::vector<std::pair<Base::Vector3f, Base::Vector3f> > &rclLines,
+                                     std::list<std::vector<Base::Vector3f> > &rclPolylines, float fMinEps) const
+{
+    float fMinEps2 = fMinEps * fMinEps;
+
+    // like ConnectLines ignore all lines shorter than epsilon
+    std::vector<bool> used(rclLines.size(), true);
+    CutPlanes::EndPointHash endPoints(rclLines, fMinEps);
+    for (std::size_t i = 0; i < rclLines.size(); i++) {
+        if (Base::DistanceP2(rclLines[i].first, rclLines[i].second) >= fMinEps2 / 10.0f) {
+            used[i] = false;
+            endPoints.Insert(2 * i);
+            endPoints.Insert(2 * i + 1);
+        }
+    }
+
+    for (std::size_t i = 0; i < rclLines.size(); i++) {
+        if (used[i])
+            continue;
+        used[i] = true;
+
+        // extend the polyline at its end and then at its front
+        std::deque<Base::Vector3f> clPoly;
+        clPoly.push_back(rclLines[i].first);
+        clPoly.push_back(rclLines[i].second);
+        for (int side = 0; side < 2; side++) {
+            long end;
+            while ((end = endPoints.FindNearest(side == 0 ? clPoly.back() : clPoly.front(), fMinEps2, used)) >= 0) {
+                used[end / 2] = true;
+                const Base::Vector3f& clNext = endPoints.GetPoint(end % 2 == 0 ? end + 1 : end - 1);
+                if (side == 0)
+                    clPoly.push_back(clNext);
+                else
+                    clPoly.push_front(clNext);
+            }
+        }
+
+        // remove single segments with too few length
+        if (clPoly.size() == 2 && Base::DistanceP2(clPoly[0], clPoly[1]) <= fMinEps2)
+            continue;
+        rclPolylines.push_back(std::vector<Base::Vector3f>(clPoly.begin(), clPoly.end()));
+    }
+}
+
 bool MeshAlgorithm::ConnectLines (std::list<std::pair<Base::Vector3f, Base::Vector3f> > &rclLines,
                                   std::list<std::vector<Base::Vector3f> > &rclPolylines, float fMinEps) const
 {
@@ -279,6 +279,15 @@ public:
   /** Cuts the mesh with a plane. The result is a list of polylines. */
   bool CutWithPlane (const Base::Vector3f &clBase, const Base::Vector3f &clNormal, const MeshFacetGrid &rclGrid,
                      std::list<std::vector<Base::Vector3f> > &rclResult, float fMinEps = 1.0e-2f, bool bConnectPolygons = false) const;
+  /**
+   * Cuts the mesh with several planes, each given by a base point and a normal. \a rclResult
+   * holds the polylines of each plane in the order of the planes. Planes with the same normal
+   * are sliced together with MeshSlicer, which chains the segments over the facet neighbourhood
+   * and thus doesn't use \a fMinEps. The other planes collect their facets from the grid and are
+   * cut in parallel, their segments are connected with a hash over \a fMinEps cells.
+   */
+  void CutWithPlanes (const std::vector<std::pair<Base::Vector3f, Base::Vector3f> > &rclPlanes, const MeshFacetGrid &rclGrid,
+                      std::vector<std::list<std::vector<Base::Vector3f> > > &rclResult, float fMinEps = 1.0e-2f) const;
   /** 
    * Gets all facets that cut the plane (N,d) and that lie between the two points left and right. 
    * The plane is defined by it normalized normal and the signed distance to the origin.
@@ -302,6 +311,12 @@ protected:
                     float fMinEps) const;
   bool ConnectPolygons(std::list<std::vector<Base::Vector3f> > &clPolyList, std::list<std::pair<Base::Vector3f,
                        Base::Vector3f> > &rclLines) const;
+  /** Same as ConnectLines but uses a hash of the end points and thus runs in linear time. */
+  void ConnectSegments (const std::vector<std::pair<Base::Vector3f, Base::Vector3f> > &rclLines,
+                        std::list<std::vector<Base::Vector3f> > &rclPolylines, float fMinEps) const;
+  struct SinglePlane;
+  /** Cuts the mesh with a plane of CutWithPlanes that has no parallel partner. */
+  void CutWithSinglePlane (SinglePlane &rclPlane) const;
   /** Searches the nearest facet in \a raulFacets to the ray (\a rclPt, \a rclDir). */
   bool RayNearestField (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const std::vector<unsigned long> &raulFacets,
                         Base::Vector3f &rclRes, unsigned long &rulFacet, float fMaxAngle = F_PI) const;
@@ -26,7 +26,6 @@
 #endif
 
 #include <QFuture>
-#include <QFutureWatcher>
 #include <QtConcurrentMap>
 #include <boost/bind.hpp>
 
@@ -39,11 +38,22 @@
 #include "MeshKernel.h"
 #include "Iterator.h"
 #include "Tools.h"
+#include <Base/FutureWatcherProgress.h>
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 
 using namespace MeshCore;
 
+namespace MeshCore {
+static CurvatureInfo computeFacet(const FacetCurvature* face, Base::ConcurrentProgress* progress,
+                                  unsigned long index)
+{
+    CurvatureInfo info = face->Compute(index);
+    progress->add();
+    return info;
+}
+}
+
 MeshCurvature::MeshCurvature(const MeshKernel& kernel)
   : myKernel(kernel), myMinPoints(20), myRadius(0.5f)
 {
@@ -73,11 +83,10 @@ void MeshCurvature::ComputePerFace(bool parallel)
         }
     }
     else {
+        Base::ConcurrentProgress progress("Curvature estimation", mySegment.size());
         QFuture<CurvatureInfo> future = QtConcurrent::mapped
-            (mySegment, boost::bind(&FacetCurvature::Compute, &face, _1));
-        QFutureWatcher<CurvatureInfo> watcher;
-        watcher.setFuture(future);
-        watcher.waitForFinished();
+            (mySegment, boost::bind(&computeFacet, &face, &progress, _1));
+        Base::waitForFinished(future);
         for (QFuture<CurvatureInfo>::const_iterator it = future.begin(); it != future.end(); ++it) {
             myCurvature.push_back(*it);
         }
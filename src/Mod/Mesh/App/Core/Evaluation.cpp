@@ -41,8 +41,13 @@
 #include "TopoAlgorithm.h"
 #include <Base/Matrix.h>
 
+#include <Base/Exception.h>
+#include <Base/FutureWatcherProgress.h>
 #include <Base/Sequencer.h>
 
+#include <QAtomicInt>
+#include <QtConcurrentMap>
+
 using namespace MeshCore;
 
 
@@ -586,76 +591,119 @@ bool MeshFixSingleFacet::Fixup ()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate ()
+namespace MeshCore {
+// The facets of a grid cell that one thread checks for self-intersections
+struct SelfIntersectionCell {
+    std::vector<unsigned long> elements;
+    std::vector<std::pair<unsigned long, unsigned long> > pairs;
+    const MeshKernel* kernel;
+    const std::vector<Base::BoundBox3f>* boxes;
+    Base::ConcurrentProgress* progress;
+    QAtomicInt* found; // if set, all cells stop at the first self-intersection
+};
+}
+
+static void checkSelfIntersectionCell(SelfIntersectionCell& cell)
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
+    if (cell.progress->isCanceled() || (cell.found && (int)*cell.found != 0))
+        return;
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+    const MeshFacetArray& rFaces = cell.kernel->GetFacets();
+    const std::vector<Base::BoundBox3f>& boxes = *cell.boxes;
+    MeshGeomFacet facet1, facet2;
+    Base::Vector3f pt1, pt2;
+    for (std::vector<unsigned long>::iterator it = cell.elements.begin(); it != cell.elements.end(); ++it) {
+        const Base::BoundBox3f& box1 = boxes[*it];
+        facet1 = cell.kernel->GetFacet(*it);
+        const MeshFacet& rface1 = rFaces[*it];
+        for (std::vector<unsigned long>::iterator jt = it; jt != cell.elements.end(); ++jt) {
+            if (jt == it) // the identical facet
+                continue;
+            // If the facets share a common vertex we do not check for self-intersections because they 
+            // could but usually do not intersect each other and the algorithm below would detect false-positives,
+            // otherwise
+            const MeshFacet& rface2 = rFaces[*jt];
+            if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
+                rface1._aulPoints[0] == rface2._aulPoints[1] ||
+                rface1._aulPoints[0] == rface2._aulPoints[2])
+                continue; // ignore facets sharing a common vertex
+            if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
+                rface1._aulPoints[1] == rface2._aulPoints[1] ||
+                rface1._aulPoints[1] == rface2._aulPoints[2])
+                continue; // ignore facets sharing a common vertex
+            if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
+                rface1._aulPoints[2] == rface2._aulPoints[1] ||
+                rface1._aulPoints[2] == rface2._aulPoints[2])
+                continue; // ignore facets sharing a common vertex
+
+            const Base::BoundBox3f& box2 = boxes[*jt];
+            if (box1 && box2) {
+                facet2 = cell.kernel->GetFacet(*jt);
+                int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
+                if (ret == 2) {
+                    cell.pairs.push_back(std::make_pair(*it,*jt));
+                    if (cell.found) {
+                        cell.found->fetchAndStoreRelaxed(1);
+                        cell.progress->add();
+                        return;
+                    }
+                }
+            }
+        }
+    }
 
-    MeshFacetIterator cMFI(_rclMesh);
+    cell.progress->add();
+}
+
+// Checks the facets of the grid cells concurrently, the pairs are returned in the order of the cells
+static void checkSelfIntersections(const MeshKernel& kernel, QAtomicInt* found,
+                                   std::vector<std::pair<unsigned long, unsigned long> >& intersection)
+{
+    // Contains bounding boxes for every facet 
+    std::vector<Base::BoundBox3f> boxes;
+    boxes.reserve(kernel.CountFacets());
+    MeshFacetIterator cMFI(kernel);
     for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
         boxes.push_back((*cMFI).GetBoundBox());
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
+    // Splits the mesh using grid for speeding up the calculation
+    MeshFacetGrid cMeshFacetGrid(kernel);
+    MeshGridIterator clGridIter(cMeshFacetGrid);
+    std::vector<SelfIntersectionCell> cells;
     for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
         //Get the facet indices, belonging to the current grid unit
         std::vector<unsigned long> aulGridElements;
         clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.size()==0)
+        if (aulGridElements.size() < 2)
             continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
-                    }
-                }
-            }
-        }
+        cells.push_back(SelfIntersectionCell());
+        SelfIntersectionCell& cell = cells.back();
+        cell.elements.swap(aulGridElements);
+        cell.kernel = &kernel;
+        cell.boxes = &boxes;
+        cell.found = found;
     }
 
-    return true;
+    // Calculates the intersections
+    Base::ConcurrentProgress progress("Checking for self-intersections...", cells.size());
+    for (std::vector<SelfIntersectionCell>::iterator it = cells.begin(); it != cells.end(); ++it)
+        it->progress = &progress;
+    Base::waitForFinished(QtConcurrent::map(cells, checkSelfIntersectionCell));
+    if (progress.isCanceled())
+        throw Base::AbortException("Checking for self-intersections canceled");
+
+    for (std::vector<SelfIntersectionCell>::iterator it = cells.begin(); it != cells.end(); ++it)
+        intersection.insert(intersection.end(), it->pairs.begin(), it->pairs.end());
+}
+
+bool MeshEvalSelfIntersection::Evaluate ()
+{
+    // abort after the first detected self-intersection
+    QAtomicInt found(0);
+    std::vector<std::pair<unsigned long, unsigned long> > intersection;
+    checkSelfIntersections(_rclMesh, &found, intersection);
+    return intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsigned long, unsigned long> >& indices,
@@ -682,76 +730,11 @@ void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsi
     }
 }
 
-void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
+void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-    //intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for(cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.push_back(std::make_pair (*it,*jt));
-                    }
-                }
-            }
-        }
-    }
+    checkSelfIntersections(_rclMesh, 0, intersection);
 }
-
+
 std::vector<unsigned long> MeshFixSelfIntersection::GetFacets() const
 {
     std::vector<unsigned long> indices;
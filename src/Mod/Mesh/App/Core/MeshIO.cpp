@@ -28,6 +28,7 @@
 #include "MeshKernel.h"
 #include "MeshIO.h"
 #include "Builder.h"
+#include "NastranReader.h"
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
@@ -39,6 +40,8 @@
 #include <Base/Placement.h>
 #include <zipios++/gzipoutputstream.h>
 
+#include <algorithm>
+#include <climits>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
@@ -107,11 +110,6 @@ int numDigits(int number)
     return digits;
 }
 
-/* Usage by CMeshNastran, CMeshCadmouldFE. Added by Sergey Sukhov (26.04.2002)*/
-struct NODE {float x, y, z;};
-struct TRIA {int iV[3];};
-struct QUAD {int iV[4];};
-
 // --------------------------------------------------------------
 
 bool MeshInput::LoadAny(const char* FileName)
@@ -141,7 +139,9 @@ bool MeshInput::LoadAny(const char* FileName)
                 Base::Console().Warning("No usable mesh found in file '%s'", FileName);
         }
         else if (fi.hasExtension("nas") || fi.hasExtension("bdf")) {
-            ok = LoadNastran( str );
+            // the reader maps the file into memory itself
+            NastranReader reader;
+            ok = reader.readFile(fi.filePath()) && LoadNastran( reader );
         }
         else if (fi.hasExtension("obj")) {
             ok = LoadOBJ( str );
@@ -1103,111 +1103,131 @@ bool MeshInput::LoadNastran (std::istream &rstrIn)
     if ((!rstrIn) || (rstrIn.bad() == true))
         return false;
 
-    boost::regex rx_p("\\s*GRID\\s+([0-9]+)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*");
-    boost::regex rx_t("\\s*CTRIA3\\s+([0-9]+)\\s+([0-9]+)"
-                      "\\s+([0-9]+)\\s+([0-9]+)\\s+([0-9]+)\\s*");
-    boost::regex rx_q("\\s*CTRIA3\\s+([0-9]+)\\s+([0-9]+)"
-                      "\\s+([0-9]+)\\s+([0-9]+)\\s+([0-9]+)\\s+([0-9]+)\\s*");
-    boost::cmatch what;
+    std::ostringstream data;
+    data << rstrIn.rdbuf();
+    std::string buffer = data.str();
 
-    std::string line;
-    MeshFacet clMeshFacet;
-    MeshPointArray vVertices;
-    MeshFacetArray vTriangle;
+    NastranReader reader;
+    if (!reader.read(buffer.c_str(), buffer.size()))
+        return false;
+    return LoadNastran(reader);
+}
 
-    int index;
-    std::map <int, NODE> mNode;
-    std::map <int, TRIA> mTria;
-    std::map <int, QUAD> mQuad;
+namespace MeshCore {
+namespace Nastran {
+// Returns the index of the node with the given id or ULONG_MAX
+inline unsigned long findNode(const std::vector<int>& ids, int id)
+{
+    std::vector<int>::const_iterator it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id)
+        return ULONG_MAX;
+    return static_cast<unsigned long>(it - ids.begin());
+}
+}
+}
 
-    while (std::getline(rstrIn, line)) {
-        upper(ltrim(line));
-        if (line.find("GRID*") == 0) {
-            assert(0);
-        }
-        else if (line.find("*") == 0) {
-            assert(0);
-        }
-        // insert the read-in vertex into a map to preserve the order
-        else if (line.find("GRID") == 0) {
-            if (boost::regex_match(line.c_str(), what, rx_p)) {
-                index = std::atol(what[1].first)-1;
-                mNode[index].x = (float)std::atof(what[2].first);
-                mNode[index].y = (float)std::atof(what[5].first);
-                mNode[index].z = (float)std::atof(what[8].first);
-            }
-        }
-        // insert the read-in triangle into a map to preserve the order
-        else if (line.find("CTRIA3 ") == 0) {
-            if (boost::regex_match(line.c_str(), what, rx_t)) {
-                index = std::atol(what[1].first)-1;
-                mTria[index].iV[0] = std::atol(what[3].first)-1;
-                mTria[index].iV[1] = std::atol(what[4].first)-1;
-                mTria[index].iV[2] = std::atol(what[5].first)-1;
-            }
+/** Converts the surface elements of a Nastran deck. */
+bool MeshInput::LoadNastran (const NastranReader &rclReader)
+{
+    const std::vector<NastranReader::Node>& nodes = rclReader.getNodes();
+    const std::vector<NastranReader::Element>& elements = rclReader.getElements();
+    const std::vector<int>& grids = rclReader.getElementNodes();
+
+    // order the nodes by their ids, a later definition of an id wins
+    std::vector<std::pair<int, std::size_t> > nodeOrder;
+    nodeOrder.reserve(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); i++)
+        nodeOrder.push_back(std::make_pair(nodes[i].id, i));
+    std::sort(nodeOrder.begin(), nodeOrder.end());
+
+    std::vector<int> nodeIds;
+    MeshPointArray vVertices;
+    nodeIds.reserve(nodeOrder.size());
+    vVertices.reserve(nodeOrder.size());
+    for (std::vector<std::pair<int, std::size_t> >::iterator it = nodeOrder.begin(); it != nodeOrder.end(); ++it) {
+        const NastranReader::Node& node = nodes[it->second];
+        Base::Vector3f pnt((float)node.x, (float)node.y, (float)node.z);
+        if (!nodeIds.empty() && nodeIds.back() == it->first) {
+            vVertices.back() = pnt;
         }
-        // insert the read-in quadrangle into a map to preserve the order
-        else if (line.find("CQUAD4") == 0) {
-            if (boost::regex_match(line.c_str(), what, rx_q)) {
-                index = std::atol(what[1].first)-1;
-                mQuad[index].iV[0] = std::atol(what[3].first)-1;
-                mQuad[index].iV[1] = std::atol(what[4].first)-1;
-                mQuad[index].iV[2] = std::atol(what[5].first)-1;
-                mQuad[index].iV[3] = std::atol(what[6].first)-1;
-            }
+        else {
+            nodeIds.push_back(it->first);
+            vVertices.push_back(pnt);
         }
     }
 
-    float fLength[2];
-    if (mTria.empty())
-        index = 0;
-    else
-        index = mTria.rbegin()->first + 1;
-    for (std::map <int, QUAD>::iterator QI=mQuad.begin(); QI!=mQuad.end(); QI++) {
-        for (int i = 0; i < 2; i++) {
-            float fDx = mNode[(*QI).second.iV[i+2]].x - mNode[(*QI).second.iV[i]].x;
-            float fDy = mNode[(*QI).second.iV[i+2]].y - mNode[(*QI).second.iV[i]].y;
-            float fDz = mNode[(*QI).second.iV[i+2]].z - mNode[(*QI).second.iV[i]].z;
-            fLength[i] = fDx*fDx + fDy*fDy + fDz*fDz;
-        }
+    // triangles come first, then the split quadrangles, each ordered by id
+    std::vector<std::pair<int, std::size_t> > trias, quads;
+    for (std::size_t i = 0; i < elements.size(); i++) {
+        const NastranReader::Element& elem = elements[i];
+        if (elem.type == NastranReader::Tria3 || elem.type == NastranReader::Tria6)
+            trias.push_back(std::make_pair(elem.id, i));
+        else if (elem.type == NastranReader::Quad4 || elem.type == NastranReader::Quad8)
+            quads.push_back(std::make_pair(elem.id, i));
+    }
+    std::sort(trias.begin(), trias.end());
+    std::sort(quads.begin(), quads.end());
+
+    MeshFacet clMeshFacet;
+    MeshFacetArray vTriangle;
+    vTriangle.reserve(trias.size() + 2 * quads.size());
+
+    // Negative conversion for right orientation of normal-vectors.
+    unsigned long iV[4];
+    for (std::vector<std::pair<int, std::size_t> >::iterator it = trias.begin(); it != trias.end(); ++it) {
+        const NastranReader::Element& elem = elements[it->second];
+        bool valid = true;
+        for (int i = 0; i < 3; i++) {
+            iV[i] = Nastran::findNode(nodeIds, grids[elem.first + i]);
+            if (iV[i] == ULONG_MAX)
+                valid = false;
+        }
+        if (!valid)
+            continue;
+        clMeshFacet._aulPoints[0] = iV[1];
+        clMeshFacet._aulPoints[1] = iV[0];
+        clMeshFacet._aulPoints[2] = iV[2];
+        vTriangle.push_back(clMeshFacet);
+    }
+
+    // split the quadrangles along the shorter diagonal
+    for (std::vector<std::pair<int, std::size_t> >::iterator it = quads.begin(); it != quads.end(); ++it) {
+        const NastranReader::Element& elem = elements[it->second];
+        bool valid = true;
+        for (int i = 0; i < 4; i++) {
+            iV[i] = Nastran::findNode(nodeIds, grids[elem.first + i]);
+            if (iV[i] == ULONG_MAX)
+                valid = false;
+        }
+        if (!valid)
+            continue;
+
+        float fLength[2];
+        for (int i = 0; i < 2; i++)
+            fLength[i] = Base::DistanceP2(vVertices[iV[i+2]], vVertices[iV[i]]);
+
         if (fLength[0] < fLength[1]) {
-            mTria[index].iV[0] = (*QI).second.iV[0];
-            mTria[index].iV[1] = (*QI).second.iV[1];
-            mTria[index].iV[2] = (*QI).second.iV[2];
+            clMeshFacet._aulPoints[0] = iV[1];
+            clMeshFacet._aulPoints[1] = iV[0];
+            clMeshFacet._aulPoints[2] = iV[2];
+            vTriangle.push_back(clMeshFacet);
 
-            mTria[index+1].iV[0] = (*QI).second.iV[0];
-            mTria[index+1].iV[1] = (*QI).second.iV[2];
-            mTria[index+1].iV[2] = (*QI).second.iV[3];
+            clMeshFacet._aulPoints[0] = iV[2];
+            clMeshFacet._aulPoints[1] = iV[0];
+            clMeshFacet._aulPoints[2] = iV[3];
+            vTriangle.push_back(clMeshFacet);
         }
         else {
-            mTria[index].iV[0] = (*QI).second.iV[0];
-            mTria[index].iV[1] = (*QI).second.iV[1];
-            mTria[index].iV[2] = (*QI).second.iV[3];
+            clMeshFacet._aulPoints[0] = iV[1];
+            clMeshFacet._aulPoints[1] = iV[0];
+            clMeshFacet._aulPoints[2] = iV[3];
+            vTriangle.push_back(clMeshFacet);
 
-            mTria[index+1].iV[0] = (*QI).second.iV[1];
-            mTria[index+1].iV[1] = (*QI).second.iV[2];
-            mTria[index+1].iV[2] = (*QI).second.iV[3];
+            clMeshFacet._aulPoints[0] = iV[2];
+            clMeshFacet._aulPoints[1] = iV[1];
+            clMeshFacet._aulPoints[2] = iV[3];
+            vTriangle.push_back(clMeshFacet);
         }
-
-        index += 2;
-    }
-
-    // Applying the nodes
-    vVertices.reserve(mNode.size());
-    for (std::map<int, NODE>::iterator MI=mNode.begin(); MI!=mNode.end(); MI++) {
-        vVertices.push_back(Base::Vector3f(MI->second.x, MI->second.y, MI->second.z));
-    }
-
-    // Converting data to Mesh. Negative conversion for right orientation of normal-vectors.
-    vTriangle.reserve(mTria.size());
-    for (std::map<int, TRIA>::iterator MI=mTria.begin(); MI!=mTria.end(); MI++) {
-        clMeshFacet._aulPoints[0] = (*MI).second.iV[1];
-        clMeshFacet._aulPoints[1] = (*MI).second.iV[0];
-        clMeshFacet._aulPoints[2] = (*MI).second.iV[2];
-        vTriangle.push_back (clMeshFacet);
     }
 
     // make sure to add only vertices which are referenced by the triangles
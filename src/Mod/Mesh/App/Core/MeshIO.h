@@ -37,6 +37,7 @@ class Writer;
 namespace MeshCore {
 
 class MeshKernel;
+class NastranReader;
 
 namespace MeshIO {
     enum Format {
@@ -106,6 +107,8 @@ public:
     bool LoadInventor (std::istream &rstrIn);
     /** Loads a Nastran file. */
     bool LoadNastran (std::istream &rstrIn);
+    /** Loads the surface elements of a Nastran deck. */
+    bool LoadNastran (const NastranReader &rclReader);
     /** Loads a Cadmould FE file. */
     bool LoadCadmouldFE (std::ifstream &rstrIn);
 
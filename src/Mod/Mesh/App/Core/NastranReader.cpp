@@ -0,0 +1,424 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cctype>
+# include <cstdlib>
+# include <cstring>
+#endif
+
+#include <QFile>
+#include <QThread>
+#include <QtConcurrentMap>
+#include <boost/bind.hpp>
+
+#include "NastranReader.h"
+
+using namespace MeshCore;
+
+namespace MeshCore {
+namespace Nastran {
+
+typedef std::pair<const char*, const char*> Field;
+
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline Field trim(const char* begin, const char* end)
+{
+    while (begin < end && isBlank(*begin))
+        ++begin;
+    while (end > begin && isBlank(*(end-1)))
+        --end;
+    return Field(begin, end);
+}
+
+/// Copies a field into a null-terminated buffer
+inline void copyField(const Field& f, char* buf, std::size_t len)
+{
+    std::size_t n = std::min<std::size_t>(f.second - f.first, len - 1);
+    std::memcpy(buf, f.first, n);
+    buf[n] = '\0';
+}
+
+int toInt(const Field& f)
+{
+    char buf[32];
+    copyField(f, buf, sizeof(buf));
+    return std::atoi(buf);
+}
+
+/// Converts a Nastran real which may have an implicit exponent, e.g. 1.5-3 or 2.+4
+double toReal(const Field& f)
+{
+    char buf[40];
+    std::size_t n = std::min<std::size_t>(f.second - f.first, sizeof(buf) - 2);
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        char c = f.first[i];
+        if (c == 'D' || c == 'd')
+            c = 'E';
+        if ((c == '+' || c == '-') && j > 0 && buf[j-1] != 'E' && buf[j-1] != 'e')
+            buf[j++] = 'E';
+        buf[j++] = c;
+    }
+    buf[j] = '\0';
+    return std::atof(buf);
+}
+
+/// Returns the start of the next line or end
+inline const char* nextLine(const char* pos, const char* end)
+{
+    const char* eol = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    return eol ? eol + 1 : end;
+}
+
+/// Returns the first card, i.e. a line starting with a letter, at or after pos
+const char* findCard(const char* pos, const char* end)
+{
+    while (pos < end && !std::isalpha(static_cast<unsigned char>(*pos)))
+        pos = nextLine(pos, end);
+    return pos;
+}
+
+/// Holds the data fields of a card that may span several lines
+struct Card
+{
+    char name[9];
+    bool loose; // whitespace separated instead of column aligned
+    std::vector<Field> fields;
+
+    void clear()
+    {
+        name[0] = '\0';
+        loose = false;
+        fields.clear();
+    }
+
+    /** Adds the data fields of a line (fields 2-9) to the card. If 'first'
+     * is true the first field of the line holds the card name.
+     */
+    void addLine(const char* line, const char* eol, bool first)
+    {
+        const char* comma = static_cast<const char*>(std::memchr(line, ',', eol - line));
+        if (comma) {
+            // free field format
+            const char* pos = comma;
+            Field nameField = trim(line, comma);
+            if (first)
+                setName(nameField);
+            bool large = first ? (nameField.second > nameField.first && *(nameField.second - 1) == '*')
+                               : (*line == '*');
+            int count = large ? 4 : 8;
+            while (pos < eol && count-- > 0) {
+                const char* next = static_cast<const char*>(std::memchr(pos + 1, ',', eol - pos - 1));
+                if (!next)
+                    next = eol;
+                fields.push_back(trim(pos + 1, next));
+                pos = next;
+            }
+        }
+        else {
+            // fixed field format, the name field is always 8 characters wide
+            const char* data = std::min(line + 8, eol);
+            Field nameField = trim(line, data);
+            bool large = first ? (nameField.second > nameField.first && *(nameField.second - 1) == '*')
+                               : (*line == '*');
+            int width = large ? 16 : 8;
+            int count = large ? 4 : 8;
+
+            // some writers don't align the values to the columns but separate
+            // them by whitespace, which shows up as blanks inside of a field
+            if (first)
+                loose = hasBlank(nameField);
+            for (const char* pos = data; !loose && pos < eol; pos += width)
+                loose = hasBlank(trim(pos, std::min(pos + width, eol)));
+
+            if (loose) {
+                const char* pos = line;
+                while (pos < eol && isBlank(*pos))
+                    ++pos;
+                if (first) {
+                    nameField.first = pos;
+                    while (pos < eol && !isBlank(*pos))
+                        ++pos;
+                    nameField.second = pos;
+                }
+                else {
+                    pos = data;
+                }
+                while (count > 0) {
+                    while (pos < eol && isBlank(*pos))
+                        ++pos;
+                    if (pos >= eol)
+                        break;
+                    const char* next = pos;
+                    while (next < eol && !isBlank(*next))
+                        ++next;
+                    fields.push_back(Field(pos, next));
+                    pos = next;
+                    --count;
+                }
+            }
+            else {
+                for (const char* pos = data; pos < eol && count > 0; pos += width, --count)
+                    fields.push_back(trim(pos, std::min(pos + width, eol)));
+            }
+
+            if (first)
+                setName(nameField);
+        }
+    }
+
+    static bool hasBlank(const Field& f)
+    {
+        for (const char* c = f.first; c < f.second; ++c) {
+            if (isBlank(*c))
+                return true;
+        }
+        return false;
+    }
+
+    void setName(const Field& f)
+    {
+        std::size_t n = 0;
+        for (const char* c = f.first; c < f.second && *c != '*' && n < 8; ++c)
+            name[n++] = std::toupper(static_cast<unsigned char>(*c));
+        name[n] = '\0';
+    }
+
+    bool is(const char* card) const
+    {
+        return std::strcmp(name, card) == 0;
+    }
+
+    int intField(std::size_t i) const
+    {
+        return i < fields.size() ? toInt(fields[i]) : 0;
+    }
+
+    double realField(std::size_t i) const
+    {
+        return i < fields.size() ? toReal(fields[i]) : 0.0;
+    }
+};
+
+} // namespace Nastran
+} // namespace MeshCore
+
+// --------------------------------------------------------------
+
+NastranReader::NastranReader()
+{
+}
+
+NastranReader::~NastranReader()
+{
+}
+
+bool NastranReader::readFile(const std::string& fileName)
+{
+    QFile file(QString::fromUtf8(fileName.c_str()));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    if (file.size() == 0)
+        return read(0, 0);
+
+    // prefer a memory mapped file, if this fails the file is read into memory
+    uchar* data = file.map(0, file.size());
+    if (data) {
+        bool ok = read(reinterpret_cast<const char*>(data), static_cast<std::size_t>(file.size()));
+        file.unmap(data);
+        return ok;
+    }
+
+    QByteArray content = file.readAll();
+    return read(content.constData(), content.size());
+}
+
+bool NastranReader::read(const char* data, std::size_t size)
+{
+    nodes.clear();
+    elements.clear();
+    elementNodes.clear();
+
+    // split the input into chunks which all start with a new card so that
+    // no card is torn apart and parse them concurrently
+    const std::size_t minChunkSize = 1 << 20;
+    std::size_t numChunks = std::max<std::size_t>(1, std::min<std::size_t>
+        (size / minChunkSize, 4 * std::max(1, QThread::idealThreadCount())));
+
+    std::vector<Chunk> chunks;
+    const char* end = data + size;
+    const char* pos = data;
+    for (std::size_t i = 1; i <= numChunks && pos < end; i++) {
+        const char* next = end;
+        if (i < numChunks) {
+            next = std::max(pos, data + size / numChunks * i);
+            next = Nastran::findCard(Nastran::nextLine(next, end), end);
+        }
+        Chunk chunk;
+        chunk.begin = pos;
+        chunk.end = next;
+        chunks.push_back(chunk);
+        pos = next;
+    }
+
+    if (chunks.size() > 1) {
+        QtConcurrent::blockingMap(chunks,
+            boost::bind(&NastranReader::parseChunk, this, _1));
+    }
+    else if (!chunks.empty()) {
+        parseChunk(chunks.front());
+    }
+
+    // merge the chunks in order of the file
+    std::size_t countNodes = 0, countElements = 0, countElementNodes = 0;
+    for (std::vector<Chunk>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        countNodes += it->nodes.size();
+        countElements += it->elements.size();
+        countElementNodes += it->elementNodes.size();
+    }
+    nodes.reserve(countNodes);
+    elements.reserve(countElements);
+    elementNodes.reserve(countElementNodes);
+    for (std::vector<Chunk>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        std::size_t offset = elementNodes.size();
+        nodes.insert(nodes.end(), it->nodes.begin(), it->nodes.end());
+        elementNodes.insert(elementNodes.end(), it->elementNodes.begin(), it->elementNodes.end());
+        for (std::vector<Element>::iterator jt = it->elements.begin(); jt != it->elements.end(); ++jt) {
+            jt->first += offset;
+            elements.push_back(*jt);
+        }
+    }
+
+    return true;
+}
+
+namespace {
+
+/// Number of grid points of the element cards, the first entry is the linear case
+struct ElementCard {
+    const char* name;
+    NastranReader::ElementType linear;
+    int linearCount;
+    NastranReader::ElementType quadratic;
+    int quadraticCount;
+};
+
+const ElementCard elementCards[] = {
+    { "CTRIA3", NastranReader::Tria3,  3, NastranReader::Tria3,    3 },
+    { "CTRIA6", NastranReader::Tria6,  6, NastranReader::Tria6,    6 },
+    { "CQUAD4", NastranReader::Quad4,  4, NastranReader::Quad4,    4 },
+    { "CQUAD8", NastranReader::Quad8,  8, NastranReader::Quad8,    8 },
+    { "CTETRA", NastranReader::Tetra4, 4, NastranReader::Tetra10, 10 },
+    { "CPENTA", NastranReader::Penta6, 6, NastranReader::Penta15, 15 },
+    { "CHEXA",  NastranReader::Hexa8,  8, NastranReader::Hexa20,  20 }
+};
+
+}
+
+void NastranReader::parseChunk(Chunk& chunk) const
+{
+    Nastran::Card card;
+    card.clear();
+
+    const char* pos = chunk.begin;
+    while (pos < chunk.end || card.name[0] != '\0') {
+        // the current card ends with the next card, a comment or the chunk
+        const char* line = pos;
+        const char* eol = line;
+        bool newCard = true;
+        if (pos < chunk.end) {
+            pos = Nastran::nextLine(line, chunk.end);
+            eol = pos;
+            while (eol > line && (*(eol-1) == '\n' || *(eol-1) == '\r'))
+                --eol;
+            if (eol == line || *line == '$')
+                continue; // empty line or comment
+            newCard = std::isalpha(static_cast<unsigned char>(*line)) != 0;
+            if (!newCard) {
+                if (card.name[0] != '\0')
+                    card.addLine(line, eol, false);
+                continue;
+            }
+        }
+
+        // process the completed card
+        if (card.is("GRID")) {
+            // whitespace separated GRID entries without coordinate system
+            // as written by older versions of MeshOutput::SaveNastran
+            if (card.loose && card.fields.size() == 4)
+                card.fields.insert(card.fields.begin() + 1, Nastran::Field(line, line));
+            Node node;
+            node.id = card.intField(0);
+            node.x = card.realField(2);
+            node.y = card.realField(3);
+            node.z = card.realField(4);
+            if (node.id > 0)
+                chunk.nodes.push_back(node);
+        }
+        else if (card.name[0] == 'C') {
+            for (std::size_t i = 0; i < sizeof(elementCards) / sizeof(ElementCard); i++) {
+                const ElementCard& type = elementCards[i];
+                if (!card.is(type.name))
+                    continue;
+
+                // a quadratic element needs all its grid points
+                int count = 0;
+                for (int j = 0; j < type.quadraticCount; j++) {
+                    if (card.intField(2 + j) <= 0)
+                        break;
+                    count++;
+                }
+                Element element;
+                element.id = card.intField(0);
+                if (count == type.quadraticCount) {
+                    element.type = type.quadratic;
+                    element.count = type.quadraticCount;
+                }
+                else if (count >= type.linearCount) {
+                    element.type = type.linear;
+                    element.count = type.linearCount;
+                }
+                else {
+                    break; // incomplete element
+                }
+                element.first = chunk.elementNodes.size();
+                for (int j = 0; j < element.count; j++)
+                    chunk.elementNodes.push_back(card.intField(2 + j));
+                chunk.elements.push_back(element);
+                break;
+            }
+        }
+
+        card.clear();
+        if (newCard && line < chunk.end)
+            card.addLine(line, eol, true);
+    }
+}
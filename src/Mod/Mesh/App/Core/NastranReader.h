@@ -0,0 +1,103 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESHCORE_NASTRANREADER_H
+#define MESHCORE_NASTRANREADER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace MeshCore {
+
+/**
+ * The NastranReader class reads the nodes (GRID) and elements of the bulk data
+ * section of a Nastran input deck.
+ *
+ * Small field, large field (GRID*, continuation with '*') and free field
+ * (comma separated) cards can be mixed. The supported elements are CTRIA3,
+ * CTRIA6, CQUAD4, CQUAD8, CTETRA, CPENTA and CHEXA, where the number of grid
+ * points decides if a solid is linear or quadratic. The node and element ids
+ * of the file are kept, unknown cards are skipped.
+ *
+ * The input is split into chunks at card boundaries which are parsed
+ * concurrently, a file is memory mapped if possible.
+ */
+class MeshExport NastranReader
+{
+public:
+    enum ElementType {
+        Tria3, Tria6, Quad4, Quad8,
+        Tetra4, Tetra10, Penta6, Penta15, Hexa8, Hexa20
+    };
+
+    struct Node {
+        int id;
+        double x, y, z;
+    };
+
+    /// element with the grid ids as given in the file
+    struct Element {
+        int id;
+        ElementType type;
+        std::size_t first; ///< index of the first grid id in getElementNodes()
+        int count;         ///< number of grid ids
+    };
+
+    NastranReader();
+    ~NastranReader();
+
+    /// Reads the deck from a file
+    bool readFile(const std::string& fileName);
+    /// Reads the deck from a buffer in memory
+    bool read(const char* data, std::size_t size);
+
+    const std::vector<Node>& getNodes() const
+    { return nodes; }
+    const std::vector<Element>& getElements() const
+    { return elements; }
+    const std::vector<int>& getElementNodes() const
+    { return elementNodes; }
+
+    /// Returns true for elements of a surface mesh
+    static bool isFace(ElementType type)
+    { return type <= Quad8; }
+
+private:
+    struct Chunk {
+        const char* begin;
+        const char* end;
+        std::vector<Node> nodes;
+        std::vector<Element> elements;
+        std::vector<int> elementNodes;
+    };
+    void parseChunk(Chunk& chunk) const;
+
+private:
+    std::vector<Node> nodes;
+    std::vector<Element> elements;
+    std::vector<int> elementNodes;
+};
+
+} // namespace MeshCore
+
+#endif // MESHCORE_NASTRANREADER_H
@@ -0,0 +1,287 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <climits>
+#endif
+
+#include <QThread>
+#include <QtConcurrentMap>
+#include <boost/bind.hpp>
+
+#include "Slicer.h"
+#include "MeshKernel.h"
+
+using namespace MeshCore;
+
+namespace MeshCore {
+namespace Slicer {
+
+struct FacetMinLess {
+    FacetMinLess(const std::vector<double>& m) : min(m) {}
+    bool operator()(unsigned long i, unsigned long j) const
+    { return min[i] < min[j]; }
+    bool operator()(unsigned long i, double d) const
+    { return min[i] < d; }
+    bool operator()(double d, unsigned long i) const
+    { return d < min[i]; }
+    const std::vector<double>& min;
+};
+
+struct SegmentLess {
+    template <class T>
+    bool operator()(const T& s, unsigned long f) const
+    { return s.facet < f; }
+    template <class T>
+    bool operator()(const T& s, const T& t) const
+    { return s.facet < t.facet; }
+};
+
+/// index of the segment in the neighbour facet over the given side, or -1
+template <class T>
+long findNeighbour(const std::vector<T>& segm, const MeshFacetArray& facets,
+                   const T& s, unsigned short side)
+{
+    unsigned long nb = facets[s.facet]._aulNeighbours[side];
+    if (nb == ULONG_MAX)
+        return -1;
+    typename std::vector<T>::const_iterator it = std::lower_bound
+        (segm.begin(), segm.end(), nb, SegmentLess());
+    if (it == segm.end() || it->facet != nb)
+        return -1;
+    return (long)(it - segm.begin());
+}
+
+} // namespace Slicer
+} // namespace MeshCore
+
+struct MeshSlicer::Chunk {
+    const std::vector<std::pair<double, std::size_t> >* planes;
+    std::size_t begin, end;
+    const std::vector<unsigned long>* order;
+    const std::vector<double>* facetMin;
+    const std::vector<double>* facetMax;
+    const std::vector<double>* pntDist;
+    std::vector<TPolylines>* result;
+};
+
+MeshSlicer::MeshSlicer(const MeshKernel& rclM)
+  : _rclMesh(rclM)
+{
+}
+
+MeshSlicer::~MeshSlicer()
+{
+}
+
+void MeshSlicer::Slice(const Base::Vector3f& rclNormal, const std::vector<float>& rclDist,
+                       std::vector<TPolylines>& rclResult) const
+{
+    rclResult.clear();
+    rclResult.resize(rclDist.size());
+    Base::Vector3f clNormal(rclNormal);
+    if (clNormal.Length() == 0.0f || rclDist.empty())
+        return;
+    clNormal.Normalize();
+
+    // signed distances of the points and the extent of the facets along the normal
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<double> pntDist(rPoints.size());
+    for (std::size_t i = 0; i < rPoints.size(); i++)
+        pntDist[i] = rPoints[i] * clNormal;
+
+    std::vector<double> facetMin(rFacets.size()), facetMax(rFacets.size());
+    std::vector<unsigned long> order(rFacets.size());
+    for (std::size_t i = 0; i < rFacets.size(); i++) {
+        const MeshFacet& f = rFacets[i];
+        double d0 = pntDist[f._aulPoints[0]];
+        double d1 = pntDist[f._aulPoints[1]];
+        double d2 = pntDist[f._aulPoints[2]];
+        facetMin[i] = std::min<double>(d0, std::min<double>(d1, d2));
+        facetMax[i] = std::max<double>(d0, std::max<double>(d1, d2));
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), Slicer::FacetMinLess(facetMin));
+
+    std::vector<std::pair<double, std::size_t> > planes(rclDist.size());
+    for (std::size_t i = 0; i < rclDist.size(); i++)
+        planes[i] = std::make_pair((double)rclDist[i], i);
+    std::sort(planes.begin(), planes.end());
+
+    // each chunk sweeps over a range of consecutive planes
+    std::size_t numChunks = std::max<int>(1, 2 * QThread::idealThreadCount());
+    numChunks = std::min<std::size_t>(numChunks, planes.size());
+    std::vector<Chunk> chunks(numChunks);
+    for (std::size_t i = 0; i < numChunks; i++) {
+        Chunk& c = chunks[i];
+        c.planes = &planes;
+        c.begin = (i * planes.size()) / numChunks;
+        c.end = ((i + 1) * planes.size()) / numChunks;
+        c.order = &order;
+        c.facetMin = &facetMin;
+        c.facetMax = &facetMax;
+        c.pntDist = &pntDist;
+        c.result = &rclResult;
+    }
+
+    QtConcurrent::blockingMap(chunks, boost::bind(&MeshSlicer::SliceChunk, this, _1));
+}
+
+void MeshSlicer::SliceChunk(Chunk& chunk) const
+{
+    const std::vector<std::pair<double, std::size_t> >& planes = *chunk.planes;
+    const std::vector<unsigned long>& order = *chunk.order;
+    const std::vector<double>& facetMin = *chunk.facetMin;
+    const std::vector<double>& facetMax = *chunk.facetMax;
+
+    // facets with min <= d <= max for the current plane d
+    std::vector<unsigned long> active;
+    std::vector<unsigned long>::const_iterator next = order.begin();
+
+    for (std::size_t p = chunk.begin; p < chunk.end; p++) {
+        double d = planes[p].first;
+
+        std::vector<unsigned long>::iterator keep = active.begin();
+        for (std::vector<unsigned long>::iterator it = active.begin(); it != active.end(); ++it) {
+            if (facetMax[*it] >= d)
+                *keep++ = *it;
+        }
+        active.erase(keep, active.end());
+
+        std::vector<unsigned long>::const_iterator last =
+            std::upper_bound(next, order.end(), d, Slicer::FacetMinLess(facetMin));
+        for (; next != last; ++next) {
+            if (facetMax[*next] >= d)
+                active.push_back(*next);
+        }
+
+        SlicePlane(d, active, *chunk.pntDist, (*chunk.result)[planes[p].second]);
+    }
+}
+
+void MeshSlicer::SlicePlane(double fDist, const std::vector<unsigned long>& rclActive,
+                            const std::vector<double>& rclPntDist, TPolylines& rclResult) const
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+
+    // A point on the plane counts as above the plane. Thus all facets
+    // sharing an edge agree on whether it is crossed and each crossed
+    // facet has exactly two crossed edges.
+    std::vector<Segment> segments;
+    for (std::vector<unsigned long>::const_iterator it = rclActive.begin(); it != rclActive.end(); ++it) {
+        const MeshFacet& f = rFacets[*it];
+        bool above[3];
+        for (int i = 0; i < 3; i++)
+            above[i] = rclPntDist[f._aulPoints[i]] >= fDist;
+        if (above[0] == above[1] && above[1] == above[2])
+            continue;
+
+        Segment segm;
+        segm.facet = *it;
+        int num = 0;
+        for (unsigned short i = 0; i < 3; i++) {
+            unsigned short j = (i + 1) % 3;
+            if (above[i] == above[j])
+                continue;
+            // compute the point with ordered end points to get the very same
+            // point in both facets of the edge
+            unsigned long p0 = std::min<unsigned long>(f._aulPoints[i], f._aulPoints[j]);
+            unsigned long p1 = std::max<unsigned long>(f._aulPoints[i], f._aulPoints[j]);
+            double d0 = rclPntDist[p0];
+            double d1 = rclPntDist[p1];
+            float t = (float)((fDist - d0) / (d1 - d0));
+            segm.side[num] = i;
+            segm.point[num] = rPoints[p0] + (rPoints[p1] - rPoints[p0]) * t;
+            num++;
+        }
+        segments.push_back(segm);
+    }
+
+    ChainSegments(segments, rclResult);
+}
+
+void MeshSlicer::ChainSegments(std::vector<Segment>& rclSegm, TPolylines& rclResult) const
+{
+    if (rclSegm.empty())
+        return;
+
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::sort(rclSegm.begin(), rclSegm.end(), Slicer::SegmentLess());
+    std::vector<bool> visited(rclSegm.size(), false);
+
+    // first start at open ends, then go through the remaining closed loops
+    for (int pass = 0; pass < 2; pass++) {
+        for (std::size_t i = 0; i < rclSegm.size(); i++) {
+            if (visited[i])
+                continue;
+
+            int start = 0;
+            if (pass == 0) {
+                if (Slicer::findNeighbour(rclSegm, rFacets, rclSegm[i], rclSegm[i].side[0]) < 0)
+                    start = 0;
+                else if (Slicer::findNeighbour(rclSegm, rFacets, rclSegm[i], rclSegm[i].side[1]) < 0)
+                    start = 1;
+                else
+                    continue;
+            }
+
+            std::vector<Base::Vector3f> polyline;
+            polyline.push_back(rclSegm[i].point[start]);
+            long cur = (long)i;
+            int in = start;
+            bool closed = false;
+            while (cur >= 0) {
+                const Segment& s = rclSegm[cur];
+                visited[cur] = true;
+                const Base::Vector3f& p = s.point[1 - in];
+                if (p != polyline.back())
+                    polyline.push_back(p);
+
+                long nxt = Slicer::findNeighbour(rclSegm, rFacets, s, s.side[1 - in]);
+                if (nxt < 0)
+                    break;
+                if (nxt == (long)i) {
+                    closed = true;
+                    break;
+                }
+                if (visited[nxt])
+                    break;
+
+                // the side of the next segment leading back to this facet
+                const Segment& t = rclSegm[nxt];
+                in = (rFacets[t.facet]._aulNeighbours[t.side[0]] == s.facet) ? 0 : 1;
+                cur = nxt;
+            }
+
+            if (closed && polyline.front() != polyline.back())
+                polyline.push_back(polyline.front());
+            if (polyline.size() > 1)
+                rclResult.push_back(polyline);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESHCORE_SLICER_H
+#define MESHCORE_SLICER_H
+
+#include <list>
+#include <vector>
+#include <Base/Vector3D.h>
+
+namespace MeshCore {
+
+class MeshKernel;
+
+/**
+ * The MeshSlicer class intersects a mesh with a family of parallel planes.
+ *
+ * The facets are sorted by their extent along the plane normal, so a sweep
+ * over the sorted planes only visits the facets crossing the current plane.
+ * The intersection segments of a plane are chained to polylines over the
+ * facet neighbourhood. Consecutive ranges of planes are sliced in parallel.
+ */
+class MeshExport MeshSlicer
+{
+public:
+    typedef std::list<std::vector<Base::Vector3f> > TPolylines;
+
+    MeshSlicer(const MeshKernel&);
+    ~MeshSlicer();
+
+    /**
+     * Cuts the mesh with the planes x*\a rclNormal = d for each distance d of
+     * \a rclDist. \a rclResult holds the polylines of each plane in the order
+     * of the distances, closed polylines end with their start point.
+     */
+    void Slice(const Base::Vector3f& rclNormal, const std::vector<float>& rclDist,
+               std::vector<TPolylines>& rclResult) const;
+
+private:
+    struct Segment {
+        unsigned long facet;
+        unsigned short side[2];
+        Base::Vector3f point[2];
+    };
+    struct Chunk;
+
+    void SliceChunk(Chunk&) const;
+    void SlicePlane(double fDist, const std::vector<unsigned long>& rclActive,
+                    const std::vector<double>& rclPntDist, TPolylines& rclResult) const;
+    void ChainSegments(std::vector<Segment>& rclSegm, TPolylines& rclResult) const;
+
+private:
+    const MeshKernel& _rclMesh;
+};
+
+} // namespace MeshCore
+
+#endif // MESHCORE_SLICER_H
@@ -47,6 +47,7 @@
 #include "Core/Degeneration.h"
 #include "Core/Segmentation.h"
 #include "Core/SetOperations.h"
+#include "Core/Slicer.h"
 #include "Core/Triangulation.h"
 #include "Core/Trim.h"
 #include "Core/Visitor.h"
@@ -828,6 +829,15 @@ void MeshObject::crossSections(const std::vector<MeshObject::TPlane>& planes, st
 {
     MeshCore::MeshFacetGrid grid(_kernel);
     MeshCore::MeshAlgorithm algo(_kernel);
+    // MeshSlicer doesn't use the tolerance, so a custom one keeps the plane by plane path
+    if (!bConnectPolygons && fMinEps == 1.0e-2f) {
+        // all planes in one pass, parallel planes are sliced with MeshSlicer
+        std::vector<MeshObject::TPolylines> polylines;
+        algo.CutWithPlanes(planes, grid, polylines, fMinEps);
+        sections.insert(sections.end(), polylines.begin(), polylines.end());
+        return;
+    }
+
     for (std::vector<MeshObject::TPlane>::const_iterator it = planes.begin(); it != planes.end(); ++it) {
         MeshObject::TPolylines polylines;
         algo.CutWithPlane(it->first, it->second, grid, polylines, fMinEps, bConnectPolygons);
@@ -835,6 +845,13 @@ void MeshObject::crossSections(const std::vector<MeshObject::TPlane>& planes, st
     }
 }
 
+void MeshObject::slices(const Base::Vector3f& dir, const std::vector<float>& distances,
+                        std::vector<MeshObject::TPolylines> &sections) const
+{
+    MeshCore::MeshSlicer slicer(_kernel);
+    slicer.Slice(dir, distances, sections);
+}
+
 void MeshObject::cut(const Base::Polygon2D& polygon2d,
                      const Base::ViewProjMethod& proj, MeshObject::CutType type)
 {
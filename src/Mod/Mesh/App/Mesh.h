@@ -206,6 +206,12 @@ public:
     Base::Vector3d getPointNormal(unsigned long) const;
     void crossSections(const std::vector<TPlane>&, std::vector<TPolylines> &sections,
                        float fMinEps = 1.0e-2f, bool bConnectPolygons = false) const;
+    /** Cuts the mesh with the parallel planes x*dir = d for all given distances
+     * in one sweep. The polylines of each plane are chained over the facet
+     * neighbourhood, closed polylines end with their start point.
+     */
+    void slices(const Base::Vector3f& dir, const std::vector<float>& distances,
+                std::vector<TPolylines> &sections) const;
     void cut(const Base::Polygon2D& polygon, const Base::ViewProjMethod& proj, CutType);
     void trim(const Base::Polygon2D& polygon, const Base::ViewProjMethod& proj, CutType);
     //@}
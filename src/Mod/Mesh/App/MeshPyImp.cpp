@@ -27,6 +27,7 @@
 #include <Base/Handle.h>
 #include <Base/Builder3D.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/PyBuffer.h>
 
 #include "Mesh.h"
 #include "MeshPy.h"
@@ -321,6 +322,41 @@ PyObject*  MeshPy::crossSections(PyObject *args)
     return Py::new_reference_to(crossSections);
 }
 
+PyObject*  MeshPy::slices(PyObject *args)
+{
+    PyObject *dir;
+    PyObject *obj;
+    if (!PyArg_ParseTuple(args, "O!O", &(Base::VectorPy::Type), &dir, &obj))
+        return 0;
+
+    Base::Vector3d d = static_cast<Base::VectorPy*>(dir)->value();
+    std::vector<float> distances;
+    PY_TRY {
+        Py::Sequence list(obj);
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it)
+            distances.push_back((float)(double)Py::Float(*it));
+    } PY_CATCH;
+
+    std::vector<MeshObject::TPolylines> sections;
+    getMeshObjectPtr()->slices(Base::Vector3f((float)d.x,(float)d.y,(float)d.z), distances, sections);
+
+    // convert to Python objects
+    Py::List slices;
+    for (std::vector<MeshObject::TPolylines>::iterator it = sections.begin(); it != sections.end(); ++it) {
+        Py::List section;
+        for (MeshObject::TPolylines::const_iterator jt = it->begin(); jt != it->end(); ++jt) {
+            Py::List polyline;
+            for (std::vector<Base::Vector3f>::const_iterator kt = jt->begin(); kt != jt->end(); ++kt) {
+                polyline.append(Py::Object(new Base::VectorPy(*kt)));
+            }
+            section.append(polyline);
+        }
+        slices.append(section);
+    }
+
+    return Py::new_reference_to(slices);
+}
+
 PyObject*  MeshPy::unite(PyObject *args)
 {
     MeshPy   *pcObject;
@@ -645,6 +681,117 @@ PyObject* MeshPy::rebuildNeighbourHood(PyObject *args)
     Py_Return;
 }
 
+namespace Mesh {
+template <class T>
+static void copyPoints(const MeshCore::MeshPointArray& points, const Base::Matrix4D& mat, T* out)
+{
+    bool transform = !(mat == Base::Matrix4D());
+    for (MeshCore::MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it) {
+        Base::Vector3d p(it->x, it->y, it->z);
+        if (transform)
+            p = mat * p;
+        *out++ = static_cast<T>(p.x);
+        *out++ = static_cast<T>(p.y);
+        *out++ = static_cast<T>(p.z);
+    }
+}
+}
+
+PyObject*  MeshPy::getPointData(PyObject *args)
+{
+    PyObject *dbl = Py_False;
+    if (!PyArg_ParseTuple(args, "|O!", &PyBool_Type, &dbl))
+        return NULL;
+
+    PY_TRY {
+        const MeshObject* mesh = getMeshObjectPtr();
+        const MeshCore::MeshPointArray& points = mesh->getKernel().GetPoints();
+        Py_ssize_t count = 3 * (Py_ssize_t)points.size();
+        char* data;
+        if (PyObject_IsTrue(dbl)) {
+            PyObject* array = Base::createByteArray(count * sizeof(double), data);
+            copyPoints(points, mesh->getTransform(), reinterpret_cast<double*>(data));
+            return array;
+        }
+        else {
+            PyObject* array = Base::createByteArray(count * sizeof(float), data);
+            copyPoints(points, mesh->getTransform(), reinterpret_cast<float*>(data));
+            return array;
+        }
+    } PY_CATCH;
+}
+
+PyObject*  MeshPy::getFacetData(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    PY_TRY {
+        const MeshCore::MeshFacetArray& facets = getMeshObjectPtr()->getKernel().GetFacets();
+        char* data;
+        PyObject* array = Base::createByteArray(3 * (Py_ssize_t)facets.size() * sizeof(uint32_t), data);
+        uint32_t* out = reinterpret_cast<uint32_t*>(data);
+        for (MeshCore::MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+            *out++ = (uint32_t)it->_aulPoints[0];
+            *out++ = (uint32_t)it->_aulPoints[1];
+            *out++ = (uint32_t)it->_aulPoints[2];
+        }
+        return array;
+    } PY_CATCH;
+}
+
+PyObject*  MeshPy::setData(PyObject *args)
+{
+    PyObject *pnts, *facs;
+    if (!PyArg_ParseTuple(args, "OO", &pnts, &facs))
+        return NULL;
+
+    PY_TRY {
+        Base::PyBufferReader pointBuf(pnts);
+        Base::PyBufferReader facetBuf(facs);
+        if (pointBuf.size() % 3 != 0)
+            throw Py::ValueError("Number of coordinates is not a multiple of three");
+        if (facetBuf.size() % 3 != 0)
+            throw Py::ValueError("Number of point indices is not a multiple of three");
+
+        std::vector<float> xyz(pointBuf.size());
+        if (!xyz.empty())
+            pointBuf.copyTo(&xyz[0]);
+        std::vector<unsigned long> indices(facetBuf.size());
+        if (!indices.empty())
+            facetBuf.copyTo(&indices[0]);
+
+        // the data is given in global coordinates
+        Base::Matrix4D mat = getMeshObjectPtr()->getTransform();
+        bool transform = !(mat == Base::Matrix4D());
+        if (transform)
+            mat.inverseGauss();
+
+        MeshCore::MeshPointArray points(xyz.size() / 3);
+        for (std::size_t i = 0; i < points.size(); i++) {
+            Base::Vector3f p(xyz[3*i], xyz[3*i+1], xyz[3*i+2]);
+            points[i] = transform ? mat * p : p;
+        }
+
+        MeshCore::MeshFacetArray facets(indices.size() / 3);
+        for (std::size_t i = 0; i < facets.size(); i++) {
+            for (int j = 0; j < 3; j++) {
+                unsigned long index = indices[3*i+j];
+                if (index >= points.size())
+                    throw Py::IndexError("Point index out of range");
+                facets[i]._aulPoints[j] = index;
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        MeshPropertyLock lock(this->parentProperty);
+        getMeshObjectPtr()->swap(kernel);
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject*  MeshPy::addMesh(PyObject *args)
 {
     PyObject* mesh;
@@ -2,6 +2,7 @@
 
 import FreeCAD, os, sys, unittest, Mesh
 import thread, time, tempfile
+import array, ctypes
 
 
 #---------------------------------------------------------------------------
@@ -71,6 +72,235 @@ class MeshGeoTestCases(unittest.TestCase):
 		res=f1.intersect(f2)
 		self.failUnless(len(res) == 0)
 
+class MeshBufferTestCases(unittest.TestCase):
+	# the buffers are read with the array module and written with ctypes arrays
+	# which both come with Python, so these tests don't need numpy
+	def setUp(self):
+		self.mesh = Mesh.createBox(1.0,2.0,3.0)
+		pl = self.mesh.Placement
+		pl.Base = FreeCAD.Vector(1,2,3)
+		self.mesh.Placement = pl
+
+	def unpack(self, data, typecode):
+		values = array.array(typecode)
+		values.fromstring(str(data))
+		return values
+
+	def testPointData(self):
+		pts = self.unpack(self.mesh.getPointData(True), 'd')
+		self.failUnless(len(pts) == 3 * self.mesh.CountPoints)
+		for i, q in enumerate(self.mesh.Points):
+			p = FreeCAD.Vector(pts[3*i], pts[3*i+1], pts[3*i+2])
+			self.failUnless((p - q.Vector).Length < 1e-6)
+		flt = self.unpack(self.mesh.getPointData(), 'f')
+		self.failUnless(len(flt) == len(pts))
+		for p, q in zip(pts, flt):
+			self.failUnless(abs(p - q) < 1e-5)
+		# the points are moved by the placement
+		self.failUnless(abs(min(pts[0::3]) - self.mesh.BoundBox.XMin) < 1e-6)
+		self.failUnless(abs(self.mesh.BoundBox.XMin - 1.0) < 1e-6)
+
+	def testRoundTrip(self):
+		pts = self.unpack(self.mesh.getPointData(True), 'd')
+		fac = self.unpack(self.mesh.getFacetData(), 'I')
+		self.failUnless(len(fac) == 3 * self.mesh.CountFacets)
+		other = Mesh.Mesh()
+		other.setData((ctypes.c_double * len(pts))(*pts), (ctypes.c_uint * len(fac))(*fac))
+		self.failUnless(other.CountPoints == self.mesh.CountPoints)
+		self.failUnless(other.CountFacets == self.mesh.CountFacets)
+		self.failUnless(abs(other.Volume - self.mesh.Volume) < 1e-5)
+		self.failUnless((other.BoundBox.Center - self.mesh.BoundBox.Center).Length < 1e-5)
+
+	def testByteIndices(self):
+		# a bytearray is read as unsigned bytes
+		pts = (ctypes.c_float * 9)(0,0,0, 1,0,0, 0,1,0)
+		other = Mesh.Mesh()
+		other.setData(pts, bytearray([0,1,2]))
+		self.failUnless(other.CountPoints == 3)
+		self.failUnless(other.CountFacets == 1)
+		self.failUnless(abs(other.Area - 0.5) < 1e-6)
+
+	def testInvalidData(self):
+		pts = (ctypes.c_float * 9)()
+		self.assertRaises(IndexError, Mesh.Mesh().setData, pts, (ctypes.c_int * 3)(0,1,3))
+		self.assertRaises(ValueError, Mesh.Mesh().setData, (ctypes.c_float * 8)(), (ctypes.c_int * 3)(0,1,2))
+		self.assertRaises(TypeError, Mesh.Mesh().setData, pts, (ctypes.c_bool * 3)())
+
+
+class MeshSlicesTestCases(unittest.TestCase):
+	def setUp(self):
+		self.mesh = Mesh.createBox(1.0,2.0,3.0)
+		bb = self.mesh.BoundBox
+		self.dist = [bb.ZMin + (i + 0.5) * bb.ZLength / 5 for i in range(5)]
+
+	def perimeter(self, polyline):
+		# the length of the closed polygon, whether or not the start point is repeated
+		points = list(polyline)
+		if (points[0] - points[-1]).Length > 1e-6:
+			points.append(points[0])
+		return sum([(points[i+1] - points[i]).Length for i in range(len(points) - 1)])
+
+	def testSlices(self):
+		sections = self.mesh.slices(FreeCAD.Vector(0,0,1), self.dist)
+		self.failUnless(len(sections) == len(self.dist))
+		for d, section in zip(self.dist, sections):
+			self.failUnless(len(section) == 1)
+			polyline = section[0]
+			self.failUnless((polyline[0] - polyline[-1]).Length < 1e-6)
+			self.failUnless(abs(self.perimeter(polyline) - 6.0) < 1e-4)
+			for v in polyline:
+				self.failUnless(abs(v.z - d) < 1e-5)
+
+	def testNonUnitDirection(self):
+		unit = self.mesh.slices(FreeCAD.Vector(0,0,1), self.dist)
+		scaled = self.mesh.slices(FreeCAD.Vector(0,0,5), self.dist)
+		self.failUnless(len(unit) == len(scaled))
+		for a, b in zip(unit, scaled):
+			self.failUnless(len(a) == len(b))
+			for p, q in zip(a, b):
+				self.failUnless(abs(self.perimeter(p) - self.perimeter(q)) < 1e-4)
+				self.failUnless(abs(p[0].z - q[0].z) < 1e-5)
+
+	def testPlanesOutside(self):
+		bb = self.mesh.BoundBox
+		sections = self.mesh.slices(FreeCAD.Vector(0,0,1), [bb.ZMin - 1.0, bb.ZMax + 1.0])
+		self.failUnless(sections == [[], []])
+
+	def testSameAsCrossSections(self):
+		planes = [(FreeCAD.Vector(0,0,d), FreeCAD.Vector(0,0,1)) for d in self.dist]
+		cross = self.mesh.crossSections(planes)
+		sections = self.mesh.slices(FreeCAD.Vector(0,0,1), self.dist)
+		self.failUnless(len(cross) == len(sections))
+		for a, b in zip(cross, sections):
+			self.failUnless(len(a) == len(b))
+			for p, q in zip(a, b):
+				self.failUnless(abs(self.perimeter(p) - self.perimeter(q)) < 1e-4)
+
+
+class MeshCrossSectionsTestCases(unittest.TestCase):
+	def setUp(self):
+		self.mesh = Mesh.createSphere(10.0, 30)
+		self.normals = [FreeCAD.Vector(0,0,1), FreeCAD.Vector(1,2,3)]
+
+	def length(self, section):
+		# the length of all polylines of a section, closing them if needed
+		total = 0.0
+		for polyline in section:
+			points = list(polyline)
+			if (points[0] - points[-1]).Length > 1e-6:
+				points.append(points[0])
+			total += sum([(points[i+1] - points[i]).Length for i in range(len(points) - 1)])
+		return total
+
+	def planes(self, normal):
+		# keep the planes off the vertex rings of the sphere
+		n = FreeCAD.Vector(normal)
+		n.normalize()
+		return [(FreeCAD.Vector(n).multiply(i * 2.0 + 0.3), FreeCAD.Vector(normal)) for i in range(-4, 4)]
+
+	def single(self, plane):
+		# with a tolerance other than the default the plane is cut the old way
+		return self.mesh.crossSections([plane], 0.02)[0]
+
+	def testSameAsSinglePlanes(self):
+		# several parallel planes are sliced together
+		for normal in self.normals:
+			planes = self.planes(normal)
+			batch = self.mesh.crossSections(planes)
+			self.failUnless(len(batch) == len(planes))
+			for plane, section in zip(planes, batch):
+				single = self.single(plane)
+				self.failUnless(len(section) == len(single))
+				self.failUnless(abs(self.length(section) - self.length(single)) < 1e-3)
+
+	def testMixedPlanes(self):
+		# the result keeps the order of the planes
+		planes = self.planes(self.normals[0]) + self.planes(self.normals[1])
+		planes.append((FreeCAD.Vector(0.3,0,0), FreeCAD.Vector(1,0,0)))
+		planes.reverse()
+		batch = self.mesh.crossSections(planes)
+		self.failUnless(len(batch) == len(planes))
+		for plane, section in zip(planes, batch):
+			single = self.single(plane)
+			self.failUnless(len(section) == len(single))
+			self.failUnless(abs(self.length(section) - self.length(single)) < 1e-3)
+
+
+	def testSinglePlanes(self):
+		# planes without a parallel partner chain their segments with a hash
+		planes = [(FreeCAD.Vector(0,0,0.3), FreeCAD.Vector(0,0,1)),
+		          (FreeCAD.Vector(0.3,0,0), FreeCAD.Vector(1,0,0)),
+		          (FreeCAD.Vector(0,0.3,0), FreeCAD.Vector(1,2,3))]
+		batch = self.mesh.crossSections(planes)
+		for plane, section in zip(planes, batch):
+			single = self.single(plane)
+			self.failUnless(len(section) == 1)
+			self.failUnless(len(section) == len(single))
+			self.failUnless(abs(self.length(section) - self.length(single)) < 1e-3)
+
+
+class MeshSelfIntersectionTestCases(unittest.TestCase):
+	def setUp(self):
+		self.mesh = Mesh.createSphere(10.0, 30)
+
+	def testNoSelfIntersections(self):
+		self.failUnless(not self.mesh.hasSelfIntersections())
+
+	def testOverlappingSpheres(self):
+		# the facets of both spheres cross each other in many grid cells
+		other = Mesh.createSphere(10.0, 30)
+		other.translate(5, 0, 0)
+		self.mesh.addMesh(other)
+		self.failUnless(self.mesh.hasSelfIntersections())
+		count = self.mesh.CountFacets
+		self.mesh.fixSelfIntersections()
+		self.failUnless(self.mesh.CountFacets < count)
+
+
+def nastranDeck():
+	# the same elements written in small field, large field and free field format
+	lines = ["$ test deck", "BEGIN BULK"]
+	lines.append("%-8s%-8s%-8s%-8s%-8s%-8s" % ("GRID", "1", "", "0.", "0.", "0."))
+	lines.append("%-8s%-8s%-8s%-8s%-8s%-8s" % ("GRID", "2", "", "1.", "0.", "0."))
+	lines.append("GRID,3,,1.,1.,0.")
+	lines.append("GRID,4,,0.,1.,0.")
+	lines.append("%-8s%-16s%-16s%-16s%-16s" % ("GRID*", "5", "", "2.", "0."))
+	lines.append("%-8s%-16s" % ("*", "0."))
+	lines.append("GRID, 6, , 2.0, 1.0, 0.0")
+	lines.append("GRID,7,,3.,0.,0.")
+	lines.append("GRID,8,,3.,1.,-1.-10")
+	lines.append("%-8s%-8s%-8s%-8s%-8s%-8s" % ("CTRIA3", "1", "1", "1", "2", "3"))
+	lines.append("CTRIA3,2,1,1,3,4")
+	lines.append("CTRIA3,3,1,2,5,6")
+	lines.append("$ comment between the elements")
+	lines.append("CTRIA3 , 4 , 1 , 2 , 6 , 3")
+	lines.append("CQUAD4,5,1,5,7,8,6")
+	lines.append("ENDDATA")
+	return "\n".join(lines) + "\n"
+
+
+class MeshNastranTestCases(unittest.TestCase):
+	def setUp(self):
+		self.fileName = tempfile.gettempdir() + os.sep + "MeshNastranTest.nas"
+		file = open(self.fileName, "w")
+		file.write(nastranDeck())
+		file.close()
+
+	def testReadDeck(self):
+		mesh = Mesh.Mesh()
+		mesh.read(self.fileName)
+		self.failUnless(mesh.CountPoints == 8)
+		# the quadrangle is split into two triangles
+		self.failUnless(mesh.CountFacets == 6)
+		bbox = mesh.BoundBox
+		self.failUnless(abs(bbox.XMax - 3.0) < 1e-6)
+		self.failUnless(abs(bbox.YMax - 1.0) < 1e-6)
+		self.failUnless(abs(bbox.ZMin + 1e-10) < 1e-12)
+
+	def tearDown(self):
+		os.remove(self.fileName)
+
+
 class PivyTestCases(unittest.TestCase):
 	def setUp(self):
 		# set up a planar face with 2 triangles
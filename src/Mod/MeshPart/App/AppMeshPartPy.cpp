@@ -24,12 +24,17 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <BRepBuilderAPI_MakePolygon.hxx>
+# include <BRep_Builder.hxx>
+# include <Precision.hxx>
+# include <TopoDS_Compound.hxx>
 #endif
 
 #include <Base/PyObjectBase.h>
 #include <Base/Console.h>
 #include <Base/Vector3D.h>
+#include <Base/VectorPy.h>
 #include <Mod/Part/App/TopoShapePy.h>
+#include <Mod/Part/App/TopoShapeCompoundPy.h>
 #include <Mod/Part/App/TopoShapeWirePy.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -256,6 +261,82 @@ meshFromShape(PyObject *self, PyObject *args, PyObject* kwds)
     return 0;
 }
 
+static PyObject *
+slicesFromShape(PyObject *self, PyObject *args, PyObject* kwds)
+{
+    PyObject *shape, *dir, *obj;
+    double deflection = 0.1;
+    PyObject *refine = Py_False;
+    static char* kwds_slices[] = {"Shape", "Direction", "Distances", "Deflection", "Refine", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O!O|dO!", kwds_slices,
+                                     &(Part::TopoShapePy::Type), &shape,
+                                     &(Base::VectorPy::Type), &dir, &obj,
+                                     &deflection, &PyBool_Type, &refine))
+        return 0;
+
+    const Part::TopoShape* topo = static_cast<Part::TopoShapePy*>(shape)->getTopoShapePtr();
+    Base::Vector3d vec = static_cast<Base::VectorPy*>(dir)->value();
+    if (vec.Length() < Precision::Confusion()) {
+        PyErr_SetString(PyExc_ValueError, "Direction must not be a null vector");
+        return 0;
+    }
+    // the distances refer to a unit normal for both the mesh and the exact slices
+    vec.Normalize();
+    std::vector<float> distances;
+    PY_TRY {
+        Py::Sequence list(obj);
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it)
+            distances.push_back((float)(double)Py::Float(*it));
+    } PY_CATCH;
+
+    try {
+        // slice the tessellation of the shape in one sweep
+        std::vector<Base::Vector3d> points;
+        std::vector<Data::ComplexGeoData::Facet> facets;
+        topo->getFaces(points, facets, (float)deflection);
+        Mesh::MeshObject mesh;
+        mesh.setFacets(facets, points);
+
+        std::vector<Mesh::MeshObject::TPolylines> sections;
+        mesh.slices(Base::Vector3f((float)vec.x,(float)vec.y,(float)vec.z), distances, sections);
+
+        if (PyObject_IsTrue(refine)) {
+            // compute the exact sections only for the planes hitting the shape
+            std::vector<double> hits;
+            for (std::size_t i=0; i<sections.size(); i++) {
+                if (!sections[i].empty())
+                    hits.push_back(distances[i]);
+            }
+            TopoDS_Compound comp = topo->slices(vec, hits);
+            return new Part::TopoShapeCompoundPy(new Part::TopoShape(comp));
+        }
+
+        TopoDS_Compound comp;
+        BRep_Builder builder;
+        builder.MakeCompound(comp);
+        for (std::vector<Mesh::MeshObject::TPolylines>::iterator it = sections.begin(); it != sections.end(); ++it) {
+            for (Mesh::MeshObject::TPolylines::iterator jt = it->begin(); jt != it->end(); ++jt) {
+                BRepBuilderAPI_MakePolygon mkPoly;
+                for (std::vector<Base::Vector3f>::iterator kt = jt->begin(); kt != jt->end(); ++kt) {
+                    mkPoly.Add(gp_Pnt(kt->x,kt->y,kt->z));
+                }
+                if (mkPoly.IsDone())
+                    builder.Add(comp, mkPoly.Wire());
+            }
+        }
+        return new Part::TopoShapeCompoundPy(new Part::TopoShape(comp));
+    }
+    catch (Standard_Failure) {
+        Handle_Standard_Failure e = Standard_Failure::Caught();
+        PyErr_SetString(Base::BaseExceptionFreeCADError, e->GetMessageString());
+        return 0;
+    }
+    catch (const Base::Exception& e) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, e.what());
+        return 0;
+    }
+}
+
 /* registration table  */
 struct PyMethodDef MeshPart_methods[] = {
     {"loftOnCurve",loftOnCurve, METH_VARARGS, loft_doc},
@@ -263,5 +344,10 @@ struct PyMethodDef MeshPart_methods[] = {
      "Create wire(s) from boundary of segment"},
     {"meshFromShape",(PyCFunction)meshFromShape, METH_VARARGS|METH_KEYWORDS,
      "Create mesh from shape"},
+    {"slicesFromShape",(PyCFunction)slicesFromShape, METH_VARARGS|METH_KEYWORDS,
+     "slicesFromShape(Shape, Direction, Distances, [Deflection=0.1, Refine=False])\n"
+     "Slice the tessellation of the shape with parallel planes in one sweep and return\n"
+     "a compound of the polygons. With Refine the exact sections of the shape are\n"
+     "computed for all planes hitting it."},
     {NULL, NULL}        /* end of table marker */
 };
@@ -16,6 +16,7 @@
 # include <IGESControl_Controller.hxx>
 # include <STEPControl_Controller.hxx>
 # include <OSD.hxx>
+# include <Standard.hxx>
 # include <sstream>
 #endif
 
@@ -117,6 +118,11 @@ void PartExport initPart()
     OSD::SetSignal(Standard_False);
 //#endif
 
+    // Several algorithms process shapes in worker threads. The reference counting of
+    // the shared OCC handles must be thread-safe for that, so it is switched on once
+    // for the whole process here instead of from the individual algorithms.
+    Standard::SetReentrant(Standard_True);
+
     PyObject* partModule = Py_InitModule3("Part", Part_methods, module_part_doc);   /* mod name, table ptr */
     Base::Console().Log("Loading Part module... done\n");
     PyObject* OCCError = 0;
@@ -85,38 +85,16 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
 
     if (s.size() >= 2) {
         try {
+            Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+                .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
+
+            // A balanced reduction keeps the operands of each operation small and runs the
+            // independent ones concurrently
             std::vector<ShapeHistory> history;
-            TopoDS_Shape resShape = s.front();
-            if (resShape.IsNull())
-                throw Base::Exception("Input shape is null");
-            for (std::vector<TopoDS_Shape>::iterator it = s.begin()+1; it != s.end(); ++it) {
-                if (it->IsNull())
-                    throw Base::Exception("Input shape is null");
-
-                // Let's call algorithm computing a fuse operation:
-                BRepAlgoAPI_Fuse mkFuse(resShape, *it);
-                // Let's check if the fusion has been successful
-                if (!mkFuse.IsDone()) 
-                    throw Base::Exception("Fusion failed");
-                resShape = mkFuse.Shape();
-
-                ShapeHistory hist1 = buildHistory(mkFuse, TopAbs_FACE, resShape, mkFuse.Shape1());
-                ShapeHistory hist2 = buildHistory(mkFuse, TopAbs_FACE, resShape, mkFuse.Shape2());
-                if (history.empty()) {
-                    history.push_back(hist1);
-                    history.push_back(hist2);
-                }
-                else {
-                    for (std::vector<ShapeHistory>::iterator jt = history.begin(); jt != history.end(); ++jt)
-                        *jt = joinHistory(*jt, hist1);
-                    history.push_back(hist2);
-                }
-            }
+            TopoDS_Shape resShape = reduceShapes(BooleanFuse, s, history, hGrp->GetBool("BalancedReduction", true));
             if (resShape.IsNull())
                 throw Base::Exception("Resulting shape is null");
 
-            Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-                .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
             if (hGrp->GetBool("CheckModel", false)) {
                 BRepCheck_Analyzer aChecker(resShape);
                 if (! aChecker.IsValid() ) {
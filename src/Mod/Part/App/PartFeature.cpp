@@ -29,6 +29,9 @@
 # include <BRepBuilderAPI_MakeShape.hxx>
 # include <BRepAlgoAPI_Fuse.hxx>
 # include <BRepAlgoAPI_Common.hxx>
+# include <BRepAlgoAPI_BooleanOperation.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <memory>
 # include <TopTools_ListIteratorOfListOfShape.hxx>
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
@@ -43,6 +46,7 @@
 
 
 #include <strstream>
+#include <QtConcurrentMap>
 #include <Base/Console.h>
 #include <Base/Writer.h>
 #include <Base/Reader.h>
@@ -232,6 +236,134 @@ ShapeHistory Feature::joinHistory(const ShapeHistory& oldH, const ShapeHistory&
     return join;
 }
 
+namespace Part {
+// A shape of the reduction tree with the indices of the input shapes it was made of
+struct BooleanNode {
+    TopoDS_Shape shape;
+    std::vector<std::size_t> inputs;
+    bool leaf;
+};
+}
+
+struct Feature::BooleanStep {
+    BooleanType type;
+    const BooleanNode* first;
+    const BooleanNode* second;
+    BooleanNode result;
+    std::vector<ShapeHistory>* history;
+    bool copy;
+    std::string error;
+};
+
+void Feature::reduceStep(BooleanStep& step)
+{
+    try {
+        // A boolean operation adds pcurves to and changes tolerances of its arguments. The
+        // inputs may share TShapes, e.g. the instances of a pattern, so concurrent steps work
+        // on copies. A copy keeps the order of the sub-shapes and thus the history indices.
+        TopoDS_Shape shape1 = step.first->shape;
+        TopoDS_Shape shape2 = step.second->shape;
+        if (step.copy) {
+            shape1 = BRepBuilderAPI_Copy(shape1).Shape();
+            shape2 = BRepBuilderAPI_Copy(shape2).Shape();
+        }
+
+        std::auto_ptr<BRepAlgoAPI_BooleanOperation> mkBool;
+        if (step.type == BooleanFuse)
+            mkBool.reset(new BRepAlgoAPI_Fuse(shape1, shape2));
+        else
+            mkBool.reset(new BRepAlgoAPI_Common(shape1, shape2));
+        if (!mkBool->IsDone()) {
+            step.error = (step.type == BooleanFuse ? "Fusion failed" : "Intersection failed");
+            return;
+        }
+
+        step.result.shape = mkBool->Shape();
+        step.result.leaf = false;
+        if (!step.history)
+            return;
+
+        // Compose the history of every input shape of both operands with this operation. Each
+        // input belongs to exactly one step of a level, so the steps write to distinct entries.
+        const BooleanNode* operands[2] = { step.first, step.second };
+        for (int i=0; i<2; i++) {
+            const BooleanNode* node = operands[i];
+            ShapeHistory hist = buildHistory(*mkBool, TopAbs_FACE, step.result.shape,
+                                             i == 0 ? mkBool->Shape1() : mkBool->Shape2());
+            for (std::vector<std::size_t>::const_iterator it = node->inputs.begin(); it != node->inputs.end(); ++it) {
+                ShapeHistory& input = (*step.history)[*it];
+                input = node->leaf ? hist : joinHistory(input, hist);
+                step.result.inputs.push_back(*it);
+            }
+        }
+    }
+    catch (Standard_Failure) {
+        Handle_Standard_Failure e = Standard_Failure::Caught();
+        step.error = e->GetMessageString() ? e->GetMessageString() : "Unknown OCC exception";
+    }
+}
+
+TopoDS_Shape Feature::reduceShapes(BooleanType type, const std::vector<TopoDS_Shape>& shapes,
+                                   std::vector<ShapeHistory>& history, bool balanced)
+{
+    history.clear();
+    history.resize(shapes.size());
+    return reduceShapes(type, shapes, &history, balanced);
+}
+
+TopoDS_Shape Feature::reduceShapes(BooleanType type, const std::vector<TopoDS_Shape>& shapes,
+                                   bool balanced)
+{
+    return reduceShapes(type, shapes, 0, balanced);
+}
+
+TopoDS_Shape Feature::reduceShapes(BooleanType type, const std::vector<TopoDS_Shape>& shapes,
+                                   std::vector<ShapeHistory>* history, bool balanced)
+{
+    if (shapes.empty())
+        throw Base::Exception("No input shapes");
+
+    std::vector<BooleanNode> nodes(shapes.size());
+    for (std::size_t i=0; i<shapes.size(); i++) {
+        if (shapes[i].IsNull())
+            throw Base::Exception("Input shape is null");
+        nodes[i].shape = shapes[i];
+        nodes[i].inputs.push_back(i);
+        nodes[i].leaf = true;
+    }
+
+    while (nodes.size() > 1) {
+        // Neighbouring nodes are combined pairwise and a left over node moves up to the next
+        // level as is. Without balancing the accumulated shape is combined with the next one.
+        std::size_t numSteps = balanced ? nodes.size() / 2 : 1;
+        std::vector<BooleanStep> steps(numSteps);
+        for (std::size_t i=0; i<numSteps; i++) {
+            steps[i].type = type;
+            steps[i].first = &nodes[2*i];
+            steps[i].second = &nodes[2*i+1];
+            steps[i].history = history;
+            steps[i].copy = numSteps > 1;
+        }
+
+        if (steps.size() > 1)
+            QtConcurrent::blockingMap(steps, &Feature::reduceStep);
+        else
+            reduceStep(steps.front());
+
+        std::vector<BooleanNode> next;
+        next.reserve(nodes.size() - numSteps);
+        for (std::vector<BooleanStep>::iterator it = steps.begin(); it != steps.end(); ++it) {
+            if (!it->error.empty())
+                throw Base::Exception(it->error);
+            next.push_back(it->result);
+        }
+        next.insert(next.end(), nodes.begin() + 2*numSteps, nodes.end());
+        nodes.swap(next);
+    }
+
+    return nodes.front().shape;
+}
+
 const TopoDS_Shape Feature::findOriginOf(const TopoDS_Shape& reference) {
 /*    Base::Console().Error("Looking for origin of face in %s\n", this->getName());
     if (reference.ShapeType() == TopAbs_FACE) {
@@ -84,9 +84,32 @@ protected:
      * newS: The new shape that was created by the operation
      * oldS: The original shape prior to the operation
      */
-    ShapeHistory buildHistory(BRepBuilderAPI_MakeShape&, TopAbs_ShapeEnum type,
+    static ShapeHistory buildHistory(BRepBuilderAPI_MakeShape&, TopAbs_ShapeEnum type,
         const TopoDS_Shape& newS, const TopoDS_Shape& oldS);
-    ShapeHistory joinHistory(const ShapeHistory&, const ShapeHistory&);
+    static ShapeHistory joinHistory(const ShapeHistory&, const ShapeHistory&);
+
+    enum BooleanType {
+        BooleanFuse,
+        BooleanCommon
+    };
+    /**
+     * Apply a fuse or common operation to all shapes
+     * shapes: The input shapes, at least one
+     * history: Receives the face history of each input shape into the result
+     * balanced: If true the shapes are combined by a balanced pairwise reduction where the
+     *   independent operations of a level run concurrently, otherwise from left to right
+     */
+    static TopoDS_Shape reduceShapes(BooleanType type, const std::vector<TopoDS_Shape>& shapes,
+        std::vector<ShapeHistory>& history, bool balanced = true);
+    /// Same as above but without building the history
+    static TopoDS_Shape reduceShapes(BooleanType type, const std::vector<TopoDS_Shape>& shapes,
+        bool balanced = true);
+
+private:
+    struct BooleanStep;
+    static void reduceStep(BooleanStep&);
+    static TopoDS_Shape reduceShapes(BooleanType type, const std::vector<TopoDS_Shape>& shapes,
+        std::vector<ShapeHistory>* history, bool balanced);
 };
 
 class FilletBase : public Part::Feature
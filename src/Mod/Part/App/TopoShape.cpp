@@ -151,6 +151,8 @@
 # include <Transfer_FinderProcess.hxx>
 # include <APIHeaderSection_MakeHeader.hxx>
 
+#include <QtConcurrentMap>
+#include <QThread>
 #include <Base/Builder3D.h>
 #include <Base/FileInfo.h>
 #include <Base/Exception.h>
@@ -1345,12 +1347,96 @@ std::list<TopoDS_Wire> TopoShape::slice(const Base::Vector3d& dir, double d) con
     return cs.slice(d);
 }
 
+namespace Part {
+struct SliceTask {
+    double d;
+    std::list<TopoDS_Wire> wires;
+};
+
+// The boolean operations of a cross-section add pcurves to and change the
+// tolerances of their input, so each chunk of planes is cut from its own copy
+struct SliceChunk {
+    TopoDS_Shape shape;
+    Base::Vector3d dir;
+    std::vector<SliceTask> tasks;
+    std::string error;
+};
+
+static void sliceChunk(SliceChunk& chunk)
+{
+    try {
+        CrossSection cs(chunk.dir.x, chunk.dir.y, chunk.dir.z, chunk.shape);
+        for (std::vector<SliceTask>::iterator it = chunk.tasks.begin(); it != chunk.tasks.end(); ++it)
+            it->wires = cs.slice(it->d);
+    }
+    catch (Standard_Failure) {
+        Handle_Standard_Failure e = Standard_Failure::Caught();
+        chunk.error = e->GetMessageString() ? e->GetMessageString() : "Unknown OCC exception";
+    }
+}
+}
+
 TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<double>& d) const
 {
-    std::vector< std::list<TopoDS_Wire> > wire_list;
-    CrossSection cs(dir.x, dir.y, dir.z, this->_Shape);
+    // range of the shape along the direction, planes outside of it are skipped
+    double dmin = 0.0, dmax = -1.0;
+    Bnd_Box bounds;
+    BRepBndLib::Add(this->_Shape, bounds);
+    if (!bounds.IsVoid()) {
+        Standard_Real xmin, ymin, zmin, xmax, ymax, zmax;
+        bounds.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+        dmin = dmax = dir.x*xmin + dir.y*ymin + dir.z*zmin;
+        for (int i=1; i<8; i++) {
+            double dist = dir.x*(i&1 ? xmax : xmin)
+                        + dir.y*(i&2 ? ymax : ymin)
+                        + dir.z*(i&4 ? zmax : zmin);
+            dmin = std::min<double>(dmin, dist);
+            dmax = std::max<double>(dmax, dist);
+        }
+    }
+
+    std::vector<double> planes;
+    planes.reserve(d.size());
     for (std::vector<double>::const_iterator jt = d.begin(); jt != d.end(); ++jt) {
-        wire_list.push_back(cs.slice(*jt));
+        if (*jt >= dmin && *jt <= dmax)
+            planes.push_back(*jt);
+    }
+
+    // split the planes into one chunk of consecutive planes per thread
+    std::size_t numChunks = std::min<std::size_t>(planes.size(),
+        (std::size_t)std::max<int>(1, QThread::idealThreadCount()));
+    std::vector<SliceChunk> chunks(numChunks);
+    for (std::size_t i = 0; i < numChunks; i++) {
+        SliceChunk& chunk = chunks[i];
+        if (numChunks > 1) {
+            BRepBuilderAPI_Copy copy(this->_Shape);
+            chunk.shape = copy.Shape();
+        }
+        else {
+            chunk.shape = this->_Shape;
+        }
+        chunk.dir = dir;
+        std::size_t begin = planes.size() * i / numChunks;
+        std::size_t end = planes.size() * (i + 1) / numChunks;
+        for (std::size_t j = begin; j < end; j++) {
+            SliceTask task;
+            task.d = planes[j];
+            chunk.tasks.push_back(task);
+        }
+    }
+
+    if (chunks.size() > 1)
+        QtConcurrent::blockingMap(chunks, &sliceChunk);
+    else if (!chunks.empty())
+        sliceChunk(chunks.front());
+
+    std::vector< std::list<TopoDS_Wire> > wire_list;
+    wire_list.reserve(planes.size());
+    for (std::vector<SliceChunk>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        if (!it->error.empty())
+            Standard_Failure::Raise(it->error.c_str());
+        for (std::vector<SliceTask>::iterator jt = it->tasks.begin(); jt != it->tasks.end(); ++jt)
+            wire_list.push_back(jt->wires);
     }
 
     std::vector< std::list<TopoDS_Wire> >::const_iterator ft;
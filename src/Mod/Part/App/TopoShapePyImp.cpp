@@ -60,6 +60,7 @@
 #include <Base/Matrix.h>
 #include <Base/Rotation.h>
 #include <Base/MatrixPy.h>
+#include <Base/PyBuffer.h>
 #include <Base/Vector3D.h>
 #include <Base/VectorPy.h>
 #include <CXX/Extensions.hxx>
@@ -1377,6 +1378,50 @@ PyObject* TopoShapePy::tessellate(PyObject *args)
     }
 }
 
+PyObject* TopoShapePy::tessellateData(PyObject *args)
+{
+    float tolerance;
+    if (!PyArg_ParseTuple(args, "f",&tolerance))
+        return 0;
+
+    try {
+        std::vector<Base::Vector3d> Points;
+        std::vector<Data::ComplexGeoData::Facet> Facets;
+        getTopoShapePtr()->getFaces(Points, Facets,tolerance);
+
+        char *pntData, *facData;
+        Py::Object vertex(Base::createByteArray(3 * Points.size() * sizeof(double), pntData), true);
+        Py::Object facet(Base::createByteArray(3 * Facets.size() * sizeof(unsigned int), facData), true);
+        double* pnt = reinterpret_cast<double*>(pntData);
+        for (std::vector<Base::Vector3d>::const_iterator it = Points.begin();
+            it != Points.end(); ++it) {
+            *pnt++ = it->x;
+            *pnt++ = it->y;
+            *pnt++ = it->z;
+        }
+        unsigned int* fac = reinterpret_cast<unsigned int*>(facData);
+        for (std::vector<Data::ComplexGeoData::Facet>::const_iterator
+            it = Facets.begin(); it != Facets.end(); ++it) {
+            *fac++ = (unsigned int)it->I1;
+            *fac++ = (unsigned int)it->I2;
+            *fac++ = (unsigned int)it->I3;
+        }
+
+        Py::Tuple tuple(2);
+        tuple.setItem(0, vertex);
+        tuple.setItem(1, facet);
+        return Py::new_reference_to(tuple);
+    }
+    catch (Standard_Failure) {
+        Handle_Standard_Failure e = Standard_Failure::Caught();
+        PyErr_SetString(PartExceptionOCCError, e->GetMessageString());
+        return NULL;
+    }
+    catch (const Py::Exception&) {
+        return NULL;
+    }
+}
+
 PyObject* TopoShapePy::project(PyObject *args)
 {
     PyObject *obj;
@@ -19,7 +19,7 @@
 #   USA                                                                   *
 #**************************************************************************
 
-import FreeCAD, os, sys, unittest, Part
+import FreeCAD, os, sys, unittest, array, Part
 App = FreeCAD
 
 #---------------------------------------------------------------------------
@@ -40,3 +40,23 @@ class PartTestCases(unittest.TestCase):
 		#closing doc
 		FreeCAD.closeDocument("PartTest")
 		#print ("omit clos document for debuging")
+
+
+class PartBufferTestCases(unittest.TestCase):
+	def unpack(self, data, typecode):
+		values = array.array(typecode)
+		values.fromstring(str(data))
+		return values
+
+	def testTessellateData(self):
+		shape = Part.makeCylinder(2.0, 5.0)
+		points, facets = shape.tessellate(0.1)
+		data = shape.tessellateData(0.1)
+		pts = self.unpack(data[0], 'd')
+		fac = self.unpack(data[1], 'I')
+		self.failUnless(len(pts) == 3 * len(points))
+		self.failUnless(len(fac) == 3 * len(facets))
+		for i, p in enumerate(points):
+			self.failUnless((FreeCAD.Vector(pts[3*i], pts[3*i+1], pts[3*i+2]) - p).Length < 1e-9)
+		for i, f in enumerate(facets):
+			self.failUnless(tuple(fac[3*i:3*i+3]) == tuple(f))
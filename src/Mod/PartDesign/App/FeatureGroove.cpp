@@ -105,38 +105,56 @@ App::DocumentObjectExecReturn *Groove::execute(void)
     gp_Dir dir(v.x,v.y,v.z);
 
     try {
-        TopoDS_Shape sketchshape = makeFace(wires);
-        if (sketchshape.IsNull())
-            return new App::DocumentObjectExecReturn("Creating a face from sketch failed");
-
-        // Rotate the face by half the angle to get Groove symmetric to sketch plane
-        if (Midplane.getValue()) {
-            gp_Trsf mov;
-            mov.SetRotation(gp_Ax1(pnt, dir), Base::toRadians<double>(Angle.getValue()) * (-1.0) / 2.0);
-            TopLoc_Location loc(mov);
-            sketchshape.Move(loc);
-        }
-
         this->positionBySketch();
         TopLoc_Location invObjLoc = this->getLocation().Inverted();
-        pnt.Transform(invObjLoc.Transformation());
-        dir.Transform(invObjLoc.Transformation());
+        TopoDS_Shape supportShape = support;
         support.Move(invObjLoc);
-        sketchshape.Move(invObjLoc);
 
-        // Check distance between sketchshape and axis - to avoid failures and crashes
-        if (checkLineCrossesFace(gp_Lin(pnt, dir), TopoDS::Face(sketchshape)))
-            return new App::DocumentObjectExecReturn("Revolve axis intersects the sketch");
+        // the revolved solid doesn't depend on the support
+        std::vector<double> values;
+        values.push_back(angle);
+        values.push_back(b.x); values.push_back(b.y); values.push_back(b.z);
+        values.push_back(v.x); values.push_back(v.y); values.push_back(v.z);
+        values.push_back(Midplane.getValue() ? 1.0 : 0.0);
+        std::string key = getToolKey("", values);
+
+        TopoDS_Shape result;
+        if (!getCachedTool(key, result)) {
+            TopoDS_Shape sketchshape = makeFace(wires);
+            if (sketchshape.IsNull())
+                return new App::DocumentObjectExecReturn("Creating a face from sketch failed");
+
+            // Rotate the face by half the angle to get Groove symmetric to sketch plane
+            if (Midplane.getValue()) {
+                gp_Trsf mov;
+                mov.SetRotation(gp_Ax1(pnt, dir), Base::toRadians<double>(Angle.getValue()) * (-1.0) / 2.0);
+                TopLoc_Location loc(mov);
+                sketchshape.Move(loc);
+            }
+
+            pnt.Transform(invObjLoc.Transformation());
+            dir.Transform(invObjLoc.Transformation());
+            sketchshape.Move(invObjLoc);
 
-        // revolve the face to a solid
-        BRepPrimAPI_MakeRevol RevolMaker(sketchshape, gp_Ax1(pnt, dir), angle);
+            // Check distance between sketchshape and axis - to avoid failures and crashes
+            if (checkLineCrossesFace(gp_Lin(pnt, dir), TopoDS::Face(sketchshape)))
+                return new App::DocumentObjectExecReturn("Revolve axis intersects the sketch");
 
-        if (RevolMaker.IsDone()) {
-            TopoDS_Shape result = RevolMaker.Shape();
-            // set the subtractive shape property for later usage in e.g. pattern
+            // revolve the face to a solid
+            BRepPrimAPI_MakeRevol RevolMaker(sketchshape, gp_Ax1(pnt, dir), angle);
+            if (!RevolMaker.IsDone())
+                return new App::DocumentObjectExecReturn("Could not revolve the sketch!");
+
+            result = RevolMaker.Shape();
             result = refineShapeIfActive(result);
-            this->SubShape.setValue(result);
+            setCachedTool(key, result);
+        }
 
+        // set the subtractive shape property for later usage in e.g. pattern
+        this->SubShape.setValue(result);
+
+        TopoDS_Shape solRes;
+        if (!getCachedResult(supportShape, solRes)) {
             // cut out groove to get one result object
             BRepAlgoAPI_Cut mkCut(support, result);
             // Let's check if the fusion has been successful
@@ -144,15 +162,14 @@ App::DocumentObjectExecReturn *Groove::execute(void)
                 throw Base::Exception("Cut out of support failed");
 
             // we have to get the solids (fuse sometimes creates compounds)
-            TopoDS_Shape solRes = this->getSolid(mkCut.Shape());
+            solRes = this->getSolid(mkCut.Shape());
             if (solRes.IsNull())
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
 
             solRes = refineShapeIfActive(solRes);
-            this->Shape.setValue(solRes);
+            setCachedResult(supportShape, solRes);
         }
-        else
-            return new App::DocumentObjectExecReturn("Could not revolve the sketch!");
+        this->Shape.setValue(solRes);
 
         return App::DocumentObject::StdReturn;
     }
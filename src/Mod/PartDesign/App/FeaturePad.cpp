@@ -112,19 +112,37 @@ App::DocumentObjectExecReturn *Pad::execute(void)
     TopLoc_Location invObjLoc = this->getLocation().Inverted();
 
     try {
+        TopoDS_Shape supportShape = support;
         support.Move(invObjLoc);
 
         gp_Dir dir(SketchVector.x,SketchVector.y,SketchVector.z);
         dir.Transform(invObjLoc.Transformation());
 
-        TopoDS_Shape sketchshape = makeFace(wires);
-        if (sketchshape.IsNull())
-            return new App::DocumentObjectExecReturn("Pad: Creating a face from sketch failed");
-        sketchshape.Move(invObjLoc);
-
+        // unlike the up-to methods the prism of the other methods doesn't depend on the support
         TopoDS_Shape prism;
         std::string method(Type.getValueAsString());
-        if (method == "UpToFirst" || method == "UpToLast" || method == "UpToFace") {
+        bool upTo = (method == "UpToFirst" || method == "UpToLast" || method == "UpToFace");
+        bool cached = false;
+        std::string key;
+        if (!upTo) {
+            std::vector<double> values;
+            values.push_back(L);
+            values.push_back(L2);
+            values.push_back(Midplane.getValue() ? 1.0 : 0.0);
+            values.push_back(Reversed.getValue() ? 1.0 : 0.0);
+            key = getToolKey(method, values);
+            cached = getCachedTool(key, prism);
+        }
+
+        TopoDS_Shape sketchshape;
+        if (!cached) {
+            sketchshape = makeFace(wires);
+            if (sketchshape.IsNull())
+                return new App::DocumentObjectExecReturn("Pad: Creating a face from sketch failed");
+            sketchshape.Move(invObjLoc);
+        }
+
+        if (upTo) {
             TopoDS_Face supportface = getSupportFace();
             supportface.Move(invObjLoc);
 
@@ -153,7 +171,7 @@ App::DocumentObjectExecReturn *Pad::execute(void)
             if (!PrismMaker.IsDone())
                 return new App::DocumentObjectExecReturn("Pad: Up to face: Could not extrude the sketch!");
             prism = PrismMaker.Shape();
-        } else {
+        } else if (!cached) {
             generatePrism(prism, sketchshape, method, dir, L, L2,
                           Midplane.getValue(), Reversed.getValue());
         }
@@ -162,23 +180,32 @@ App::DocumentObjectExecReturn *Pad::execute(void)
             return new App::DocumentObjectExecReturn("Pad: Resulting shape is empty");
 
         // set the additive shape property for later usage in e.g. pattern
-        prism = refineShapeIfActive(prism);
+        if (!cached) {
+            prism = refineShapeIfActive(prism);
+            if (!upTo)
+                setCachedTool(key, prism);
+        }
         this->AddShape.setValue(prism);
 
         // if the sketch has a support fuse them to get one result object
         if (!support.IsNull()) {
-            // Let's call algorithm computing a fuse operation:
-            BRepAlgoAPI_Fuse mkFuse(support, prism);
-            // Let's check if the fusion has been successful
-            if (!mkFuse.IsDone())
-                return new App::DocumentObjectExecReturn("Pad: Fusion with support failed");
-            TopoDS_Shape result = mkFuse.Shape();
-            // we have to get the solids (fuse sometimes creates compounds)
-            TopoDS_Shape solRes = this->getSolid(result);
-            // lets check if the result is a solid
-            if (solRes.IsNull())
-                return new App::DocumentObjectExecReturn("Pad: Resulting shape is not a solid");
-            solRes = refineShapeIfActive(solRes);
+            TopoDS_Shape solRes;
+            if (upTo || !getCachedResult(supportShape, solRes)) {
+                // Let's call algorithm computing a fuse operation:
+                BRepAlgoAPI_Fuse mkFuse(support, prism);
+                // Let's check if the fusion has been successful
+                if (!mkFuse.IsDone())
+                    return new App::DocumentObjectExecReturn("Pad: Fusion with support failed");
+                TopoDS_Shape result = mkFuse.Shape();
+                // we have to get the solids (fuse sometimes creates compounds)
+                solRes = this->getSolid(result);
+                // lets check if the result is a solid
+                if (solRes.IsNull())
+                    return new App::DocumentObjectExecReturn("Pad: Resulting shape is not a solid");
+                solRes = refineShapeIfActive(solRes);
+                if (!upTo)
+                    setCachedResult(supportShape, solRes);
+            }
             this->Shape.setValue(solRes);
         } else {
             this->Shape.setValue(prism);
@@ -111,18 +111,36 @@ App::DocumentObjectExecReturn *Pocket::execute(void)
     TopLoc_Location invObjLoc = this->getLocation().Inverted();
 
     try {
+        TopoDS_Shape supportShape = support;
         support.Move(invObjLoc);
 
         gp_Dir dir(SketchVector.x,SketchVector.y,SketchVector.z);
         dir.Transform(invObjLoc.Transformation());
 
-        TopoDS_Shape sketchshape = makeFace(wires);
-        if (sketchshape.IsNull())
-            return new App::DocumentObjectExecReturn("Pocket: Creating a face from sketch failed");
-        sketchshape.Move(invObjLoc);
-
+        // unlike the up-to methods the prism of the other methods doesn't depend on the support
+        TopoDS_Shape prism;
         std::string method(Type.getValueAsString());
-        if (method == "UpToFirst" || method == "UpToFace") {
+        bool upTo = (method == "UpToFirst" || method == "UpToFace");
+        bool cached = false;
+        std::string key;
+        if (!upTo) {
+            std::vector<double> values;
+            values.push_back(L);
+            values.push_back(Midplane.getValue() ? 1.0 : 0.0);
+            values.push_back(Reversed.getValue() ? 1.0 : 0.0);
+            key = getToolKey(method, values);
+            cached = getCachedTool(key, prism);
+        }
+
+        TopoDS_Shape sketchshape;
+        if (!cached) {
+            sketchshape = makeFace(wires);
+            if (sketchshape.IsNull())
+                return new App::DocumentObjectExecReturn("Pocket: Creating a face from sketch failed");
+            sketchshape.Move(invObjLoc);
+        }
+
+        if (upTo) {
             TopoDS_Face supportface = getSupportFace();
             supportface.Move(invObjLoc);
 
@@ -142,7 +160,7 @@ App::DocumentObjectExecReturn *Pocket::execute(void)
 
             if (!PrismMaker.IsDone())
                 return new App::DocumentObjectExecReturn("Pocket: Up to face: Could not extrude the sketch!");
-            TopoDS_Shape prism = PrismMaker.Shape();
+            prism = PrismMaker.Shape();
             prism = refineShapeIfActive(prism);
 
             // And the really expensive way to get the SubShape...
@@ -154,26 +172,32 @@ App::DocumentObjectExecReturn *Pocket::execute(void)
             this->SubShape.setValue(result);
             this->Shape.setValue(prism);
         } else {
-            TopoDS_Shape prism;
-            generatePrism(prism, sketchshape, method, dir, L, 0.0,
-                          Midplane.getValue(), Reversed.getValue());
-            if (prism.IsNull())
-                return new App::DocumentObjectExecReturn("Pocket: Resulting shape is empty");
+            if (!cached) {
+                generatePrism(prism, sketchshape, method, dir, L, 0.0,
+                              Midplane.getValue(), Reversed.getValue());
+                if (prism.IsNull())
+                    return new App::DocumentObjectExecReturn("Pocket: Resulting shape is empty");
+                prism = refineShapeIfActive(prism);
+                setCachedTool(key, prism);
+            }
 
             // set the subtractive shape property for later usage in e.g. pattern
-            prism = refineShapeIfActive(prism);
             this->SubShape.setValue(prism);
 
             // Cut the SubShape out of the support
-            BRepAlgoAPI_Cut mkCut(support, prism);
-            if (!mkCut.IsDone())
-                return new App::DocumentObjectExecReturn("Pocket: Cut out of support failed");
-            TopoDS_Shape result = mkCut.Shape();
-            // we have to get the solids (fuse sometimes creates compounds)
-            TopoDS_Shape solRes = this->getSolid(result);
-            if (solRes.IsNull())
-                return new App::DocumentObjectExecReturn("Pocket: Resulting shape is not a solid");
-            solRes = refineShapeIfActive(solRes);
+            TopoDS_Shape solRes;
+            if (!getCachedResult(supportShape, solRes)) {
+                BRepAlgoAPI_Cut mkCut(support, prism);
+                if (!mkCut.IsDone())
+                    return new App::DocumentObjectExecReturn("Pocket: Cut out of support failed");
+                TopoDS_Shape result = mkCut.Shape();
+                // we have to get the solids (fuse sometimes creates compounds)
+                solRes = this->getSolid(result);
+                if (solRes.IsNull())
+                    return new App::DocumentObjectExecReturn("Pocket: Resulting shape is not a solid");
+                solRes = refineShapeIfActive(solRes);
+                setCachedResult(supportShape, solRes);
+            }
             remapSupportShape(solRes);
             this->Shape.setValue(solRes);
         }
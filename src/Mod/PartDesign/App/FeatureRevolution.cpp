@@ -111,54 +111,71 @@ App::DocumentObjectExecReturn *Revolution::execute(void)
     gp_Dir dir(v.x,v.y,v.z);
 
     try {
-        TopoDS_Shape sketchshape = makeFace(wires);
-        if (sketchshape.IsNull())
-            return new App::DocumentObjectExecReturn("Creating a face from sketch failed");
-
-        // Rotate the face by half the angle to get Revolution symmetric to sketch plane
-        if (Midplane.getValue()) {
-            gp_Trsf mov;
-            mov.SetRotation(gp_Ax1(pnt, dir), Base::toRadians<double>(Angle.getValue()) * (-1.0) / 2.0);
-            TopLoc_Location loc(mov);
-            sketchshape.Move(loc);
-        }
-
         this->positionBySketch();
         TopLoc_Location invObjLoc = this->getLocation().Inverted();
-        pnt.Transform(invObjLoc.Transformation());
-        dir.Transform(invObjLoc.Transformation());
+        TopoDS_Shape supportShape = support;
         support.Move(invObjLoc);
-        sketchshape.Move(invObjLoc);
 
-        // Check distance between sketchshape and axis - to avoid failures and crashes
-        if (checkLineCrossesFace(gp_Lin(pnt, dir), TopoDS::Face(sketchshape)))
-            return new App::DocumentObjectExecReturn("Revolve axis intersects the sketch");
+        // the revolved solid doesn't depend on the support
+        std::vector<double> values;
+        values.push_back(angle);
+        values.push_back(b.x); values.push_back(b.y); values.push_back(b.z);
+        values.push_back(v.x); values.push_back(v.y); values.push_back(v.z);
+        values.push_back(Midplane.getValue() ? 1.0 : 0.0);
+        std::string key = getToolKey("", values);
+
+        TopoDS_Shape result;
+        if (!getCachedTool(key, result)) {
+            TopoDS_Shape sketchshape = makeFace(wires);
+            if (sketchshape.IsNull())
+                return new App::DocumentObjectExecReturn("Creating a face from sketch failed");
+
+            // Rotate the face by half the angle to get Revolution symmetric to sketch plane
+            if (Midplane.getValue()) {
+                gp_Trsf mov;
+                mov.SetRotation(gp_Ax1(pnt, dir), Base::toRadians<double>(Angle.getValue()) * (-1.0) / 2.0);
+                TopLoc_Location loc(mov);
+                sketchshape.Move(loc);
+            }
+
+            pnt.Transform(invObjLoc.Transformation());
+            dir.Transform(invObjLoc.Transformation());
+            sketchshape.Move(invObjLoc);
 
-        // revolve the face to a solid
-        BRepPrimAPI_MakeRevol RevolMaker(sketchshape, gp_Ax1(pnt, dir), angle);
+            // Check distance between sketchshape and axis - to avoid failures and crashes
+            if (checkLineCrossesFace(gp_Lin(pnt, dir), TopoDS::Face(sketchshape)))
+                return new App::DocumentObjectExecReturn("Revolve axis intersects the sketch");
 
-        if (RevolMaker.IsDone()) {
-            TopoDS_Shape result = RevolMaker.Shape();
+            // revolve the face to a solid
+            BRepPrimAPI_MakeRevol RevolMaker(sketchshape, gp_Ax1(pnt, dir), angle);
+            if (!RevolMaker.IsDone())
+                return new App::DocumentObjectExecReturn("Could not revolve the sketch!");
+
+            result = RevolMaker.Shape();
             result = refineShapeIfActive(result);
-            // set the additive shape property for later usage in e.g. pattern
-            this->AddShape.setValue(result);
+            setCachedTool(key, result);
+        }
+
+        // set the additive shape property for later usage in e.g. pattern
+        this->AddShape.setValue(result);
 
-            // if the sketch has a support fuse them to get one result object (PAD!)
-            if (!support.IsNull()) {
+        // if the sketch has a support fuse them to get one result object (PAD!)
+        if (!support.IsNull()) {
+            TopoDS_Shape solRes;
+            if (!getCachedResult(supportShape, solRes)) {
                 // Let's call algorithm computing a fuse operation:
                 BRepAlgoAPI_Fuse mkFuse(support, result);
                 // Let's check if the fusion has been successful
                 if (!mkFuse.IsDone())
                     throw Base::Exception("Fusion with support failed");
-                result = mkFuse.Shape();
-                result = refineShapeIfActive(result);
+                solRes = mkFuse.Shape();
+                solRes = refineShapeIfActive(solRes);
+                setCachedResult(supportShape, solRes);
             }
-
-            this->Shape.setValue(result);
+            result = solRes;
         }
-        else
-            return new App::DocumentObjectExecReturn("Could not revolve the sketch!");
 
+        this->Shape.setValue(result);
         return App::DocumentObject::StdReturn;
     }
     catch (Standard_Failure) {
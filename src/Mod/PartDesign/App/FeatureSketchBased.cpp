@@ -59,6 +59,8 @@
 # include <BRepAdaptor_CompCurve.hxx>
 # include <BRepAdaptor_Curve.hxx>
 # include <Standard_Version.hxx>
+# include <BRepTools.hxx>
+# include <sstream>
 #endif
 
 #include <BRepExtrema_DistShapeShape.hxx>
@@ -942,3 +944,55 @@ TopoDS_Shape SketchBased::refineShapeIfActive(const TopoDS_Shape& oldShape) cons
 
     return oldShape;
 }
+
+std::string SketchBased::getToolKey(const std::string& method, const std::vector<double>& values) const
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/PartDesign");
+
+    std::stringstream str;
+    str.precision(17);
+    str << method << " " << hGrp->GetBool("RefineModel", false);
+    for (std::vector<double>::const_iterator it = values.begin(); it != values.end(); ++it)
+        str << " " << *it;
+
+    const Base::Placement& plm = this->Placement.getValue();
+    double q0, q1, q2, q3;
+    plm.getRotation().getValue(q0, q1, q2, q3);
+    str << " " << plm.getPosition().x << " " << plm.getPosition().y << " " << plm.getPosition().z
+        << " " << q0 << " " << q1 << " " << q2 << " " << q3 << std::endl;
+
+    // the geometry of the sketch with its placement
+    BRepTools::Write(getVerifiedSketch()->Shape.getValue(), str);
+    return str.str();
+}
+
+bool SketchBased::getCachedTool(const std::string& key, TopoDS_Shape& tool) const
+{
+    if (cache.tool.IsNull() || cache.key != key)
+        return false;
+    tool = cache.tool;
+    return true;
+}
+
+void SketchBased::setCachedTool(const std::string& key, const TopoDS_Shape& tool)
+{
+    cache.key = key;
+    cache.tool = tool;
+    cache.support.Nullify();
+    cache.result.Nullify();
+}
+
+bool SketchBased::getCachedResult(const TopoDS_Shape& support, TopoDS_Shape& result) const
+{
+    if (cache.result.IsNull() || !cache.support.IsSame(support))
+        return false;
+    result = cache.result;
+    return true;
+}
+
+void SketchBased::setCachedResult(const TopoDS_Shape& support, const TopoDS_Shape& result)
+{
+    cache.support = support;
+    cache.result = result;
+}
@@ -24,6 +24,9 @@
 #ifndef PARTDESIGN_SketchBased_H
 #define PARTDESIGN_SketchBased_H
 
+#include <string>
+#include <vector>
+#include <TopoDS_Shape.hxx>
 #include <App/PropertyStandard.h>
 #include <Mod/Part/App/Part2DObject.h>
 #include "Feature.h"
@@ -88,6 +91,23 @@ protected:
     void remapSupportShape(const TopoDS_Shape&);
     TopoDS_Shape refineShapeIfActive(const TopoDS_Shape&) const;
 
+    /** @name Result cache
+     * The tool shape (the extruded or revolved solid) only depends on the sketch
+     * geometry, the placement of the feature and its parameters. It is kept with
+     * a key of these inputs, so a recompute caused by a changed support only redoes
+     * the boolean operation. The result of the boolean operation is kept too and is
+     * reused as long as the support is the very same shape.
+     */
+    //@{
+    /// key of the sketch geometry, the feature placement, the refine setting and the given parameters
+    std::string getToolKey(const std::string& method, const std::vector<double>& values) const;
+    bool getCachedTool(const std::string& key, TopoDS_Shape& tool) const;
+    /// sets the tool of the key, this drops the cached result
+    void setCachedTool(const std::string& key, const TopoDS_Shape& tool);
+    bool getCachedResult(const TopoDS_Shape& support, TopoDS_Shape& result) const;
+    void setCachedResult(const TopoDS_Shape& support, const TopoDS_Shape& result);
+    //@}
+
     /// Extract a face from a given LinkSub
     static void getUpToFaceFromLinkSub(TopoDS_Face& upToFace,
                                        const App::PropertyLinkSub& refFace);
@@ -122,6 +142,14 @@ protected:
 
 private:
     class Wire_Compare;
+
+    struct ToolCache {
+        std::string key;
+        TopoDS_Shape tool;
+        TopoDS_Shape support;
+        TopoDS_Shape result;
+    };
+    ToolCache cache;
 };
 
 } //namespace PartDesign
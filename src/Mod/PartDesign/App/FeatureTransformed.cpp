@@ -32,8 +32,15 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <Precision.hxx>
 # include <BRepBuilderAPI_Copy.hxx>
+# include <BRepBndLib.hxx>
+# include <Bnd_Box.hxx>
+# include <Standard_Failure.hxx>
+# include <algorithm>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 
 #include "FeatureTransformed.h"
 #include "FeatureMultiTransform.h"
@@ -53,6 +60,85 @@ using namespace PartDesign;
 
 namespace PartDesign {
 
+/// Two shapes to be checked for intersection
+struct ShapePair {
+    ShapePair(const TopoDS_Shape& f, const TopoDS_Shape& s, bool touch)
+        : first(f), second(s), touch_is_intersection(touch), intersects(false) {}
+    TopoDS_Shape first;
+    TopoDS_Shape second;
+    bool touch_is_intersection;
+    bool intersects;
+    std::string error;
+};
+
+static void checkShapePair(ShapePair& pair)
+{
+    try {
+        pair.intersects = Part::checkIntersection(pair.first, pair.second,
+                                                  false, pair.touch_is_intersection);
+    }
+    catch (Standard_Failure) {
+        Handle_Standard_Failure e = Standard_Failure::Caught();
+        pair.error = e->GetMessageString() ? e->GetMessageString() : "Intersection check failed";
+    }
+}
+
+/**
+ * Runs the exact intersection checks of the given pairs. The checks are independent boolean
+ * operations and thus are distributed over all cores. The booleans add pcurves to and change
+ * the tolerances of their arguments, and the support and the transformed shapes share their
+ * TShapes, so every pair gets its own copies of the shapes before the checks run in parallel.
+ */
+static void checkShapePairs(std::vector<ShapePair>& pairs)
+{
+    if (pairs.size() > 1 && QThread::idealThreadCount() > 1) {
+        for (std::vector<ShapePair>::iterator it = pairs.begin(); it != pairs.end(); ++it) {
+            it->first = BRepBuilderAPI_Copy(it->first).Shape();
+            it->second = BRepBuilderAPI_Copy(it->second).Shape();
+        }
+        QtConcurrent::blockingMap(pairs, checkShapePair);
+    }
+    else {
+        std::for_each(pairs.begin(), pairs.end(), checkShapePair);
+    }
+
+    for (std::vector<ShapePair>::const_iterator it = pairs.begin(); it != pairs.end(); ++it) {
+        if (!it->error.empty())
+            throw Base::Exception(it->error);
+    }
+}
+
+/**
+ * Sweep and prune: the boxes are sorted by their lower x bound, so every box only needs to be
+ * compared to the boxes which start before it ends in x direction. Returns the index pairs of the
+ * overlapping boxes.
+ */
+static void findOverlappingBoxes(const std::vector<Bnd_Box>& boxes,
+                                 std::vector<std::pair<std::size_t, std::size_t> >& pairs)
+{
+    std::vector<std::pair<double, std::size_t> > sweep;
+    std::vector<double> xmax(boxes.size());
+    sweep.reserve(boxes.size());
+    for (std::size_t i = 0; i < boxes.size(); i++) {
+        if (boxes[i].IsVoid())
+            continue;
+        Standard_Real x1, y1, z1, x2, y2, z2;
+        boxes[i].Get(x1, y1, z1, x2, y2, z2);
+        sweep.push_back(std::make_pair(x1, i));
+        xmax[i] = x2;
+    }
+    std::sort(sweep.begin(), sweep.end());
+
+    for (std::size_t i = 0; i < sweep.size(); i++) {
+        std::size_t b1 = sweep[i].second;
+        for (std::size_t j = i + 1; j < sweep.size() && sweep[j].first <= xmax[b1]; j++) {
+            std::size_t b2 = sweep[j].second;
+            if (!boxes[b1].IsOut(boxes[b2]))
+                pairs.push_back(std::make_pair(std::min(b1, b2), std::max(b1, b2)));
+        }
+    }
+}
+
 PROPERTY_SOURCE(PartDesign::Transformed, PartDesign::Feature)
 
 Transformed::Transformed() : rejected(0)
@@ -194,18 +280,33 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             if (!mkTrf.IsDone())
                 return new App::DocumentObjectExecReturn("Transformation failed", (*o));
 
-            // Check for intersection with support
-            if (!Part::checkIntersection(support, mkTrf.Shape(), false, true)) {
+            v_transformations.push_back(t);
+            v_transformedShapes.push_back(mkTrf.Shape());
+        }
+
+        // Check for intersection with support
+        std::vector<ShapePair> supportChecks;
+        supportChecks.reserve(v_transformedShapes.size());
+        for (std::vector<TopoDS_Shape>::const_iterator s = v_transformedShapes.begin(); s != v_transformedShapes.end(); s++)
+            supportChecks.push_back(ShapePair(support, *s, true));
+        checkShapePairs(supportChecks);
+
+        std::vector<std::vector<gp_Trsf>::const_iterator> v_intersecting;
+        std::vector<TopoDS_Shape> v_intersectingShapes;
+        for (std::size_t i = 0; i < supportChecks.size(); i++) {
+            if (!supportChecks[i].intersects) {
 #ifdef FC_DEBUG // do not write this in release mode because a message appears already in the task view
                 Base::Console().Warning("Transformed shape does not intersect support %s: Removed\n", (*o)->getNameInDocument());
 #endif
-                nointersect_trsfms.insert(t);
+                nointersect_trsfms.insert(v_transformations[i]);
             } else {
-                v_transformations.push_back(t);
-                v_transformedShapes.push_back(mkTrf.Shape());
+                v_intersecting.push_back(v_transformations[i]);
+                v_intersectingShapes.push_back(v_transformedShapes[i]);
                 // Note: Transformations that do not intersect the support are ignored in the overlap tests
             }
         }
+        v_transformations.swap(v_intersecting);
+        v_transformedShapes.swap(v_intersectingShapes);
 
         if (v_transformedShapes.empty())
             break; // Skip the overlap check and go on to next original
@@ -223,45 +324,40 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
         } else {
             // For MultiTransform, just checking the first transformed shape is not sufficient - any two
             // features might overlap, even if the original and the first shape don't overlap!
-
-            std::set<std::vector<TopoDS_Shape>::iterator> rejected_iterators;
-
-            std::vector<TopoDS_Shape>::iterator s1 = v_transformedShapes.begin();
-            std::vector<TopoDS_Shape>::iterator s2 = s1;
-            s2++;
-            std::vector<std::vector<gp_Trsf>::const_iterator>::const_iterator t1 = v_transformations.begin();
-            std::vector<std::vector<gp_Trsf>::const_iterator>::const_iterator t2 = t1;
-            t2++;
-            for (; s2 != v_transformedShapes.end();) {
-                // Check intersection with the original
-                if (Part::checkIntersection(shape, *s1, false, false)) {
-                    rejected_iterators.insert(s1);
-                    overlapping_trsfms.insert(*t1);
-                }
-                // Check intersection with other transformations
-                for (; s2 != v_transformedShapes.end(); s2++, t2++)
-                    if (Part::checkIntersection(*s1, *s2, false, false)) {
-                        rejected_iterators.insert(s1);
-                        rejected_iterators.insert(s2);
-                        overlapping_trsfms.insert(*t1);
-                        overlapping_trsfms.insert(*t2);
-                    }
-                s1++;
-                s2 = s1;
-                s2++;
-                t1++;
-                t2 = t1;
-                t2++;
+            // Only the pairs whose bounding boxes overlap need the expensive boolean check. The
+            // original is handled as the last shape of the list.
+            std::vector<Bnd_Box> boxes(v_transformedShapes.size() + 1);
+            for (std::size_t i = 0; i < v_transformedShapes.size(); i++)
+                BRepBndLib::Add(v_transformedShapes[i], boxes[i]);
+            BRepBndLib::Add(shape, boxes.back());
+
+            std::vector<std::pair<std::size_t, std::size_t> > candidates;
+            findOverlappingBoxes(boxes, candidates);
+
+            std::vector<ShapePair> overlapChecks;
+            overlapChecks.reserve(candidates.size());
+            for (std::vector<std::pair<std::size_t, std::size_t> >::const_iterator c = candidates.begin(); c != candidates.end(); c++) {
+                const TopoDS_Shape& s1 = c->first < v_transformedShapes.size() ? v_transformedShapes[c->first] : shape;
+                const TopoDS_Shape& s2 = c->second < v_transformedShapes.size() ? v_transformedShapes[c->second] : shape;
+                overlapChecks.push_back(ShapePair(s1, s2, false));
             }
-            // Check intersection of last transformation with the original
-            if (Part::checkIntersection(shape, *s1, false, false)) {
-                rejected_iterators.insert(s1);
-                overlapping_trsfms.insert(*t1);
+            checkShapePairs(overlapChecks);
+
+            std::set<std::size_t> rejected_indices;
+            for (std::size_t i = 0; i < overlapChecks.size(); i++) {
+                if (overlapChecks[i].intersects) {
+                    if (candidates[i].first < v_transformedShapes.size())
+                        rejected_indices.insert(candidates[i].first);
+                    if (candidates[i].second < v_transformedShapes.size())
+                        rejected_indices.insert(candidates[i].second);
+                }
             }
 
-            for (std::set<std::vector<TopoDS_Shape>::iterator>::reverse_iterator it = rejected_iterators.rbegin();
-                 it != rejected_iterators.rend(); it++)
-                v_transformedShapes.erase(*it);
+            for (std::set<std::size_t>::reverse_iterator it = rejected_indices.rbegin();
+                 it != rejected_indices.rend(); it++) {
+                overlapping_trsfms.insert(v_transformations[*it]);
+                v_transformedShapes.erase(v_transformedShapes.begin() + *it);
+            }
         }
 
         if (v_transformedShapes.empty())
@@ -278,11 +374,30 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
         TopoDS_Shape result;
 
         if (fuse) {
-            BRepAlgoAPI_Fuse mkFuse(support, transformedShapes);
-            if (!mkFuse.IsDone())
-                return new App::DocumentObjectExecReturn("Fusion with support failed", *o);
+            Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+                .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
+            if (hGrp->GetBool("BalancedReduction", true)) {
+                // Fuse the support and the transformed shapes by a balanced reduction instead of
+                // one operation with the whole compound. The feature keeps no face history.
+                std::vector<TopoDS_Shape> fuseShapes;
+                fuseShapes.reserve(v_transformedShapes.size() + 1);
+                fuseShapes.push_back(support);
+                fuseShapes.insert(fuseShapes.end(), v_transformedShapes.begin(), v_transformedShapes.end());
+                try {
+                    result = reduceShapes(BooleanFuse, fuseShapes);
+                }
+                catch (const Base::Exception&) {
+                    return new App::DocumentObjectExecReturn("Fusion with support failed", *o);
+                }
+            }
+            else {
+                BRepAlgoAPI_Fuse mkFuse(support, transformedShapes);
+                if (!mkFuse.IsDone())
+                    return new App::DocumentObjectExecReturn("Fusion with support failed", *o);
+                result = mkFuse.Shape();
+            }
             // we have to get the solids (fuse sometimes creates compounds)
-            result = this->getSolid(mkFuse.Shape());
+            result = this->getSolid(result);
             // lets check if the result is a solid
             if (result.IsNull())
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid", *o);
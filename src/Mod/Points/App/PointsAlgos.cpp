@@ -26,6 +26,8 @@
 #ifdef FC_OS_LINUX
 # include <unistd.h>
 #endif
+# include <algorithm>
+# include <iterator>
 # include <sstream>
 #endif
 
@@ -36,9 +38,12 @@
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
 #include <Base/Console.h>
+#include <Base/FutureWatcherProgress.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
 
+#include <QThread>
+#include <QtConcurrentMap>
 #include <boost/regex.hpp>
 
 using namespace Points;
@@ -57,6 +62,46 @@ void PointsAlgos::Load(PointKernel &points, const char *FileName)
         throw Base::Exception("Unknown ending");
 }
 
+namespace Points {
+// A range of lines of an ASCII file that one thread parses
+struct AsciiChunk {
+    const char* begin;
+    const char* end;
+    const boost::regex* rx;
+    Base::ConcurrentProgress* progress;
+    std::vector<Base::Vector3d> points;
+    bool failed;
+};
+}
+
+static void parseAsciiChunk(AsciiChunk& chunk)
+{
+    boost::cmatch what;
+    std::string line;
+    Base::Vector3d pt;
+
+    try {
+        const char* pos = chunk.begin;
+        while (pos < chunk.end) {
+            if (chunk.progress->isCanceled())
+                return;
+            const char* eol = std::find(pos, chunk.end, '\n');
+            line.assign(pos, eol);
+            if (boost::regex_match(line.c_str(), what, *chunk.rx)) {
+                pt.x = std::atof(what[1].first);
+                pt.y = std::atof(what[4].first);
+                pt.z = std::atof(what[7].first);
+                chunk.points.push_back(pt);
+            }
+            chunk.progress->add();
+            pos = (eol == chunk.end ? eol : eol + 1);
+        }
+    }
+    catch (...) {
+        chunk.failed = true;
+    }
+}
+
 void PointsAlgos::LoadAscii(PointKernel &points, const char *FileName)
 {
     boost::regex rx("^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
@@ -64,50 +109,66 @@ void PointsAlgos::LoadAscii(PointKernel &points, const char *FileName)
                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
     //boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
     //boost::regex rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
 
-    Base::Vector3d pt;
-    int LineCnt=0;
-    std::string line;
+    // read the whole file at once, the trailing '\r' of a line is matched as white space
     Base::FileInfo fi(FileName);
+    Base::ifstream file(fi, std::ios::in | std::ios::binary);
+    std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const char* data = buffer.c_str();
+    std::size_t size = buffer.size();
 
-    Base::ifstream tmp_str(fi, std::ios::in);
-
-    // estimating size
-    while (std::getline(tmp_str,line))
+    std::size_t LineCnt = std::count(buffer.begin(), buffer.end(), '\n');
+    if (size > 0 && buffer[size-1] != '\n')
         LineCnt++;
 
-    // resize the PointKernel
-    points.resize(LineCnt);
-
-    Base::SequencerLauncher seq( "Loading points...", LineCnt );
-
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
+    // split the file into chunks of whole lines that are parsed concurrently
+    std::size_t numChunks = 1;
+    if (LineCnt > 10000)
+        numChunks = (std::size_t)std::max<int>(1, QThread::idealThreadCount()) * 4;
+    std::vector<AsciiChunk> chunks;
+    const char* begin = data;
+    for (std::size_t i = 1; i <= numChunks; i++) {
+        const char* end = data + size * i / numChunks;
+        if (end < begin)
+            continue;
+        end = std::find(end, data + size, '\n');
+        if (end != data + size)
+            end++;
+        AsciiChunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunk.rx = &rx;
+        chunk.progress = 0;
+        chunk.failed = false;
+        chunks.push_back(chunk);
+        begin = end;
+    }
 
-    try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
+    {
+        Base::ConcurrentProgress progress("Loading points...", LineCnt);
+        for (std::vector<AsciiChunk>::iterator it = chunks.begin(); it != chunks.end(); ++it)
+            it->progress = &progress;
+        if (chunks.size() > 1)
+            Base::waitForFinished(QtConcurrent::map(chunks, parseAsciiChunk));
+        else
+            std::for_each(chunks.begin(), chunks.end(), parseAsciiChunk);
+        if (progress.isCanceled())
+            throw Base::AbortException("Loading points canceled");
+    }
 
-                points.setPoint(LineCnt,pt);
-                seq.next();
-                LineCnt++;
-            }
+    std::size_t numPoints = 0;
+    for (std::vector<AsciiChunk>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        if (it->failed) {
+            points.clear();
+            throw Base::Exception("Reading in points failed.");
         }
-    }
-    catch (...) {
-        points.clear();
-        throw Base::Exception("Reading in points failed.");
+        numPoints += it->points.size();
     }
 
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size())
-        points.erase(LineCnt, points.size());
+    points.resize(numPoints);
+    int index = 0;
+    for (std::vector<AsciiChunk>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        for (std::vector<Base::Vector3d>::iterator jt = it->points.begin(); jt != it->points.end(); ++jt)
+            points.setPoint(index++, *jt);
+    }
 }
@@ -27,6 +27,7 @@
 #include <Base/Builder3D.h>
 #include <Base/VectorPy.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/PyBuffer.h>
 
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
@@ -168,6 +169,64 @@ PyObject* PointsPy::addPoints(PyObject * args)
     Py_Return;
 }
 
+namespace Points {
+template <class T>
+static void copyPoints(const PointKernel* points, T* out)
+{
+    for (PointKernel::const_point_iterator it = points->begin(); it != points->end(); ++it) {
+        *out++ = static_cast<T>(it->x);
+        *out++ = static_cast<T>(it->y);
+        *out++ = static_cast<T>(it->z);
+    }
+}
+}
+
+PyObject* PointsPy::getPointData(PyObject * args)
+{
+    PyObject *dbl = Py_False;
+    if (!PyArg_ParseTuple(args, "|O!", &PyBool_Type, &dbl))
+        return 0;
+
+    PY_TRY {
+        const PointKernel* points = getPointKernelPtr();
+        Py_ssize_t count = 3 * (Py_ssize_t)points->size();
+        char* data;
+        if (PyObject_IsTrue(dbl)) {
+            PyObject* array = Base::createByteArray(count * sizeof(double), data);
+            copyPoints(points, reinterpret_cast<double*>(data));
+            return array;
+        }
+        else {
+            PyObject* array = Base::createByteArray(count * sizeof(float), data);
+            copyPoints(points, reinterpret_cast<float*>(data));
+            return array;
+        }
+    } PY_CATCH;
+}
+
+PyObject* PointsPy::addPointData(PyObject * args)
+{
+    PyObject *obj;
+    if (!PyArg_ParseTuple(args, "O", &obj))
+        return 0;
+
+    PY_TRY {
+        Base::PyBufferReader buf(obj);
+        if (buf.size() % 3 != 0)
+            throw Py::ValueError("Number of coordinates is not a multiple of three");
+        std::vector<double> xyz(buf.size());
+        if (!xyz.empty())
+            buf.copyTo(&xyz[0]);
+
+        PointKernel* points = getPointKernelPtr();
+        points->reserve(points->size() + xyz.size() / 3);
+        for (std::size_t i = 0; i < xyz.size(); i += 3)
+            points->push_back(Base::Vector3d(xyz[i], xyz[i+1], xyz[i+2]));
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 Py::Int PointsPy::getCountPoints(void) const
 {
     return Py::Int((long)getPointKernelPtr()->size());
@@ -0,0 +1,90 @@
+#   (c) The FreeCAD developers 2014                            LGPL        *
+#                                                                         *
+#   This file is part of the FreeCAD CAx development system.              *
+#                                                                         *
+#   This program is free software; you can redistribute it and/or modify  *
+#   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#   as published by the Free Software Foundation; either version 2 of     *
+#   the License, or (at your option) any later version.                   *
+#   for detail see the LICENCE text file.                                 *
+#                                                                         *
+#   FreeCAD is distributed in the hope that it will be useful,            *
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#   GNU Library General Public License for more details.                  *
+#                                                                         *
+#   You should have received a copy of the GNU Library General Public     *
+#   License along with FreeCAD; if not, write to the Free Software        *
+#   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#   USA                                                                   *
+#**************************************************************************
+
+import FreeCAD, unittest, array, ctypes, os, tempfile, Points
+
+#---------------------------------------------------------------------------
+# define the test cases to test the FreeCAD Points module
+#---------------------------------------------------------------------------
+
+
+class PointsBufferTestCases(unittest.TestCase):
+	def setUp(self):
+		self.coords = [(i, 2.0 * i, -0.5 * i) for i in range(10)]
+		self.points = Points.Points()
+		self.points.addPoints(self.coords)
+
+	def unpack(self, data, typecode):
+		values = array.array(typecode)
+		values.fromstring(str(data))
+		return values
+
+	def testPointData(self):
+		pts = self.unpack(self.points.getPointData(True), 'd')
+		self.failUnless(len(pts) == 3 * self.points.CountPoints)
+		for i, p in enumerate(self.points.Points):
+			self.failUnless((FreeCAD.Vector(pts[3*i], pts[3*i+1], pts[3*i+2]) - p).Length < 1e-9)
+		flt = self.unpack(self.points.getPointData(), 'f')
+		self.failUnless(len(flt) == len(pts))
+		for p, q in zip(pts, flt):
+			self.failUnless(abs(p - q) < 1e-5)
+
+	def testAddPointData(self):
+		pts = self.unpack(self.points.getPointData(True), 'd')
+		other = Points.Points()
+		other.addPointData((ctypes.c_double * len(pts))(*pts))
+		other.addPointData((ctypes.c_float * 3)(1, 2, 3))
+		self.failUnless(other.CountPoints == self.points.CountPoints + 1)
+		for p, q in zip(other.Points, self.points.Points):
+			self.failUnless((p - q).Length < 1e-9)
+		self.failUnless((other.Points[-1] - FreeCAD.Vector(1, 2, 3)).Length < 1e-9)
+
+	def testInvalidData(self):
+		self.assertRaises(ValueError, Points.Points().addPointData, (ctypes.c_double * 4)())
+		self.assertRaises(TypeError, Points.Points().addPointData, (ctypes.c_bool * 3)())
+
+
+class PointsAsciiTestCases(unittest.TestCase):
+	def setUp(self):
+		self.fileName = os.path.join(tempfile.gettempdir(), "TestPointsAscii.asc")
+
+	def testLoadAscii(self):
+		# enough lines to be parsed in several chunks, with comments and Windows line endings
+		count = 25000
+		f = open(self.fileName, "wb")
+		f.write("# header\r\n")
+		for i in range(count):
+			f.write("%d.5 %d -%d.25e0\r\n" % (i, 2 * i, i))
+			if i % 1000 == 0:
+				f.write("# comment\r\n")
+		f.write("%d.5 0 0" % count) # no line ending at the end of the file
+		f.close()
+
+		pts = Points.Points()
+		pts.read(self.fileName)
+		self.failUnless(pts.CountPoints == count + 1)
+		for i in (0, 1, 999, 1000, 12345, count - 1):
+			self.failUnless((pts.Points[i] - FreeCAD.Vector(i + 0.5, 2 * i, -i - 0.25)).Length < 1e-9)
+		self.failUnless((pts.Points[count] - FreeCAD.Vector(count + 0.5, 0, 0)).Length < 1e-9)
+
+	def tearDown(self):
+		if os.path.exists(self.fileName):
+			os.remove(self.fileName)
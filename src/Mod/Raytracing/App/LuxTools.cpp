@@ -34,8 +34,11 @@
 # include <sstream>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/FutureWatcherProgress.h>
 #include <Base/Sequencer.h>
 #include <Base/Matrix.h>
 #include <App/ComplexGeoData.h>
@@ -66,73 +69,137 @@ std::string LuxTools::getCamera(const CamDef& Cam)
     return out.str();
 }
 
+namespace Raytracing {
+// A face of the exported shape and the text written for it
+struct LuxFace {
+    TopoDS_Face face;
+    bool meshed;
+    long nodes;
+    long offset;
+    std::vector<long> cons;
+    std::string points;
+    std::string normals;
+    std::string indices;
+    Base::ConcurrentProgress* progress;
+};
+}
+
+static void formatLuxFace(LuxFace& f)
+{
+    std::vector<gp_Vec> vertices, vertexnormals;
+    f.meshed = PovTools::transferToArray(f.face, vertices, vertexnormals, f.cons);
+    if (!f.meshed)
+        return;
+    f.nodes = (long)vertices.size();
+
+    // writing vertices
+    std::ostringstream P;
+    for (std::size_t i=0; i < vertices.size(); i++) {
+        P << vertices[i].X() << " " << vertices[i].Y() << " " << vertices[i].Z() << " ";
+    }
+    f.points = P.str();
+
+    // writing per vertex normals
+    std::ostringstream N;
+    for (std::size_t j=0; j < vertexnormals.size(); j++) {
+        N << vertexnormals[j].X() << " "  << vertexnormals[j].Y() << " " << vertexnormals[j].Z() << " ";
+    }
+    f.normals = N.str();
+}
+
+static void writeLuxFace(LuxFace& f)
+{
+    if (f.progress->isCanceled())
+        return;
+    formatLuxFace(f);
+    f.progress->add();
+}
+
+static void writeLuxIndices(LuxFace& f)
+{
+    // writing triangle indices
+    std::ostringstream triindices;
+    long vi = f.offset;
+    for (std::size_t k=0; k < f.cons.size() / 3; k++) {
+        triindices << f.cons[3*k]+vi << " " << f.cons[3*k+2]+vi << " " << f.cons[3*k+1]+vi << " ";
+    }
+    f.indices = triindices.str();
+}
+
 void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_Shape& Shape, float fMeshDeviation)
 {
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
     TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+    std::vector<LuxFace> faces;
+    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next()) {
+        LuxFace face;
+        face.face = TopoDS::Face(ex.Current());
+        face.meshed = false;
+        face.nodes = 0;
+        face.offset = 0;
+        face.progress = 0;
+        faces.push_back(face);
+    }
+
+    {
+        // BRepMesh_IncrementalMesh has no progress of its own, the bar stays at zero while
+        // it meshes the whole shape and advances when the faces convert their triangulation
+        Base::ConcurrentProgress progress("Meshing shape", faces.size());
+        for (std::vector<LuxFace>::iterator it = faces.begin(); it != faces.end(); ++it)
+            it->progress = &progress;
+
+        // faces which are already meshed finely enough, e.g. for the display, are kept
+        BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+
+        // gather vertices and normals of all faces concurrently, the export stops at the first
+        // face without mesh
+        if (faces.size() > 1)
+            Base::waitForFinished(QtConcurrent::map(faces, writeLuxFace));
+        else
+            std::for_each(faces.begin(), faces.end(), writeLuxFace);
+
+        if (progress.isCanceled())
+            throw Base::AbortException("Export canceled");
+    }
+
+    long vi = 0;
+    std::size_t count = 0;
+    for (; count < faces.size() && faces[count].meshed; count++) {
+        faces[count].offset = vi;
+        vi = vi + faces[count].nodes;
+    }
+    faces.resize(count);
+
+    // the face indices depend on the number of vertices of the preceding faces
+    if (faces.size() > 1)
+        QtConcurrent::blockingMap(faces, writeLuxIndices);
+    else
+        std::for_each(faces.begin(), faces.end(), writeLuxIndices);
+
+    Base::SequencerLauncher seq("Writing file", faces.size());
 
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
-    
     // write object
     out << "AttributeBegin #  \"" << PartName << "\"" << endl;
     out << "Transform [1 0 0 0 0 1 0 0 0 0 1 0 0 0 0 1]" << endl;
     out << "NamedMaterial \"FreeCADMaterial_" << PartName << "\"" << endl;
     out << "Shape \"mesh\"" << endl;
-    
-    // gather vertices, normals and face indices
-    std::stringstream triindices;
-    std::stringstream N;
-    std::stringstream P;
-    l = 1;
-    int vi = 0;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
-
-        PovTools::transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
-
-        if (!vertices) break;
-        // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            P << vertices[i].X() << " " << vertices[i].Y() << " " << vertices[i].Z() << " ";
-        }
-
-        // writing per vertex normals
-        for (int j=0; j < nbNodesInFace; j++) {
-            N << vertexnormals[j].X() << " "  << vertexnormals[j].Y() << " " << vertexnormals[j].Z() << " ";
-        }
-
-        // writing triangle indices
-        for (int k=0; k < nbTriInFace; k++) {
-            triindices << cons[3*k]+vi << " " << cons[3*k+2]+vi << " " << cons[3*k+1]+vi << " ";
-        }
-        
-        vi = vi + nbNodesInFace;
-        
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
-
-        seq.next();
-
-    } // end of face loop
 
     // write mesh data
-    out << "    \"integer triindices\" [" << triindices.str() << "]" << endl;
-    out << "    \"point P\" [" << P.str() << "]" << endl;
-    out << "    \"normal N\" [" << N.str() << "]" << endl;
+    out << "    \"integer triindices\" [";
+    for (std::vector<LuxFace>::iterator it = faces.begin(); it != faces.end(); ++it) {
+        out << it->indices;
+        seq.next();
+    }
+    out << "]\n";
+    out << "    \"point P\" [";
+    for (std::vector<LuxFace>::iterator it = faces.begin(); it != faces.end(); ++it)
+        out << it->points;
+    out << "]\n";
+    out << "    \"normal N\" [";
+    for (std::vector<LuxFace>::iterator it = faces.begin(); it != faces.end(); ++it)
+        out << it->normals;
+    out << "]\n";
     out << "    \"bool generatetangents\" [\"false\"]" << endl;
     out << "    \"string name\" [\"" << PartName << "\"]" << endl;
     out << "AttributeEnd # \"\"" << endl;
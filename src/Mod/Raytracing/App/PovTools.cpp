@@ -34,8 +34,11 @@
 # include <sstream>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/FutureWatcherProgress.h>
 #include <Base/Sequencer.h>
 #include <App/ComplexGeoData.h>
 
@@ -220,84 +223,166 @@ void PovTools::writeShape(const char *FileName, const char *PartName,
     fout.close();
 }
 
+namespace Raytracing {
+// A face of the exported shape and the text written for it
+struct PovFace {
+    TopoDS_Face face;
+    int index;
+    const char* partName;
+    bool meshed;
+    std::string text;
+    Base::ConcurrentProgress* progress;
+};
+}
+
+static void formatPovFace(PovFace& f)
+{
+    std::vector<gp_Vec> vertices, vertexnormals;
+    std::vector<long> cons;
+    f.meshed = PovTools::transferToArray(f.face, vertices, vertexnormals, cons);
+    if (!f.meshed)
+        return;
+
+    std::size_t nbNodesInFace = vertices.size();
+    std::size_t nbTriInFace = cons.size() / 3;
+
+    // writing per face header
+    std::ostringstream out;
+    out << "// face number" << f.index << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++\n"
+    << "#declare " << f.partName << f.index << " = mesh2{\n"
+    << "  vertex_vectors {\n"
+    << "    " << nbNodesInFace << ",\n";
+    // writing vertices
+    for (std::size_t i=0; i < nbNodesInFace; i++) {
+        out << "    <" << vertices[i].X() << ","
+        << vertices[i].Z() << ","
+        << vertices[i].Y() << ">,\n";
+    }
+    out << "  }\n"
+    // writing per vertex normals
+    << "  normal_vectors {\n"
+    << "    " << nbNodesInFace << ",\n";
+    for (std::size_t j=0; j < nbNodesInFace; j++) {
+        out << "    <" << vertexnormals[j].X() << ","
+        << vertexnormals[j].Z() << ","
+        << vertexnormals[j].Y() << ">,\n";
+    }
+
+    out << "  }\n"
+    // writing triangle indices
+    << "  face_indices {\n"
+    << "    " << nbTriInFace << ",\n";
+    for (std::size_t k=0; k < nbTriInFace; k++) {
+        out << "    <" << cons[3*k] << ","<< cons[3*k+2] << ","<< cons[3*k+1] << ">,\n";
+    }
+    // end of face
+    out << "  }\n"
+    << "} // end of Face"<< f.index << "\n\n";
+
+    f.text = out.str();
+}
+
+static void writePovFace(PovFace& f)
+{
+    if (f.progress->isCanceled())
+        return;
+    formatPovFace(f);
+    f.progress->add();
+}
+
+namespace Raytracing {
+// A face of the exported point cloud and the lines written for it
+struct CsvFace {
+    TopoDS_Face face;
+    float length;
+    bool meshed;
+    std::string text;
+    Base::ConcurrentProgress* progress;
+};
+}
+
+static void writeCsvFace(CsvFace& f)
+{
+    if (f.progress->isCanceled())
+        return;
+
+    const char cSeperator = ',';
+    std::vector<gp_Vec> vertices, vertexnormals;
+    std::vector<long> cons;
+    f.meshed = PovTools::transferToArray(f.face, vertices, vertexnormals, cons);
+    if (f.meshed) {
+        // writing vertices
+        std::ostringstream out;
+        for (std::size_t i=0; i < vertices.size(); i++) {
+            out << vertices[i].X() << cSeperator
+            << vertices[i].Z() << cSeperator
+            << vertices[i].Y() << cSeperator
+            << vertexnormals[i].X() * f.length <<cSeperator
+            << vertexnormals[i].Z() * f.length <<cSeperator
+            << vertexnormals[i].Y() * f.length <<cSeperator
+            << '\n';
+        }
+        f.text = out.str();
+    }
+
+    f.progress->add();
+}
+
 void PovTools::writeShape(std::ostream &out, const char *PartName,
                           const TopoDS_Shape& Shape, float fMeshDeviation)
 {
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
+    // The faces are formatted concurrently, each into its own buffer, and written in order
+    // afterwards
     TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
-
-
-    // counting faces and start sequencer
+    std::vector<PovFace> faces;
     int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
-
-    // write the file
-    out <<  "// Written by FreeCAD http://www.freecadweb.org/" << endl;
-    l = 1;
     for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
+        PovFace face;
+        face.face = TopoDS::Face(ex.Current());
+        face.index = l;
+        face.partName = PartName;
+        face.meshed = false;
+        face.progress = 0;
+        faces.push_back(face);
+    }
 
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
+    {
+        // BRepMesh_IncrementalMesh has no progress of its own, the bar stays at zero while
+        // it meshes the whole shape and advances when the faces convert their triangulation
+        Base::ConcurrentProgress progress("Meshing shape", faces.size());
+        for (std::vector<PovFace>::iterator it = faces.begin(); it != faces.end(); ++it)
+            it->progress = &progress;
 
-        transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
+        // faces which are already meshed finely enough, e.g. for the display, are kept
+        BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
 
-        if (!vertices) break;
-        // writing per face header
-        out << "// face number" << l << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
-        << "#declare " << PartName << l << " = mesh2{" << endl
-        << "  vertex_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
-        // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            out << "    <" << vertices[i].X() << ","
-            << vertices[i].Z() << ","
-            << vertices[i].Y() << ">,"
-            << endl;
-        }
-        out << "  }" << endl
-        // writing per vertex normals
-        << "  normal_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
-        for (int j=0; j < nbNodesInFace; j++) {
-            out << "    <" << vertexnormals[j].X() << ","
-            << vertexnormals[j].Z() << ","
-            << vertexnormals[j].Y() << ">,"
-            << endl;
-        }
+        if (faces.size() > 1)
+            Base::waitForFinished(QtConcurrent::map(faces, writePovFace));
+        else
+            std::for_each(faces.begin(), faces.end(), writePovFace);
 
-        out << "  }" << endl
-        // writing triangle indices
-        << "  face_indices {" << endl
-        << "    " << nbTriInFace << "," << endl;
-        for (int k=0; k < nbTriInFace; k++) {
-            out << "    <" << cons[3*k] << ","<< cons[3*k+2] << ","<< cons[3*k+1] << ">," << endl;
-        }
-        // end of face
-        out << "  }" << endl
-        << "} // end of Face"<< l << endl << endl;
+        if (progress.isCanceled())
+            throw Base::AbortException("Export canceled");
+    }
 
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
+    Base::SequencerLauncher seq("Writing file", faces.size());
 
+    // write the file
+    out <<  "// Written by FreeCAD http://www.freecadweb.org/" << endl;
+    l = 1;
+    for (std::vector<PovFace>::iterator it = faces.begin(); it != faces.end(); ++it, l++) {
+        if (!it->meshed) break;
+        out << it->text;
         seq.next();
-
     } // end of face loop
 
 
-    out << endl << endl << "// Declare all together +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
-    << "#declare " << PartName << " = union {" << endl;
+    out << "\n\n// Declare all together +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++\n"
+    << "#declare " << PartName << " = union {\n";
     for (int i=1; i < l; i++) {
-        out << "mesh2{ " << PartName << i << "}" << endl;
+        out << "mesh2{ " << PartName << i << "}\n";
     }
     out << "}" << endl;
 }
@@ -307,68 +392,53 @@ void PovTools::writeShapeCSV(const char *FileName,
                              float fMeshDeviation,
                              float fLength)
 {
-    const char cSeperator = ',';
-
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
     TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
-
-    // open the file and write
-    std::ofstream fout(FileName);
-
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
-
-    // write the file
-    l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
+    std::vector<CsvFace> faces;
+    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next()) {
+        CsvFace face;
+        face.face = TopoDS::Face(ex.Current());
+        face.length = fLength;
+        face.meshed = false;
+        face.progress = 0;
+        faces.push_back(face);
+    }
 
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
+    {
+        // as in writeShape() the faces report the progress when their triangulation is converted
+        Base::ConcurrentProgress progress("Meshing shape", faces.size());
+        for (std::vector<CsvFace>::iterator it = faces.begin(); it != faces.end(); ++it)
+            it->progress = &progress;
 
-        transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
+        BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
 
-        if (!vertices) break;
-        // writing per face header
-        // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            fout << vertices[i].X() << cSeperator
-            << vertices[i].Z() << cSeperator
-            << vertices[i].Y() << cSeperator
-            << vertexnormals[i].X() * fLength <<cSeperator
-            << vertexnormals[i].Z() * fLength <<cSeperator
-            << vertexnormals[i].Y() * fLength <<cSeperator
-            << endl;
-        }
+        if (faces.size() > 1)
+            Base::waitForFinished(QtConcurrent::map(faces, writeCsvFace));
+        else
+            std::for_each(faces.begin(), faces.end(), writeCsvFace);
 
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
+        if (progress.isCanceled())
+            throw Base::AbortException("Export canceled");
+    }
 
+    // open the file and write, the export stops at the first face without mesh
+    std::ofstream fout(FileName);
+    Base::SequencerLauncher seq("Writing file", faces.size());
+    for (std::vector<CsvFace>::iterator it = faces.begin(); it != faces.end(); ++it) {
+        if (!it->meshed) break;
+        fout << it->text;
         seq.next();
-
-    } // end of face loop
+    }
 
     fout.close();
 }
 
 void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec** vertexnormals, long** cons,int &nbNodesInFace,int &nbTriInFace )
 {
-    TopLoc_Location aLoc;
-
-    // doing the meshing and checking the result
-    //BRepMesh_IncrementalMesh MESH(aFace,fDeflection);
-    Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(aFace,aLoc);
-    if (aPoly.IsNull()) {
+    std::vector<gp_Vec> points, normals;
+    std::vector<long> indices;
+    if (!transferToArray(aFace, points, normals, indices)) {
         Base::Console().Log("Empty face trianglutaion\n");
         nbNodesInFace =0;
         nbTriInFace = 0;
@@ -377,6 +447,27 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
         return;
     }
 
+    nbNodesInFace = (int)points.size();
+    nbTriInFace = (int)indices.size() / 3;
+    *vertices = new gp_Vec[nbNodesInFace];
+    *vertexnormals = new gp_Vec[nbNodesInFace];
+    *cons = new long[3*(nbTriInFace)+1];
+    std::copy(points.begin(), points.end(), *vertices);
+    std::copy(normals.begin(), normals.end(), *vertexnormals);
+    std::copy(indices.begin(), indices.end(), *cons);
+}
+
+bool PovTools::transferToArray(const TopoDS_Face& aFace, std::vector<gp_Vec>& vertices,
+                               std::vector<gp_Vec>& vertexnormals, std::vector<long>& cons)
+{
+    TopLoc_Location aLoc;
+
+    // doing the meshing and checking the result
+    //BRepMesh_IncrementalMesh MESH(aFace,fDeflection);
+    Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(aFace,aLoc);
+    if (aPoly.IsNull())
+        return false;
+
     // geting the transformation of the shape/face
     gp_Trsf myTransf;
     Standard_Boolean identity = true;
@@ -387,15 +478,11 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
 
     Standard_Integer i;
     // geting size and create the array
-    nbNodesInFace = aPoly->NbNodes();
-    nbTriInFace = aPoly->NbTriangles();
-    *vertices = new gp_Vec[nbNodesInFace];
-    *vertexnormals = new gp_Vec[nbNodesInFace];
-    for (i=0; i < nbNodesInFace; i++) {
-        (*vertexnormals)[i]= gp_Vec(0.0,0.0,0.0);
-    }
-
-    *cons = new long[3*(nbTriInFace)+1];
+    Standard_Integer nbNodesInFace = aPoly->NbNodes();
+    Standard_Integer nbTriInFace = aPoly->NbTriangles();
+    vertices.assign(nbNodesInFace, gp_Vec(0.0,0.0,0.0));
+    vertexnormals.assign(nbNodesInFace, gp_Vec(0.0,0.0,0.0));
+    cons.resize(3*nbTriInFace);
 
     // check orientation
     TopAbs_Orientation orient = aFace.Orientation();
@@ -434,27 +521,27 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
         //Standard_Real Area = 0.5 * Normal.Magnitude();
 
         // add the triangle normal to the vertex normal for all points of this triangle
-        (*vertexnormals)[N1-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-        (*vertexnormals)[N2-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-        (*vertexnormals)[N3-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-
-        (*vertices)[N1-1].SetX((float)(V1.X()));
-        (*vertices)[N1-1].SetY((float)(V1.Y()));
-        (*vertices)[N1-1].SetZ((float)(V1.Z()));
-        (*vertices)[N2-1].SetX((float)(V2.X()));
-        (*vertices)[N2-1].SetY((float)(V2.Y()));
-        (*vertices)[N2-1].SetZ((float)(V2.Z()));
-        (*vertices)[N3-1].SetX((float)(V3.X()));
-        (*vertices)[N3-1].SetY((float)(V3.Y()));
-        (*vertices)[N3-1].SetZ((float)(V3.Z()));
+        vertexnormals[N1-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
+        vertexnormals[N2-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
+        vertexnormals[N3-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
+
+        vertices[N1-1].SetX((float)(V1.X()));
+        vertices[N1-1].SetY((float)(V1.Y()));
+        vertices[N1-1].SetZ((float)(V1.Z()));
+        vertices[N2-1].SetX((float)(V2.X()));
+        vertices[N2-1].SetY((float)(V2.Y()));
+        vertices[N2-1].SetZ((float)(V2.Z()));
+        vertices[N3-1].SetX((float)(V3.X()));
+        vertices[N3-1].SetY((float)(V3.Y()));
+        vertices[N3-1].SetZ((float)(V3.Z()));
 
         int j = i - 1;
         N1--;
         N2--;
         N3--;
-        (*cons)[3*j] = N1;
-        (*cons)[3*j+1] = N2;
-        (*cons)[3*j+2] = N3;
+        cons[3*j] = N1;
+        cons[3*j+1] = N2;
+        cons[3*j+2] = N3;
     }
 
     // normalize all vertex normals
@@ -465,8 +552,8 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
         try {
             Handle_Geom_Surface Surface = BRep_Tool::Surface(aFace);
 
-            gp_Pnt vertex((*vertices)[i].XYZ());
-//     gp_Pnt vertex((*vertices)[i][0], (*vertices)[i][1], (*vertices)[i][2]);
+            gp_Pnt vertex(vertices[i].XYZ());
+//     gp_Pnt vertex(vertices[i][0], vertices[i][1], vertices[i][2]);
             GeomAPI_ProjectPointOnSurf ProPntSrf(vertex, Surface);
             Standard_Real fU, fV;
             ProPntSrf.Parameters(1, fU, fV);
@@ -475,15 +562,17 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
 
             clNormal = clPropOfFace.Normal();
             gp_Vec temp = clNormal;
-            //Base::Console().Log("unterschied:%.2f",temp.dot((*vertexnormals)[i]));
-            if ( temp * (*vertexnormals)[i] < 0 )
+            //Base::Console().Log("unterschied:%.2f",temp.dot(vertexnormals[i]));
+            if ( temp * vertexnormals[i] < 0 )
                 temp = -temp;
-            (*vertexnormals)[i] = temp;
+            vertexnormals[i] = temp;
 
         }
         catch (...) {
         }
 
-        (*vertexnormals)[i].Normalize();
+        vertexnormals[i].Normalize();
     }
+
+    return true;
 }
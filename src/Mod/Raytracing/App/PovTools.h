@@ -113,6 +113,11 @@ public:
 
 
     static void transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec** vertexnormals, long** cons,int &nbNodesInFace,int &nbTriInFace );
+    /// transfers the mesh of the face into the given arrays, returns false if the face is not meshed
+    static bool transferToArray(const TopoDS_Face& aFace,
+                                std::vector<gp_Vec>& vertices,
+                                std::vector<gp_Vec>& vertexnormals,
+                                std::vector<long>& cons);
 };
 
 
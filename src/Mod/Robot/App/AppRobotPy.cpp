@@ -28,10 +28,13 @@
 
 #include <Base/Console.h>
 #include <Base/VectorPy.h>
+#include <Base/PlacementPy.h>
+#include <Mod/Part/App/TopoShapePy.h>
 
 #include "TrajectoryPy.h"
 #include "Robot6AxisPy.h"
 #include "Simulation.h"
+#include "TrajectoryValidator.h"
 
 #include "RobotAlgos.h"
 
@@ -65,9 +68,124 @@ simulateToFile(PyObject *self, PyObject *args)
 }
 
 
+// adds a Part shape or a mesh topology tuple (points, facets) to the collision mesh
+static void addCollisionGeometry(CollisionMesh &mesh, const Py::Object &obj, double deflection)
+{
+    if (PyObject_TypeCheck(obj.ptr(), &(Part::TopoShapePy::Type))) {
+        mesh.addShape(*static_cast<Part::TopoShapePy*>(obj.ptr())->getTopoShapePtr(), deflection);
+        return;
+    }
+
+    Py::Tuple topo(obj);
+    if (topo.size() != 2)
+        throw Py::TypeError("Expected a shape or a tuple of points and facets");
+    Py::Sequence pts(topo[0]);
+    Py::Sequence fts(topo[1]);
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> facets;
+    points.reserve(pts.size());
+    facets.reserve(fts.size());
+    for (Py::Sequence::iterator it = pts.begin(); it != pts.end(); ++it) {
+        Py::Object item(*it);
+        if (!PyObject_TypeCheck(item.ptr(), &(Base::VectorPy::Type)))
+            throw Py::TypeError("Expected a list of vectors as points");
+        points.push_back(*static_cast<Base::VectorPy*>(item.ptr())->getVectorPtr());
+    }
+    for (Py::Sequence::iterator it = fts.begin(); it != fts.end(); ++it) {
+        Py::Tuple item(*it);
+        Data::ComplexGeoData::Facet facet;
+        facet.I1 = (int)Py::Int(item[0]);
+        facet.I2 = (int)Py::Int(item[1]);
+        facet.I3 = (int)Py::Int(item[2]);
+        facets.push_back(facet);
+    }
+    mesh.addFacets(points, facets);
+}
+
+static PyObject * 
+checkTrajectory(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *pcRobObj;
+    PyObject *pcTracObj;
+    double tick;
+    PyObject *pcObstacles = 0;
+    PyObject *pcLinks = 0;
+    PyObject *pcTool = 0;
+    PyObject *pcBase = 0;
+    double deflection = 1.0;
+    double limitTolerance = 0.0;
+    double singularityTolerance = 1e-4;
+
+    static char* kwlist[] = {"Robot", "Trajectory", "Resolution", "Obstacles", "Links",
+                             "Tool", "Base", "Deflection", "LimitTolerance",
+                             "SingularityTolerance", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O!d|OOO!O!ddd", kwlist,
+                                     &(Robot6AxisPy::Type), &pcRobObj,
+                                     &(TrajectoryPy::Type), &pcTracObj,
+                                     &tick, &pcObstacles, &pcLinks,
+                                     &(Base::PlacementPy::Type), &pcTool,
+                                     &(Base::PlacementPy::Type), &pcBase,
+                                     &deflection, &limitTolerance, &singularityTolerance))
+        return NULL;                             // NULL triggers exception
+
+    PY_TRY {
+        Robot::Trajectory &Trac = * static_cast<TrajectoryPy*>(pcTracObj)->getTrajectoryPtr();
+        Robot::Robot6Axis &Rob  = * static_cast<Robot6AxisPy*>(pcRobObj)->getRobot6AxisPtr();
+        if (Trac.getSize() < 2) {
+            PyErr_SetString(PyExc_ValueError, "Trajectory needs at least two waypoints");
+            return NULL;
+        }
+
+        TrajectoryValidator validator(Rob, Trac);
+        validator.Resolution = tick;
+        validator.LimitTolerance = limitTolerance;
+        validator.SingularityTolerance = singularityTolerance;
+        if (pcTool)
+            validator.Tool = *static_cast<Base::PlacementPy*>(pcTool)->getPlacementPtr();
+        if (pcBase)
+            validator.Base = *static_cast<Base::PlacementPy*>(pcBase)->getPlacementPtr();
+
+        if (pcObstacles && pcObstacles != Py_None) {
+            Py::Sequence list(pcObstacles);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it)
+                addCollisionGeometry(validator.getObstacles(), Py::Object(*it), deflection);
+        }
+        if (pcLinks && pcLinks != Py_None) {
+            Py::Sequence list(pcLinks);
+            if (list.size() > 7)
+                throw Py::ValueError("At most seven links (base and six axes) expected");
+            for (int i=0; i<list.size(); i++) {
+                Py::Object item(list[i]);
+                if (!item.isNone())
+                    addCollisionGeometry(validator.getLink(i), item, deflection);
+            }
+        }
+
+        TrajectoryValidator::Result res = validator.check();
+
+        static const char* status[] = {"Valid", "Unreachable", "JointLimit", "Singularity", "Collision"};
+        Py::List links;
+        for (std::vector<int>::iterator it = res.links.begin(); it != res.links.end(); ++it)
+            links.append(Py::Int(*it));
+        Py::Tuple tuple(3);
+        tuple.setItem(0, Py::String(status[res.status]));
+        tuple.setItem(1, Py::Float(res.time));
+        tuple.setItem(2, links);
+        return Py::new_reference_to(tuple);
+    } PY_CATCH;
+}
+
+
 /* registration table  */
 struct PyMethodDef Robot_methods[] = {
    {"simulateToFile"       ,simulateToFile      ,METH_VARARGS,
      "void simulateToFile(Robot,Trajectory,TickSize,FileName) - runs the simulation and write the result to a file."},
+   {"checkTrajectory"      ,(PyCFunction)checkTrajectory ,METH_VARARGS|METH_KEYWORDS,
+     "(Status,Time,Links) checkTrajectory(Robot,Trajectory,Resolution,[Obstacles,Links,Tool,Base,Deflection,LimitTolerance,SingularityTolerance])\n"
+     "Samples the trajectory every Resolution seconds and checks for unreachable positions, axes at\n"
+     "their soft ends, singular poses and collisions. Obstacles is a list of shapes or mesh topologies\n"
+     "(points,facets) in world coordinates, Links a list with the geometry of the base and the six\n"
+     "links in their own coordinate system. Status is one of 'Valid', 'Unreachable', 'JointLimit',\n"
+     "'Singularity' or 'Collision', Time the time of the first problem and Links the offending links."},
     {NULL, NULL}        /* end of table marker */
 };
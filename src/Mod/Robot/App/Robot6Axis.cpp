@@ -24,8 +24,11 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <cmath>
 #endif
 
+#include <Eigen/LU>
+
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 
@@ -70,6 +73,7 @@ AxisDefinition KukaIR500[6] = {
 TYPESYSTEM_SOURCE(Robot::Robot6Axis , Base::Persistence);
 
 Robot6Axis::Robot6Axis()
+  : FkSolver(0), IkSolverVel(0), IkSolverPos(0), JacSolver(0)
 {
     // create joint array for the min and max angel values of each joint
     Min = JntArray(6);
@@ -82,8 +86,57 @@ Robot6Axis::Robot6Axis()
     setKinematic(KukaIR500);
 }
 
+Robot6Axis::Robot6Axis(const Robot6Axis& rob)
+  : Kinematic(rob.Kinematic), Actuall(rob.Actuall), Min(rob.Min), Max(rob.Max)
+  , Tcp(rob.Tcp), FkSolver(0), IkSolverVel(0), IkSolverPos(0), JacSolver(0)
+{
+    for(int i=0 ; i<6 ;i++){
+        Velocity[i] = rob.Velocity[i];
+        RotDir  [i] = rob.RotDir[i];
+    }
+    createSolvers();
+}
+
 Robot6Axis::~Robot6Axis()
 {
+    deleteSolvers();
+}
+
+Robot6Axis &Robot6Axis::operator=(const Robot6Axis& rob)
+{
+    if (this == &rob)
+        return *this;
+    Kinematic = rob.Kinematic;
+    Actuall = rob.Actuall;
+    Min = rob.Min;
+    Max = rob.Max;
+    Tcp = rob.Tcp;
+    for(int i=0 ; i<6 ;i++){
+        Velocity[i] = rob.Velocity[i];
+        RotDir  [i] = rob.RotDir[i];
+    }
+    createSolvers();
+    return *this;
+}
+
+void Robot6Axis::createSolvers(void)
+{
+    // the solvers keep their own copy of the chain and the joint limits,
+    // so they must be rebuilt whenever one of them changes
+    deleteSolvers();
+    FkSolver = new ChainFkSolverPos_recursive(Kinematic);
+    IkSolverVel = new ChainIkSolverVel_pinv(Kinematic);
+    // Maximum 100 iterations, stop at accuracy 1e-6
+    IkSolverPos = new ChainIkSolverPos_NR_JL(Kinematic,Min,Max,*FkSolver,*IkSolverVel,100,1e-6);
+    JacSolver = new ChainJntToJacSolver(Kinematic);
+}
+
+void Robot6Axis::deleteSolvers(void)
+{
+    delete JacSolver;   JacSolver = 0;
+    delete IkSolverPos; IkSolverPos = 0;
+    delete IkSolverVel; IkSolverVel = 0;
+    delete FkSolver;    FkSolver = 0;
 }
 
 
@@ -102,6 +155,7 @@ void Robot6Axis::setKinematic(const AxisDefinition KinDef[6])
 
 	// for now and testing
     Kinematic = temp;
+    createSolvers();
 
 	// get the actuall TCP out of tha axis
 	calcTcp();
@@ -225,6 +279,7 @@ void Robot6Axis::Restore(XMLReader &reader)
         Actuall(i) = reader.getAttributeAsFloat("Pos");
     }
     Kinematic = Temp;
+    createSolvers();
 
     calcTcp();
 
@@ -234,11 +289,7 @@ void Robot6Axis::Restore(XMLReader &reader)
 
 bool Robot6Axis::setTo(const Placement &To)
 {
-	//Creation of the solvers:
-	ChainFkSolverPos_recursive fksolver1(Kinematic);//Forward position solver
-	ChainIkSolverVel_pinv iksolver1v(Kinematic);//Inverse velocity solver
-	ChainIkSolverPos_NR_JL iksolver1(Kinematic,Min,Max,fksolver1,iksolver1v,100,1e-6);//Maximum 100 iterations, stop at accuracy 1e-6
-	 
+	// the solvers are created once per kinematic, see createSolvers()
 	//Creation of jntarrays:
 	JntArray result(Kinematic.getNrOfJoints());
 	 
@@ -246,7 +297,7 @@ bool Robot6Axis::setTo(const Placement &To)
 	Frame F_dest = Frame(KDL::Rotation::Quaternion(To.getRotation()[0],To.getRotation()[1],To.getRotation()[2],To.getRotation()[3]),KDL::Vector(To.getPosition()[0],To.getPosition()[1],To.getPosition()[2]));
 	 
 	// solve
-	if(iksolver1.CartToJnt(Actuall,F_dest,result) < 0)
+	if(IkSolverPos->CartToJnt(Actuall,F_dest,result) < 0)
 		return false;
 	else{
 		Actuall = result;
@@ -264,15 +315,12 @@ Base::Placement Robot6Axis::getTcp(void)
 
 bool Robot6Axis::calcTcp(void)
 {
-    // Create solver based on kinematic chain
-    ChainFkSolverPos_recursive fksolver = ChainFkSolverPos_recursive(Kinematic);
- 
      // Create the frame that will contain the results
     KDL::Frame cartpos;    
  
     // Calculate forward position kinematics
     int kinematics_status;
-    kinematics_status = fksolver.JntToCart(Actuall,cartpos);
+    kinematics_status = FkSolver->JntToCart(Actuall,cartpos);
     if(kinematics_status>=0){
         Tcp = cartpos;
 		return true;
@@ -281,6 +329,48 @@ bool Robot6Axis::calcTcp(void)
     }
 }
 
+void Robot6Axis::calcLinkPlacements(std::vector<Base::Placement> &Links)
+{
+    Links.resize(Kinematic.getNrOfSegments()+1);
+    Frame pos = Frame::Identity();
+    Links[0] = toPlacement(pos);
+    for(unsigned int i=0;i<Kinematic.getNrOfSegments();i++){
+        pos = pos * Kinematic.getSegment(i).pose(Actuall(i));
+        Links[i+1] = toPlacement(pos);
+    }
+}
+
+double Robot6Axis::calcManipulability(void)
+{
+    Jacobian jac(Kinematic.getNrOfJoints());
+    if(JacSolver->JntToJac(Actuall,jac) < 0)
+        return 0.0;
+
+    // scale the translational rows with the reach of the robot to make
+    // the determinant independent of its size
+    double reach = 0.0;
+    for(unsigned int i=0;i<Kinematic.getNrOfSegments();i++)
+        reach += Kinematic.getSegment(i).getFrameToTip().p.Norm();
+    if(reach <= 0.0)
+        return 0.0;
+
+    Eigen::Matrix<double,6,6> mat = jac.data;
+    mat.topRows(3) /= reach;
+    return std::fabs(mat.determinant());
+}
+
+int Robot6Axis::checkLimits(double Tolerance)
+{
+    // an axis exactly at its soft end, e.g. clamped there by the solver, is
+    // still valid, so only values beyond the tolerance band are reported
+    double tol = Tolerance * (M_PI/180);
+    for(int i=0;i<6;i++){
+        if(Actuall(i) > Max(i) - tol || Actuall(i) < Min(i) + tol)
+            return i;
+    }
+    return -1;
+}
+
 bool Robot6Axis::setAxis(int Axis,double Value)
 {
 	Actuall(Axis) = RotDir[Axis] * Value * (M_PI/180); // degree to radiants
@@ -29,6 +29,14 @@
 
 #include <Base/Persistence.h>
 #include <Base/Placement.h>
+#include <vector>
+
+namespace KDL {
+class ChainFkSolverPos_recursive;
+class ChainIkSolverVel_pinv;
+class ChainIkSolverPos_NR_JL;
+class ChainJntToJacSolver;
+}
 
 namespace Robot
 {
@@ -54,8 +62,11 @@ class RobotExport Robot6Axis : public Base::Persistence
 
 public:
     Robot6Axis();
+    Robot6Axis(const Robot6Axis&);
     ~Robot6Axis();
 
+    Robot6Axis &operator=(const Robot6Axis&);
+
 	// from base class
     virtual unsigned int getMemSize (void) const;
 	virtual void Save (Base::Writer &/*writer*/) const;
@@ -76,6 +87,14 @@ public:
 	/// calculate the new Tcp out of the Axis
 	bool calcTcp(void);
 	Base::Placement getTcp(void);
+    /** calculate the placements of the base (0) and of the six links (1-6) of the
+     * robot in the actual pose. The placement of the sixth link is the flange.
+     */
+    void calcLinkPlacements(std::vector<Base::Placement> &Links);
+    /// dimensionless measure for the distance to a singular pose (0 = singular)
+    double calcManipulability(void);
+    /// returns the first axis closer than Tolerance (degree) to its soft ends, or -1
+    int checkLimits(double Tolerance);
 
     //void setKinematik(const std::vector<std::vector<float> > &KinTable);
 
@@ -90,6 +109,15 @@ protected:
 	double Velocity[6];
 	double RotDir  [6];
 
+private:
+    /// (re)creates the solvers for the current kinematic chain and limits
+    void createSolvers(void);
+    void deleteSolvers(void);
+
+    KDL::ChainFkSolverPos_recursive *FkSolver;
+    KDL::ChainIkSolverVel_pinv      *IkSolverVel;
+    KDL::ChainIkSolverPos_NR_JL     *IkSolverPos;
+    KDL::ChainJntToJacSolver        *JacSolver;
 };
 
 } //namespace Part
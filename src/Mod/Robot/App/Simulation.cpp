@@ -24,9 +24,12 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
-
+# include <algorithm>
+# include <cmath>
 #endif
 
+#include <QtConcurrentMap>
+
 #include "kdl_cp/chain.hpp"
 #include "kdl_cp/frames_io.hpp"
 
@@ -72,6 +75,117 @@ Simulation::~Simulation()
 {
 }
 
+namespace Robot {
+struct AxisTrackBlock {
+    AxisTrackBlock(const Robot6Axis& rob) : Rob(rob) {}
+    Robot6Axis Rob;
+    const std::vector<Base::Placement>* Poses;
+    std::size_t Begin, End;
+    std::vector<double>* Track;
+    std::size_t Solved;
+    bool Seeded; /**< the first pose was solved */
+};
+
+static void writeAxis(Robot6Axis& rob, std::vector<double>& track, std::size_t step)
+{
+    for (int j=0; j<6; j++)
+        track[6*step+j] = rob.getAxis(j);
+}
+
+static void solveAxisTrackBlock(AxisTrackBlock& block)
+{
+    // the first pose is already solved, each following one is warm-started
+    // with the joint vector of its predecessor
+    if (!block.Seeded)
+        return;
+    for (std::size_t i=block.Begin+1; i<block.End; i++) {
+        if (!block.Rob.setTo((*block.Poses)[i]))
+            return;
+        writeAxis(block.Rob, *block.Track, i);
+        block.Solved = i;
+    }
+}
+}
+
+bool Simulation::calcAxisTrack(double tick)
+{
+    AxisTrack.clear();
+    if (tick <= 0.0)
+        return false;
+
+    // the trajectory caches its current segment and is not thread-safe, so
+    // the poses are evaluated here in sequence
+    double duration = Trac.getDuration();
+    std::size_t steps = static_cast<std::size_t>(std::ceil(duration/tick)) + 1;
+    std::vector<Base::Placement> poses(steps);
+    Base::Placement toolInv = Tool.inverse();
+    for (std::size_t i=0; i<steps; i++)
+        poses[i] = Trac.getPosition(std::min(double(i)*tick, duration)) * toolInv;
+
+    Robot6Axis rob(Rob);
+    for (int j=0; j<6; j++)
+        rob.setAxis(j, startAxis[j]);
+
+    // split the track into blocks. The first pose of each block is solved in
+    // sequence to get a warm start, the rest of the blocks in parallel with
+    // an own robot copy and thus own solvers each.
+    const std::size_t blockSize = 128;
+    std::vector<double> track(6*steps);
+    std::vector<AxisTrackBlock> blocks;
+    blocks.reserve(steps/blockSize + 1);
+    for (std::size_t begin=0; begin<steps; begin+=blockSize) {
+        bool seeded = rob.setTo(poses[begin]);
+        if (seeded)
+            writeAxis(rob, track, begin);
+        AxisTrackBlock block(rob);
+        block.Seeded = seeded;
+        block.Poses = &poses;
+        block.Begin = begin;
+        block.End = std::min(begin+blockSize, steps);
+        block.Track = &track;
+        block.Solved = begin;
+        blocks.push_back(block);
+    }
+
+    QtConcurrent::blockingMap(blocks, solveAxisTrackBlock);
+
+    // The warm start of a block came from the first pose of the previous block,
+    // but the serial solution starts from its last pose. So the first pose of
+    // each block is solved again from there and a block whose solution differs,
+    // e.g. because the solver chose another configuration, is solved again in
+    // sequence. Keep the track up to the first unreachable position.
+    std::size_t solved = 0;
+    for (std::size_t k=0; k<blocks.size(); k++) {
+        AxisTrackBlock& block = blocks[k];
+        if (k == 0 && !block.Seeded)
+            break;
+        if (k > 0) {
+            for (int j=0; j<6; j++)
+                rob.setAxis(j, track[6*(block.Begin-1)+j]);
+            if (!rob.setTo(poses[block.Begin]))
+                break;
+            bool same = true;
+            for (int j=0; j<6; j++) {
+                if (std::fabs(rob.getAxis(j) - track[6*block.Begin+j]) > 1.0e-3)
+                    same = false;
+            }
+            if (!same || !block.Seeded) {
+                writeAxis(rob, track, block.Begin);
+                block.Rob = rob;
+                block.Solved = block.Begin;
+                block.Seeded = true;
+                solveAxisTrackBlock(block);
+            }
+        }
+        solved = block.Solved + 1;
+        if (block.Solved + 1 != block.End)
+            break;
+    }
+    track.resize(6*solved);
+    AxisTrack.swap(track);
+    return solved == steps;
+}
+
 void Simulation::step(double tick)
 {
 	Pos += tick;
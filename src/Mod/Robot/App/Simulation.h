@@ -29,6 +29,7 @@
 #include <Base/Vector3D.h>
 #include <Base/Placement.h>
 #include <string>
+#include <vector>
 
 #include "Trajectory.h"
 #include "Robot6Axis.h"
@@ -57,10 +58,17 @@ public:
     void setToTime(float t);
     // apply the start axis angles and set to time 0. Restors the exact start position
     void reset(void);
+    /** Solves the inverse kinematic for the whole trajectory in steps of \a tick seconds,
+     * starting from the start axis angles. The axis angles (degree) of step i are stored
+     * in AxisTrack[6*i] ... AxisTrack[6*i+5]. Returns false if a position is not reachable,
+     * in which case AxisTrack holds the steps solved so far.
+     */
+    bool calcAxisTrack(double tick);
 
 	double Pos;
 	double Axis[6];
 	double startAxis[6];
+    std::vector<double> AxisTrack;
 
     Trajectory Trac;
     Robot6Axis &Rob;
@@ -0,0 +1,350 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+#endif
+
+#include <QtConcurrentMap>
+
+#include <Base/Exception.h>
+#include <Base/Matrix.h>
+#include <Mod/Part/App/TopoShape.h>
+
+#include "TrajectoryValidator.h"
+#include "Simulation.h"
+
+using namespace Robot;
+
+
+//===========================================================================
+// CollisionMesh
+//===========================================================================
+
+namespace Robot {
+
+struct CenterLess {
+    CenterLess(const std::vector<Base::Vector3d> &c, int a) : centers(c), axis(a) {}
+    bool operator()(unsigned long i, unsigned long j) const
+    { return centers[i][axis] < centers[j][axis]; }
+    const std::vector<Base::Vector3d> &centers;
+    int axis;
+};
+
+static void project(const Base::Vector3d tria[3], const Base::Vector3d &axis,
+                    double &min, double &max)
+{
+    min = max = tria[0] * axis;
+    for (int i=1; i<3; i++) {
+        double d = tria[i] * axis;
+        if (d < min) min = d;
+        if (d > max) max = d;
+    }
+}
+
+/**
+ * Separating axis test for two triangles. Besides the face normals and the
+ * cross products of the edges the in-plane edge normals are tested too, to
+ * handle coplanar triangles.
+ */
+static bool triangleIntersect(const Base::Vector3d a[3], const Base::Vector3d b[3])
+{
+    Base::Vector3d ea[3] = { a[1]-a[0], a[2]-a[1], a[0]-a[2] };
+    Base::Vector3d eb[3] = { b[1]-b[0], b[2]-b[1], b[0]-b[2] };
+    Base::Vector3d na = ea[0] % ea[1];
+    Base::Vector3d nb = eb[0] % eb[1];
+
+    Base::Vector3d axes[17];
+    int n = 0;
+    axes[n++] = na;
+    axes[n++] = nb;
+    for (int i=0; i<3; i++) {
+        for (int j=0; j<3; j++)
+            axes[n++] = ea[i] % eb[j];
+        axes[n++] = na % ea[i];
+        axes[n++] = nb % eb[i];
+    }
+
+    for (int i=0; i<n; i++) {
+        double mina, maxa, minb, maxb;
+        project(a, axes[i], mina, maxa);
+        project(b, axes[i], minb, maxb);
+        if (maxa < minb || maxb < mina)
+            return false;
+    }
+    return true;
+}
+
+}
+
+CollisionMesh::CollisionMesh()
+{
+}
+
+CollisionMesh::~CollisionMesh()
+{
+}
+
+void CollisionMesh::addFacets(const std::vector<Base::Vector3d> &points,
+                              const std::vector<Data::ComplexGeoData::Facet> &facets,
+                              const Base::Placement &plm)
+{
+    Base::Matrix4D mat = plm.toMatrix();
+    Points.reserve(Points.size() + 3*facets.size());
+    for (std::vector<Data::ComplexGeoData::Facet>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
+        if (it->I1 >= points.size() || it->I2 >= points.size() || it->I3 >= points.size())
+            continue;
+        Points.push_back(mat * points[it->I1]);
+        Points.push_back(mat * points[it->I2]);
+        Points.push_back(mat * points[it->I3]);
+    }
+    Nodes.clear();
+}
+
+void CollisionMesh::addShape(const Part::TopoShape &shape, double deflection, const Base::Placement &plm)
+{
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> facets;
+    shape.getFaces(points, facets, (float)deflection);
+    addFacets(points, facets, plm);
+}
+
+void CollisionMesh::build(void)
+{
+    Nodes.clear();
+    Box = Base::BoundBox3d();
+    unsigned long count = countTriangles();
+    if (count == 0)
+        return;
+
+    std::vector<Base::Vector3d> centers(count);
+    std::vector<unsigned long> order(count);
+    for (unsigned long i=0; i<count; i++) {
+        centers[i] = (Points[3*i] + Points[3*i+1] + Points[3*i+2]) / 3.0;
+        order[i] = i;
+    }
+
+    Nodes.reserve(2*count);
+    buildNode(0, count, order, centers);
+
+    // store the triangles in the order of the leaves
+    std::vector<Base::Vector3d> sorted(Points.size());
+    for (unsigned long i=0; i<count; i++) {
+        sorted[3*i  ] = Points[3*order[i]  ];
+        sorted[3*i+1] = Points[3*order[i]+1];
+        sorted[3*i+2] = Points[3*order[i]+2];
+    }
+    Points.swap(sorted);
+    Box = Nodes.front().Box;
+}
+
+long CollisionMesh::buildNode(unsigned long first, unsigned long count,
+                              std::vector<unsigned long> &order,
+                              const std::vector<Base::Vector3d> &centers)
+{
+    long index = (long)Nodes.size();
+    Nodes.push_back(Node());
+
+    Base::BoundBox3d box;
+    for (unsigned long i=first; i<first+count; i++) {
+        box.Add(Points[3*order[i]  ]);
+        box.Add(Points[3*order[i]+1]);
+        box.Add(Points[3*order[i]+2]);
+    }
+
+    long left = -1, right = -1;
+    if (count > 4) {
+        // split at the median of the triangle centers along the longest side
+        int axis = 0;
+        if (box.LengthY() > box.LengthX())
+            axis = 1;
+        if (box.LengthZ() > (axis == 0 ? box.LengthX() : box.LengthY()))
+            axis = 2;
+        unsigned long half = count/2;
+        std::nth_element(order.begin()+first, order.begin()+first+half,
+                         order.begin()+first+count, CenterLess(centers, axis));
+        left = buildNode(first, half, order, centers);
+        right = buildNode(first+half, count-half, order, centers);
+    }
+
+    Node &node = Nodes[index];
+    node.Box = box;
+    node.First = first;
+    node.Count = count;
+    node.Left = left;
+    node.Right = right;
+    return index;
+}
+
+bool CollisionMesh::intersects(const Base::Vector3d tria[3], const Base::BoundBox3d &triaBox) const
+{
+    std::vector<long> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node &node = Nodes[stack.back()];
+        stack.pop_back();
+        if (!(node.Box && triaBox))
+            continue;
+        if (node.Left >= 0) {
+            stack.push_back(node.Left);
+            stack.push_back(node.Right);
+            continue;
+        }
+
+        for (unsigned long i=node.First; i<node.First+node.Count; i++) {
+            const Base::Vector3d *other = &Points[3*i];
+            Base::BoundBox3d box(other, 3);
+            if ((box && triaBox) && triangleIntersect(tria, other))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool CollisionMesh::intersects(const CollisionMesh &other, const Base::Placement &plm) const
+{
+    if (Nodes.empty() || other.isEmpty())
+        return false;
+
+    Base::Matrix4D mat = plm.toMatrix();
+    unsigned long count = other.countTriangles();
+    for (unsigned long i=0; i<count; i++) {
+        Base::Vector3d tria[3];
+        tria[0] = mat * other.Points[3*i];
+        tria[1] = mat * other.Points[3*i+1];
+        tria[2] = mat * other.Points[3*i+2];
+        Base::BoundBox3d box(tria, 3);
+        if ((box && Box) && intersects(tria, box))
+            return true;
+    }
+    return false;
+}
+
+
+//===========================================================================
+// TrajectoryValidator
+//===========================================================================
+
+TrajectoryValidator::TrajectoryValidator(const Robot6Axis &rob, const Trajectory &trac)
+  : Resolution(0.1), LimitTolerance(0.0), SingularityTolerance(1e-4), Rob(rob), Trac(trac)
+{
+}
+
+TrajectoryValidator::~TrajectoryValidator()
+{
+}
+
+bool TrajectoryValidator::checkStep(Robot6Axis &rob, Result &res) const
+{
+    int axis = rob.checkLimits(LimitTolerance);
+    if (axis >= 0) {
+        res.status = JointLimit;
+        res.links.push_back(axis+1);
+        return false;
+    }
+
+    if (rob.calcManipulability() < SingularityTolerance) {
+        res.status = Singularity;
+        return false;
+    }
+
+    if (!Obstacles.isEmpty()) {
+        std::vector<Base::Placement> plm;
+        rob.calcLinkPlacements(plm);
+        for (int i=0; i<7; i++) {
+            if (Obstacles.intersects(Links[i], Base * plm[i]))
+                res.links.push_back(i);
+        }
+        if (!res.links.empty()) {
+            res.status = Collision;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TrajectoryValidator::checkBlock(Block &block)
+{
+    const std::vector<double> &track = *block.Track;
+    for (unsigned long i=block.Begin; i<block.End; i++) {
+        for (int j=0; j<6; j++)
+            block.Rob.setAxis(j, track[6*i+j]);
+        block.Problem.step = i;
+        if (!block.Validator->checkStep(block.Rob, block.Problem))
+            return;
+    }
+}
+
+TrajectoryValidator::Result TrajectoryValidator::check(void)
+{
+    if (Trac.getSize() < 2)
+        throw Base::Exception("Trajectory needs at least two waypoints");
+    if (Resolution <= 0.0)
+        throw Base::Exception("Resolution must be positive");
+
+    for (int i=0; i<7; i++)
+        Links[i].build();
+    Obstacles.build();
+
+    // joint track of the whole trajectory, starting with the actual robot pose
+    Robot6Axis rob(Rob);
+    Simulation sim(Trac, rob);
+    sim.Tool = Tool;
+    bool reachable = sim.calcAxisTrack(Resolution);
+    const std::vector<double> &track = sim.AxisTrack;
+    unsigned long steps = track.size()/6;
+
+    // check blocks of steps in parallel, each with an own robot copy
+    const unsigned long blockSize = 64;
+    std::vector<Block> blocks;
+    blocks.reserve(steps/blockSize + 1);
+    for (unsigned long begin=0; begin<steps; begin+=blockSize) {
+        Block block(Rob);
+        block.Validator = this;
+        block.Track = &track;
+        block.Begin = begin;
+        block.End = std::min(begin+blockSize, steps);
+        block.Problem.status = Valid;
+        blocks.push_back(block);
+    }
+
+    QtConcurrent::blockingMap(blocks, checkBlock);
+
+    Result res;
+    res.status = Valid;
+    res.step = steps;
+    for (std::vector<Block>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        if (it->Problem.status != Valid) {
+            res = it->Problem;
+            break;
+        }
+    }
+    if (res.status == Valid && !reachable)
+        res.status = Unreachable;
+
+    res.time = std::min(double(res.step)*Resolution, Trac.getDuration());
+    return res;
+}
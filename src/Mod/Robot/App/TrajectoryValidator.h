@@ -0,0 +1,157 @@
+/***************************************************************************
+ *   Copyright (c) 2014 The FreeCAD developers                             *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ROBOT_TRAJECTORYVALIDATOR_H
+#define ROBOT_TRAJECTORYVALIDATOR_H
+
+#include <vector>
+
+#include <App/ComplexGeoData.h>
+#include <Base/BoundBox.h>
+#include <Base/Placement.h>
+
+#include "Robot6Axis.h"
+#include "Trajectory.h"
+
+namespace Part {
+class TopoShape;
+}
+
+namespace Robot
+{
+
+/** A static triangle mesh with an axis aligned bounding box tree.
+ * Used for the link geometry of the robot and for the obstacles of the work cell.
+ */
+class RobotExport CollisionMesh
+{
+public:
+    CollisionMesh();
+    ~CollisionMesh();
+
+    /// adds the triangles, transformed with the placement
+    void addFacets(const std::vector<Base::Vector3d> &Points,
+                   const std::vector<Data::ComplexGeoData::Facet> &Facets,
+                   const Base::Placement &Plm = Base::Placement());
+    /// adds the tessellation of the shape, transformed with the placement
+    void addShape(const Part::TopoShape &Shape, double Deflection,
+                  const Base::Placement &Plm = Base::Placement());
+    /// builds the tree, has to be called after adding triangles
+    void build(void);
+
+    bool isEmpty(void) const
+    { return Points.empty(); }
+    unsigned long countTriangles(void) const
+    { return Points.size()/3; }
+    const Base::BoundBox3d &getBoundBox(void) const
+    { return Box; }
+
+    /// checks if a triangle of Other, moved by Plm, touches a triangle of this mesh
+    bool intersects(const CollisionMesh &Other, const Base::Placement &Plm) const;
+
+private:
+    struct Node {
+        Base::BoundBox3d Box;
+        unsigned long First, Count;
+        long Left, Right; ///< children, -1 for a leaf
+    };
+    long buildNode(unsigned long First, unsigned long Count,
+                   std::vector<unsigned long> &Order,
+                   const std::vector<Base::Vector3d> &Centers);
+    bool intersects(const Base::Vector3d Tria[3], const Base::BoundBox3d &TriaBox) const;
+
+    std::vector<Base::Vector3d> Points; ///< three corners per triangle
+    std::vector<Node> Nodes;
+    Base::BoundBox3d Box;
+};
+
+/** Checks a trajectory of a robot for unreachable positions, positions at the
+ * soft ends of an axis, singular poses and collisions of the robot links with
+ * the obstacles.
+ */
+class RobotExport TrajectoryValidator
+{
+public:
+    enum Status {
+        Valid,
+        Unreachable,
+        JointLimit,
+        Singularity,
+        Collision
+    };
+
+    struct Result {
+        Status status;
+        double time;            ///< time of the first problem on the trajectory
+        unsigned long step;
+        std::vector<int> links; ///< colliding links or the link moved by the axis at its limit
+    };
+
+    TrajectoryValidator(const Robot6Axis &Rob, const Trajectory &Trac);
+    ~TrajectoryValidator();
+
+    /** Geometry of the base (0), of the six links (1-6) in their own coordinate
+     * system. The tool can be added to the sixth link, which is the flange.
+     */
+    CollisionMesh &getLink(int Link)
+    { return Links[Link]; }
+    /// obstacles of the work cell in world coordinates
+    CollisionMesh &getObstacles(void)
+    { return Obstacles; }
+
+    /// runs the check
+    Result check(void);
+
+    /// sampling time step (s) of the trajectory
+    double Resolution;
+    /// minimal distance (degree) to the soft ends of the axes, 0 allows an axis at its end
+    double LimitTolerance;
+    /// poses with a manipulability below that value count as singular
+    double SingularityTolerance;
+    /// placement of the robot base in the world
+    Base::Placement Base;
+    /// tool center point relative to the flange
+    Base::Placement Tool;
+
+private:
+    struct Block {
+        Block(const Robot6Axis &rob) : Rob(rob) {}
+        Robot6Axis Rob;
+        const TrajectoryValidator *Validator;
+        const std::vector<double> *Track;
+        unsigned long Begin, End;
+        Result Problem;
+    };
+    static void checkBlock(Block &block);
+    bool checkStep(Robot6Axis &rob, Result &res) const;
+
+    Robot6Axis Rob;
+    Trajectory Trac;
+    CollisionMesh Links[7];
+    CollisionMesh Obstacles;
+};
+
+} //namespace Robot
+
+
+#endif // ROBOT_TRAJECTORYVALIDATOR_H
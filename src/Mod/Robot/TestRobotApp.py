@@ -0,0 +1,108 @@
+#   (c) The FreeCAD developers 2014                            LGPL        *
+#                                                                         *
+#   This file is part of the FreeCAD CAx development system.              *
+#                                                                         *
+#   This program is free software; you can redistribute it and/or modify  *
+#   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#   as published by the Free Software Foundation; either version 2 of     *
+#   the License, or (at your option) any later version.                   *
+#   for detail see the LICENCE text file.                                 *
+#                                                                         *
+#   FreeCAD is distributed in the hope that it will be useful,            *
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#   GNU Library General Public License for more details.                  *
+#                                                                         *
+#   You should have received a copy of the GNU Library General Public     *
+#   License along with FreeCAD; if not, write to the Free Software        *
+#   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#   USA                                                                   *
+#**************************************************************************
+
+import FreeCAD, unittest, Robot, Part
+from FreeCAD import Vector, Placement, Rotation
+
+#---------------------------------------------------------------------------
+# define the test cases to test the FreeCAD Robot module
+#---------------------------------------------------------------------------
+
+
+class TrajectoryValidatorTestCases(unittest.TestCase):
+	def setUp(self):
+		# move the default robot away from its singular zero pose (axis 5 at 0)
+		self.rob = Robot.Robot6Axis()
+		self.rob.Axis2 = -60.0
+		self.rob.Axis3 = 60.0
+		self.rob.Axis5 = 45.0
+		self.start = self.rob.Tcp
+
+	def trajectory(self, offsets):
+		l = [Robot.Waypoint(self.start,"LIN","Pt")]
+		for v in offsets:
+			l.append(Robot.Waypoint(Placement(self.start.Base + v, self.start.Rotation),"LIN","Pt"))
+		return Robot.Trajectory(l)
+
+	def testReachable(self):
+		t = self.trajectory([Vector(50,0,0), Vector(50,50,0), Vector(0,50,-50)])
+		status, time, links = Robot.checkTrajectory(self.rob, t, 0.01)
+		self.failUnless(status == "Valid", "Reachable trajectory reported as %s at %g s" % (status, time))
+		self.failUnless(links == [])
+
+	def testUnreachableWaypoint(self):
+		# the last waypoint lies far outside the working range of the robot
+		t = self.trajectory([Vector(50,0,0), Vector(10000,0,0)])
+		status, time, links = Robot.checkTrajectory(self.rob, t, 0.01)
+		self.failUnless(status == "Unreachable", "Unreachable waypoint reported as %s" % status)
+		self.failUnless(time > 0.0 and time <= t.Duration)
+
+	def testFewWaypoints(self):
+		t = Robot.Trajectory([Robot.Waypoint(self.start,"LIN","Pt")])
+		self.assertRaises(ValueError, Robot.checkTrajectory, self.rob, t, 0.01)
+
+	def testJointLimit(self):
+		# axis 5 is 85 degree away from its soft ends, all others more than 90
+		t = self.trajectory([Vector(10,0,0)])
+		status, time, links = Robot.checkTrajectory(self.rob, t, 0.01, LimitTolerance=88.0)
+		self.failUnless(status == "JointLimit", "Axis close to its limit reported as %s" % status)
+		self.failUnless(time == 0.0)
+		self.failUnless(links == [5])
+
+	def testAxisAtLimit(self):
+		# an axis exactly at its soft end is no violation without tolerance
+		self.rob.Axis5 = 130.0
+		self.start = self.rob.Tcp
+		t = self.trajectory([Vector(10,0,0)])
+		status, time, links = Robot.checkTrajectory(self.rob, t, 0.01)
+		self.failUnless(status != "JointLimit", "Axis at its limit reported as %s" % status)
+
+	def testSingularity(self):
+		# with axis 5 at 0 the axes 4 and 6 are aligned
+		self.rob.Axis5 = 0.0
+		self.start = self.rob.Tcp
+		t = self.trajectory([Vector(10,0,0)])
+		status, time, links = Robot.checkTrajectory(self.rob, t, 0.01)
+		self.failUnless(status == "Singularity", "Singular pose reported as %s" % status)
+		self.failUnless(time == 0.0)
+
+	def testCollision(self):
+		# the base of the robot and an obstacle overlapping it
+		base = Part.makeBox(400, 400, 400, Vector(-200,-200,0))
+		obstacle = Part.makeBox(200, 200, 200, Vector(100,100,300))
+		t = self.trajectory([Vector(50,0,0), Vector(50,50,0)])
+		status, time, links = Robot.checkTrajectory(self.rob, t, 0.01, Obstacles=[obstacle], Links=[base])
+		self.failUnless(status == "Collision", "Collision reported as %s" % status)
+		self.failUnless(time == 0.0)
+		self.failUnless(links == [0])
+
+		# the same with the base given as mesh topology
+		status, time, links = Robot.checkTrajectory(self.rob, t, 0.01, Obstacles=[obstacle], Links=[base.tessellate(1.0)])
+		self.failUnless(status == "Collision")
+		self.failUnless(links == [0])
+
+	def testNoCollision(self):
+		base = Part.makeBox(400, 400, 400, Vector(-200,-200,0))
+		obstacle = Part.makeBox(200, 200, 200, Vector(-5000,-5000,0))
+		t = self.trajectory([Vector(50,0,0), Vector(50,50,0)])
+		status, time, links = Robot.checkTrajectory(self.rob, t, 0.01, Obstacles=[obstacle], Links=[base])
+		self.failUnless(status == "Valid", "Distant obstacle reported as %s" % status)
+		self.failUnless(links == [])
@@ -51,6 +51,7 @@
 #include "Sketch.h"
 #include "Constraint.h"
 #include <cmath>
+#include <algorithm>
 
 #include <iostream>
 
@@ -92,10 +93,14 @@ void Sketch::clear(void)
         if (it->geo) delete it->geo;
     Geoms.clear();
 
+    // this also drops the cached solver subsystems, they refer to the
+    // constraints and parameters deleted here
     GCSsys.clear();
     isInitMove = false;
     ConstraintsCounter = 0;
     Conflicting.clear();
+    GeoValues.clear();
+    ChangedGeoms.clear();
 }
 
 int Sketch::setUpSketch(const std::vector<Part::Geometry *> &GeoList,
@@ -402,6 +407,32 @@ std::vector<Part::Geometry *> Sketch::extractGeometry(bool withConstrucionElemen
     return temp;
 }
 
+std::vector<Part::Geometry *> Sketch::getGeometry(void) const
+{
+    std::vector<Part::Geometry *> temp;
+    temp.reserve(Geoms.size());
+    for (std::vector<GeoDef>::const_iterator it=Geoms.begin(); it != Geoms.end(); ++it)
+        temp.push_back(it->geo);
+
+    return temp;
+}
+
+std::vector<int> Sketch::getChangedGeometry(void) const
+{
+    // geometries added after the last update of the geometry count as changed
+    std::vector<int> changed;
+    for (int i=0; i < int(Geoms.size()); i++)
+        if (i >= int(ChangedGeoms.size()) || ChangedGeoms[i])
+            changed.push_back(i);
+
+    return changed;
+}
+
+void Sketch::resetChangedGeometry(void)
+{
+    ChangedGeoms.assign(ChangedGeoms.size(), false);
+}
+
 Py::Tuple Sketch::getPyGeometry(void) const
 {
     Py::Tuple tuple(Geoms.size());
@@ -1557,8 +1588,43 @@ int Sketch::addSymmetricConstraint(int geoId1, PointPos pos1, int geoId2, PointP
 
 bool Sketch::updateGeometry()
 {
+    // the solver values of each geometry are compared with the ones of the last
+    // update, so that untouched geometries are neither rebuilt nor reported as changed
+    const int valueCount = 5;
+    bool updateAll = false;
+    if (GeoValues.size() != valueCount*Geoms.size()) {
+        GeoValues.assign(valueCount*Geoms.size(), 0.);
+        ChangedGeoms.assign(Geoms.size(), true);
+        updateAll = true;
+    }
+
     int i=0;
     for (std::vector<GeoDef>::const_iterator it=Geoms.begin(); it != Geoms.end(); ++it, i++) {
+        double values[valueCount] = {0.,0.,0.,0.,0.};
+        if (it->type == Point) {
+            values[0] = *Points[it->startPointId].x;
+            values[1] = *Points[it->startPointId].y;
+        } else if (it->type == Line) {
+            values[0] = *Lines[it->index].p1.x;
+            values[1] = *Lines[it->index].p1.y;
+            values[2] = *Lines[it->index].p2.x;
+            values[3] = *Lines[it->index].p2.y;
+        } else if (it->type == Arc) {
+            values[0] = *Points[it->midPointId].x;
+            values[1] = *Points[it->midPointId].y;
+            values[2] = *Arcs[it->index].rad;
+            values[3] = *Arcs[it->index].startAngle;
+            values[4] = *Arcs[it->index].endAngle;
+        } else if (it->type == Circle) {
+            values[0] = *Points[it->midPointId].x;
+            values[1] = *Points[it->midPointId].y;
+            values[2] = *Circles[it->index].rad;
+        }
+
+        double *lastValues = &GeoValues[valueCount*i];
+        if (!updateAll && std::equal(values, values+valueCount, lastValues))
+            continue;
+
         try {
             if (it->type == Point) {
                 GeomPoint *point = dynamic_cast<GeomPoint*>(it->geo);
@@ -1602,6 +1668,8 @@ bool Sketch::updateGeometry()
                                   i,e.what());
             return false;
         }
+        std::copy(values, values+valueCount, lastValues);
+        ChangedGeoms[i] = true;
     }
     return true;
 }
@@ -1624,8 +1692,13 @@ int Sketch::solve(void)
         switch (soltype) {
         case 0: // solving with the default DogLeg solver
                 // (or with SQP if we are in moving mode)
+            // while dragging only the components affected by the move are
+            // re-solved, starting from the previous position
             solvername = isInitMove ? "SQP" : "DogLeg";
-            ret = GCSsys.solve(isFine, GCS::DogLeg);
+            if (isInitMove)
+                ret = GCSsys.solveIncremental(isFine, GCS::DogLeg);
+            else
+                ret = GCSsys.solve(isFine, GCS::DogLeg);
             break;
         case 1: // solving with the LevenbergMarquardt solver
             solvername = "LevenbergMarquardt";
@@ -77,6 +77,14 @@ public:
     /// returns the actual geometry
     std::vector<Part::Geometry *> extractGeometry(bool withConstrucionElements=true,
                                                   bool withExternalElements=false) const;
+    /// returns the actual geometry including external elements (without memory allocation)
+    std::vector<Part::Geometry *> getGeometry(void) const;
+    /** returns the indices (as in getGeometry()) of the geometries which were
+      * changed by the solver since the last call of resetChangedGeometry()
+      */
+    std::vector<int> getChangedGeometry(void) const;
+    /// starts a new tracking of the geometries changed by the solver
+    void resetChangedGeometry(void);
     /// get the geometry as python objects
     Py::Tuple getPyGeometry(void) const;
 
@@ -221,6 +229,11 @@ protected:
     bool isInitMove;
     bool isFine;
 
+    // solver values of each geometry at the last update (5 values per geometry)
+    std::vector<double> GeoValues;
+    // flags the geometries changed since the last resetChangedGeometry()
+    std::vector<bool> ChangedGeoms;
+
 private:
 
     bool updateGeometry(void);
@@ -29,6 +29,9 @@
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/connected_components.hpp>
+#include <boost/bind.hpp>
+
+#include <QtConcurrentMap>
 
 // http://forum.freecadweb.org/viewtopic.php?f=3&t=4651&start=40
 namespace Eigen {
@@ -236,6 +239,7 @@ void System::clear()
 
     reference.clear();
     clearSubSystems();
+    clearSubSystemsCache();
     free(clist);
     c2p.clear();
     p2c.clear();
@@ -284,6 +288,19 @@ void System::removeConstraint(Constraint *constr)
         hasDiagnosis = false;
     clearSubSystems();
 
+    // cached subsystems referring to the removed constraint are stale now
+    if (constr->getTag() >= 0) {
+        for (SubSystemCache::iterator cached=subSystemsCache.begin();
+             cached != subSystemsCache.end(); ) {
+            if (std::binary_search(cached->first.begin(), cached->first.end(), constr)) {
+                delete cached->second;
+                subSystemsCache.erase(cached++);
+            }
+            else
+                ++cached;
+        }
+    }
+
     VEC_pD constr_params = c2p[constr];
     for (VEC_pD::const_iterator param=constr_params.begin();
          param != constr_params.end(); ++param) {
@@ -688,6 +705,10 @@ void System::rescaleConstraint(int id, double coeff)
 
 void System::declareUnknowns(VEC_pD &params)
 {
+    // the cached subsystems depend on the set of unknowns
+    clearSubSystems();
+    clearSubSystemsCache();
+
     plist = params;
     pIndex.clear();
     for (int i=0; i < int(plist.size()); ++i)
@@ -784,13 +805,15 @@ void System::initSolution()
 
     clists.clear(); // destroy any lists
     clists.resize(componentsSize); // create empty lists to be filled in
+    std::vector< std::vector<Constraint *> > cacheKeys(componentsSize);
     int i = int(plist.size());
     for (std::vector<Constraint *>::const_iterator constr=clistR.begin();
          constr != clistR.end(); ++constr, i++) {
-        if (reducedConstrs.count(*constr) == 0) {
-            int cid = components[i];
+        int cid = components[i];
+        if ((*constr)->getTag() >= 0) // reduced constraints determine the subsystem, too
+            cacheKeys[cid].push_back(*constr);
+        if (reducedConstrs.count(*constr) == 0)
             clists[cid].push_back(*constr);
-        }
     }
 
     plists.clear(); // destroy any lists
@@ -801,7 +824,9 @@ void System::initSolution()
     }
 
     // calculates subSystems and subSystemsAux from clists, plists and reductionmaps
+    // reusing the cached subsystems of unchanged components
     clearSubSystems();
+    SubSystemCache usedCache;
     for (int cid=0; cid < clists.size(); cid++) {
         std::vector<Constraint *> clist0, clist1;
         for (std::vector<Constraint *>::const_iterator constr=clists[cid].begin();
@@ -814,12 +839,26 @@ void System::initSolution()
 
         subSystems.push_back(NULL);
         subSystemsAux.push_back(NULL);
-        if (clist0.size() > 0)
-            subSystems[cid] = new SubSystem(clist0, plists[cid], reductionmaps[cid]);
+        if (clist0.size() > 0) {
+            std::vector<Constraint *> &key = cacheKeys[cid];
+            std::sort(key.begin(), key.end());
+            SubSystemCache::iterator cached = subSystemsCache.find(key);
+            if (cached != subSystemsCache.end()) {
+                subSystems[cid] = cached->second;
+                subSystemsCache.erase(cached);
+            }
+            else
+                subSystems[cid] = new SubSystem(clist0, plists[cid], reductionmaps[cid]);
+            usedCache[key] = subSystems[cid];
+        }
         if (clist1.size() > 0)
             subSystemsAux[cid] = new SubSystem(clist1, plists[cid], reductionmaps[cid]);
     }
 
+    // drop the subsystems of components that do not exist anymore
+    clearSubSystemsCache();
+    subSystemsCache.swap(usedCache);
+
     isInit = true;
 }
 
@@ -854,22 +893,48 @@ int System::solve(bool isFine, Algorithm alg)
     if (!isInit)
         return Failed;
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
+    solvedComponents.assign(subSystems.size(), true);
+
+    std::vector<ComponentSolution> jobs;
     for (int cid=0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-             resetToReference();
-             isReset = true;
+        if (subSystems[cid] || subSystemsAux[cid])
+            jobs.push_back(ComponentSolution(subSystems[cid], subSystemsAux[cid], isFine, alg));
+    }
+    if (!jobs.empty())
+        resetToReference();
+
+    int res = solveComponents(jobs);
+    if (res == Success) {
+        for (std::set<Constraint *>::const_iterator constr=redundant.begin();
+             constr != redundant.end(); constr++)
+             if ((*constr)->error() > XconvergenceFine) {
+                 res = Converged;
+                 return res;
+             }
+    }
+    return res;
+}
+
+int System::solveIncremental(bool isFine, Algorithm alg)
+{
+    if (!isInit)
+        return Failed;
+
+    // Components without negatively tagged constraints keep their current
+    // (already solved) values. The remaining components are not reset to the
+    // reference but continue from the last solution, which typically is close
+    // to the new one while dragging.
+    solvedComponents.assign(subSystems.size(), false);
+
+    std::vector<ComponentSolution> jobs;
+    for (int cid=0; cid < int(subSystems.size()); cid++) {
+        if (subSystemsAux[cid]) {
+            solvedComponents[cid] = true;
+            jobs.push_back(ComponentSolution(subSystems[cid], subSystemsAux[cid], isFine, alg));
         }
-        if (subSystems[cid] && subSystemsAux[cid])
-            res = std::max(res, solve(subSystems[cid], subSystemsAux[cid], isFine));
-        else if (subSystems[cid])
-            res = std::max(res, solve(subSystems[cid], isFine, alg));
-        else if (subSystemsAux[cid])
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg));
     }
+
+    int res = solveComponents(jobs);
     if (res == Success) {
         for (std::set<Constraint *>::const_iterator constr=redundant.begin();
              constr != redundant.end(); constr++)
@@ -881,6 +946,36 @@ int System::solve(bool isFine, Algorithm alg)
     return res;
 }
 
+int System::solveComponents(std::vector<ComponentSolution> &jobs)
+{
+    // The components are decoupled and work on disjoint sets of parameters
+    // and constraints, so they can be solved concurrently
+    if (jobs.size() > 1)
+        QtConcurrent::blockingMap(jobs, boost::bind(&System::solveComponent, this, _1));
+    else if (jobs.size() == 1)
+        solveComponent(jobs[0]);
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = Success;
+    for (std::vector<ComponentSolution>::const_iterator job=jobs.begin();
+         job != jobs.end(); ++job)
+        res = std::max(res, job->result);
+    return res;
+}
+
+void System::solveComponent(ComponentSolution &comp)
+{
+    if (comp.subsys && comp.subsysAux)
+        comp.result = solve(comp.subsys, comp.subsysAux, comp.isFine);
+    else if (comp.subsys)
+        comp.result = solve(comp.subsys, comp.isFine, comp.alg);
+    else if (comp.subsysAux)
+        comp.result = solve(comp.subsysAux, comp.isFine, comp.alg);
+    else
+        comp.result = Success;
+}
+
 int System::solve(SubSystem *subsys, bool isFine, Algorithm alg)
 {
     if (alg == BFGS)
@@ -1418,6 +1513,8 @@ int System::solve(SubSystem *subsysA, SubSystem *subsysB, bool isFine)
 void System::applySolution()
 {
     for (int cid=0; cid < int(subSystems.size()); cid++) {
+        if (cid < int(solvedComponents.size()) && !solvedComponents[cid])
+            continue;
         if (subSystemsAux[cid])
             subSystemsAux[cid]->applySolution();
         if (subSystems[cid])
@@ -1454,180 +1551,252 @@ int System::diagnose()
     redundant.clear();
     conflictingTags.clear();
     redundantTags.clear();
-    Eigen::MatrixXd J(clist.size(), plist.size());
-    int count=0;
+
+    // The jacobian of decoupled components is block diagonal, so each
+    // component is diagnosed on its own and the results are merged afterwards
+    std::vector<Constraint *> clistD;
     for (std::vector<Constraint *>::iterator constr=clist.begin();
          constr != clist.end(); ++constr) {
         (*constr)->revertParams();
-        if ((*constr)->getTag() >= 0) {
-            count++;
-            for (int j=0; j < int(plist.size()); j++)
-                J(count-1,j) = (*constr)->grad(plist[j]);
+        if ((*constr)->getTag() >= 0)
+            clistD.push_back(*constr);
+    }
+
+    Graph g;
+    for (int i=0; i < int(plist.size() + clistD.size()); i++)
+        boost::add_vertex(g);
+
+    int cvtid = int(plist.size());
+    for (std::vector<Constraint *>::const_iterator constr=clistD.begin();
+         constr != clistD.end(); ++constr, cvtid++) {
+        VEC_pD &cparams = c2p[*constr];
+        for (VEC_pD::const_iterator param=cparams.begin();
+             param != cparams.end(); ++param) {
+            MAP_pD_I::const_iterator it = pIndex.find(*param);
+            if (it != pIndex.end())
+                boost::add_edge(cvtid, it->second, g);
         }
     }
 
-    if (J.rows() > 0) {
-        Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT(J.topRows(count).transpose());
-        Eigen::MatrixXd Q = qrJT.matrixQ ();
-        int paramsNum = qrJT.rows();
-        int constrNum = qrJT.cols();
-        int rank = qrJT.rank();
+    VEC_I components(boost::num_vertices(g));
+    int componentsSize = 0;
+    if (!components.empty())
+        componentsSize = boost::connected_components(g, &components[0]);
 
-        Eigen::MatrixXd R;
-        if (constrNum >= paramsNum)
-            R = qrJT.matrixQR().triangularView<Eigen::Upper>();
-        else
-            R = qrJT.matrixQR().topRows(constrNum)
-                               .triangularView<Eigen::Upper>();
-
-        if (constrNum > rank) { // conflicting or redundant constraints
-            for (int i=1; i < rank; i++) {
-                // eliminate non zeros above pivot
-                assert(R(i,i) != 0);
-                for (int row=0; row < i; row++) {
-                    if (R(row,i) != 0) {
-                        double coef=R(row,i)/R(i,i);
-                        R.block(row,i+1,1,constrNum-i-1) -= coef * R.block(i,i+1,1,constrNum-i-1);
-                        R(row,i) = 0;
-                    }
+    std::vector<ComponentDiagnosis> jobs(componentsSize);
+    for (int i=0; i < int(plist.size()); ++i)
+        jobs[components[i]].plist.push_back(plist[i]);
+    for (int i=0; i < int(clistD.size()); ++i)
+        jobs[components[plist.size()+i]].clist.push_back(clistD[i]);
+
+    if (jobs.size() > 1)
+        QtConcurrent::blockingMap(jobs, boost::bind(&System::diagnoseComponent, this, _1));
+    else if (jobs.size() == 1)
+        diagnoseComponent(jobs[0]);
+
+    int paramsNum = int(plist.size());
+    int constrNum = 0;
+    int rank = 0;
+    SET_I conflictingTagsSet;
+    for (std::vector<ComponentDiagnosis>::const_iterator job=jobs.begin();
+         job != jobs.end(); ++job) {
+        constrNum += job->constrNum;
+        rank += job->rank;
+        conflictingTagsSet.insert(job->conflictingTags.begin(), job->conflictingTags.end());
+        redundant.insert(job->redundant.begin(), job->redundant.end());
+    }
+
+    // simplified output of conflicting tags
+    conflictingTagsSet.erase(0); // exclude constraints tagged with zero
+    conflictingTags.resize(conflictingTagsSet.size());
+    std::copy(conflictingTagsSet.begin(), conflictingTagsSet.end(),
+              conflictingTags.begin());
+
+    // output of redundant tags
+    SET_I redundantTagsSet;
+    for (std::set<Constraint *>::iterator constr=redundant.begin();
+         constr != redundant.end(); ++constr)
+        redundantTagsSet.insert((*constr)->getTag());
+    // remove tags represented at least in one non-redundant constraint
+    for (std::vector<Constraint *>::iterator constr=clist.begin();
+         constr != clist.end(); ++constr)
+        if (redundant.count(*constr) == 0)
+            redundantTagsSet.erase((*constr)->getTag());
+    redundantTags.resize(redundantTagsSet.size());
+    std::copy(redundantTagsSet.begin(), redundantTagsSet.end(),
+              redundantTags.begin());
+
+    hasDiagnosis = true;
+    if (paramsNum == rank && constrNum > rank) // over-constrained
+        dofs = paramsNum - constrNum;
+    else
+        dofs = paramsNum - rank;
+    return dofs;
+}
+
+void System::diagnoseComponent(ComponentDiagnosis &comp)
+{
+    const std::vector<Constraint *> &clistC = comp.clist;
+    VEC_pD &plistC = comp.plist;
+
+    comp.constrNum = 0;
+    comp.rank = 0;
+    if (clistC.empty())
+        return;
+
+    Eigen::MatrixXd J(clistC.size(), plistC.size());
+    for (int i=0; i < int(clistC.size()); i++)
+        for (int j=0; j < int(plistC.size()); j++)
+            J(i,j) = clistC[i]->grad(plistC[j]);
+
+    Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT(J.transpose());
+    Eigen::MatrixXd Q = qrJT.matrixQ ();
+    int paramsNum = qrJT.rows();
+    int constrNum = qrJT.cols();
+    int rank = qrJT.rank();
+
+    Eigen::MatrixXd R;
+    if (constrNum >= paramsNum)
+        R = qrJT.matrixQR().triangularView<Eigen::Upper>();
+    else
+        R = qrJT.matrixQR().topRows(constrNum)
+                           .triangularView<Eigen::Upper>();
+
+    if (constrNum > rank) { // conflicting or redundant constraints
+        for (int i=1; i < rank; i++) {
+            // eliminate non zeros above pivot
+            assert(R(i,i) != 0);
+            for (int row=0; row < i; row++) {
+                if (R(row,i) != 0) {
+                    double coef=R(row,i)/R(i,i);
+                    R.block(row,i+1,1,constrNum-i-1) -= coef * R.block(i,i+1,1,constrNum-i-1);
+                    R(row,i) = 0;
                 }
             }
-            std::vector< std::vector<Constraint *> > conflictGroups(constrNum-rank);
-            for (int j=rank; j < constrNum; j++) {
-                for (int row=0; row < rank; row++) {
-                    if (fabs(R(row,j)) > 1e-10) {
-                        int origCol = qrJT.colsPermutation().indices()[row];
-                        conflictGroups[j-rank].push_back(clist[origCol]);
-                    }
+        }
+        std::vector< std::vector<Constraint *> > conflictGroups(constrNum-rank);
+        for (int j=rank; j < constrNum; j++) {
+            for (int row=0; row < rank; row++) {
+                if (fabs(R(row,j)) > 1e-10) {
+                    int origCol = qrJT.colsPermutation().indices()[row];
+                    conflictGroups[j-rank].push_back(clistC[origCol]);
                 }
-                int origCol = qrJT.colsPermutation().indices()[j];
-                conflictGroups[j-rank].push_back(clist[origCol]);
             }
+            int origCol = qrJT.colsPermutation().indices()[j];
+            conflictGroups[j-rank].push_back(clistC[origCol]);
+        }
 
-            // try to remove the conflicting constraints and solve the
-            // system in order to check if the removed constraints were
-            // just redundant but not really conflicting
-            std::set<Constraint *> skipped;
-            SET_I satisfiedGroups;
-            while (1) {
-                std::map< Constraint *, SET_I > conflictingMap;
-                for (int i=0; i < conflictGroups.size(); i++) {
-                    if (satisfiedGroups.count(i) == 0) {
-                        for (int j=0; j < conflictGroups[i].size(); j++) {
-                            Constraint *constr = conflictGroups[i][j];
-                            if (constr->getTag() != 0) // exclude constraints tagged with zero
-                                conflictingMap[constr].insert(i);
-                        }
-                    }
-                }
-                if (conflictingMap.empty())
-                    break;
-            
-                int maxPopularity = 0;
-                Constraint *mostPopular = NULL;
-                for (std::map< Constraint *, SET_I >::const_iterator it=conflictingMap.begin();
-                     it != conflictingMap.end(); it++) {
-                    if (it->second.size() > maxPopularity ||
-                        (it->second.size() == maxPopularity && mostPopular &&
-                         it->first->getTag() > mostPopular->getTag())) {
-                        mostPopular = it->first;
-                        maxPopularity = it->second.size();
+        // try to remove the conflicting constraints and solve the
+        // system in order to check if the removed constraints were
+        // just redundant but not really conflicting
+        std::set<Constraint *> skipped;
+        SET_I satisfiedGroups;
+        while (1) {
+            std::map< Constraint *, SET_I > conflictingMap;
+            for (int i=0; i < conflictGroups.size(); i++) {
+                if (satisfiedGroups.count(i) == 0) {
+                    for (int j=0; j < conflictGroups[i].size(); j++) {
+                        Constraint *constr = conflictGroups[i][j];
+                        if (constr->getTag() != 0) // exclude constraints tagged with zero
+                            conflictingMap[constr].insert(i);
                     }
                 }
-                if (maxPopularity > 0) {
-                    skipped.insert(mostPopular);
-                    for (SET_I::const_iterator it=conflictingMap[mostPopular].begin();
-                         it != conflictingMap[mostPopular].end(); it++)
-                        satisfiedGroups.insert(*it);
-                }
             }
+            if (conflictingMap.empty())
+                break;
 
-            std::vector<Constraint *> clistTmp;
-            clistTmp.reserve(clist.size());
-            for (std::vector<Constraint *>::iterator constr=clist.begin();
-                 constr != clist.end(); ++constr)
-                if (skipped.count(*constr) == 0)
-                    clistTmp.push_back(*constr);
-
-            SubSystem *subSysTmp = new SubSystem(clistTmp, plist);
-            int res = solve(subSysTmp);
-            if (res == Success) {
-                subSysTmp->applySolution();
-                for (std::set<Constraint *>::const_iterator constr=skipped.begin();
-                     constr != skipped.end(); constr++) {
-                    double err = (*constr)->error();
-                    if (err * err < XconvergenceFine)
-                        redundant.insert(*constr);
-                }
-                resetToReference();
-
-                std::vector< std::vector<Constraint *> > conflictGroupsOrig=conflictGroups;
-                conflictGroups.clear();
-                for (int i=conflictGroupsOrig.size()-1; i >= 0; i--) {
-                    bool isRedundant = false;
-                    for (int j=0; j < conflictGroupsOrig[i].size(); j++) {
-                        if (redundant.count(conflictGroupsOrig[i][j]) > 0) {
-                            isRedundant = true;
-                            break;
-                        }
-                    }
-                    if (!isRedundant)
-                        conflictGroups.push_back(conflictGroupsOrig[i]);
-                    else
-                        constrNum--;
+            int maxPopularity = 0;
+            Constraint *mostPopular = NULL;
+            for (std::map< Constraint *, SET_I >::const_iterator it=conflictingMap.begin();
+                 it != conflictingMap.end(); it++) {
+                if (it->second.size() > maxPopularity ||
+                    (it->second.size() == maxPopularity && mostPopular &&
+                     it->first->getTag() > mostPopular->getTag())) {
+                    mostPopular = it->first;
+                    maxPopularity = it->second.size();
                 }
             }
-            delete subSysTmp;
+            if (maxPopularity > 0) {
+                skipped.insert(mostPopular);
+                for (SET_I::const_iterator it=conflictingMap[mostPopular].begin();
+                     it != conflictingMap[mostPopular].end(); it++)
+                    satisfiedGroups.insert(*it);
+            }
+        }
 
-            // simplified output of conflicting tags
-            SET_I conflictingTagsSet;
-            for (int i=0; i < conflictGroups.size(); i++) {
-                for (int j=0; j < conflictGroups[i].size(); j++) {
-                    conflictingTagsSet.insert(conflictGroups[i][j]->getTag());
-                }
+        std::vector<Constraint *> clistTmp;
+        clistTmp.reserve(clistC.size());
+        for (std::vector<Constraint *>::const_iterator constr=clistC.begin();
+             constr != clistC.end(); ++constr)
+            if (skipped.count(*constr) == 0)
+                clistTmp.push_back(*constr);
+
+        // only the parameters of this component are touched by the test solution,
+        // so they are restored locally instead of resetting the whole system
+        VEC_D values;
+        values.reserve(plistC.size());
+        for (VEC_pD::const_iterator param=plistC.begin();
+             param != plistC.end(); ++param)
+            values.push_back(**param);
+
+        SubSystem *subSysTmp = new SubSystem(clistTmp, plistC);
+        int res = solve(subSysTmp);
+        if (res == Success) {
+            subSysTmp->applySolution();
+            for (std::set<Constraint *>::const_iterator constr=skipped.begin();
+                 constr != skipped.end(); constr++) {
+                double err = (*constr)->error();
+                if (err * err < XconvergenceFine)
+                    comp.redundant.insert(*constr);
             }
-            conflictingTagsSet.erase(0); // exclude constraints tagged with zero
-            conflictingTags.resize(conflictingTagsSet.size());
-            std::copy(conflictingTagsSet.begin(), conflictingTagsSet.end(),
-                      conflictingTags.begin());
-
-            // output of redundant tags
-            SET_I redundantTagsSet;
-            for (std::set<Constraint *>::iterator constr=redundant.begin();
-                 constr != redundant.end(); ++constr)
-                redundantTagsSet.insert((*constr)->getTag());
-            // remove tags represented at least in one non-redundant constraint
-            for (std::vector<Constraint *>::iterator constr=clist.begin();
-                 constr != clist.end(); ++constr)
-                if (redundant.count(*constr) == 0)
-                    redundantTagsSet.erase((*constr)->getTag());
-            redundantTags.resize(redundantTagsSet.size());
-            std::copy(redundantTagsSet.begin(), redundantTagsSet.end(),
-                      redundantTags.begin());
-
-            if (paramsNum == rank && constrNum > rank) { // over-constrained
-                hasDiagnosis = true;
-                dofs = paramsNum - constrNum;
-                return dofs;
+            for (int i=0; i < int(plistC.size()); ++i)
+                *plistC[i] = values[i];
+
+            std::vector< std::vector<Constraint *> > conflictGroupsOrig=conflictGroups;
+            conflictGroups.clear();
+            for (int i=conflictGroupsOrig.size()-1; i >= 0; i--) {
+                bool isRedundant = false;
+                for (int j=0; j < conflictGroupsOrig[i].size(); j++) {
+                    if (comp.redundant.count(conflictGroupsOrig[i][j]) > 0) {
+                        isRedundant = true;
+                        break;
+                    }
+                }
+                if (!isRedundant)
+                    conflictGroups.push_back(conflictGroupsOrig[i]);
+                else
+                    constrNum--;
             }
         }
+        delete subSysTmp;
 
-        hasDiagnosis = true;
-        dofs = paramsNum - rank;
-        return dofs;
+        for (int i=0; i < conflictGroups.size(); i++) {
+            for (int j=0; j < conflictGroups[i].size(); j++) {
+                comp.conflictingTags.insert(conflictGroups[i][j]->getTag());
+            }
+        }
     }
-    hasDiagnosis = true;
-    dofs = plist.size();
-    return dofs;
+
+    comp.constrNum = constrNum;
+    comp.rank = rank;
 }
 
 void System::clearSubSystems()
 {
     isInit = false;
-    free(subSystems);
+    // subSystems are owned by subSystemsCache
     free(subSystemsAux);
     subSystems.clear();
     subSystemsAux.clear();
+    solvedComponents.clear();
+}
+
+void System::clearSubSystemsCache()
+{
+    for (SubSystemCache::iterator it=subSystemsCache.begin();
+         it != subSystemsCache.end(); ++it)
+        delete it->second;
+    subSystemsCache.clear();
 }
 
 double lineSearch(SubSystem *subsys, Eigen::VectorXd &xdir)
@@ -59,6 +59,20 @@ namespace GCS
         std::vector<SubSystem *> subSystems, subSystemsAux;
         void clearSubSystems();
 
+        // Subsystems of the non-negatively tagged constraints, keyed by the sorted
+        // list of constraints of their component. They are owned by this cache and
+        // reused by initSolution() for every component whose constraints did not
+        // change, e.g. when only the temporary constraints of a drag are replaced.
+        // The keys are the constraint pointers, so the cache only lives as long as
+        // the constraints and unknowns: clear() and declareUnknowns() drop it.
+        // Sketcher::Sketch rebuilds the system in setUpSketch(), i.e. the cache
+        // spans the solves between two set-ups such as the moves of one drag.
+        typedef std::map< std::vector<Constraint *>, SubSystem * > SubSystemCache;
+        SubSystemCache subSystemsCache;
+        void clearSubSystemsCache();
+
+        std::vector<bool> solvedComponents; // components touched by the last solve
+
         VEC_D reference;
         void setReference();     // copies the current parameter values to reference
         void resetToReference(); // reverts all parameter values to the stored reference
@@ -78,6 +92,30 @@ namespace GCS
         int solve_BFGS(SubSystem *subsys, bool isFine);
         int solve_LM(SubSystem *subsys);
         int solve_DL(SubSystem *subsys);
+
+        // decoupled components are diagnosed and solved independently,
+        // possibly in parallel, and their results are merged afterwards
+        struct ComponentDiagnosis {
+            ComponentDiagnosis() : constrNum(0), rank(0) {}
+            std::vector<Constraint *> clist; // constraints with tag >= 0
+            VEC_pD plist;
+            int constrNum, rank;
+            SET_I conflictingTags;
+            std::set<Constraint *> redundant;
+        };
+        struct ComponentSolution {
+            ComponentSolution(SubSystem *subsys_, SubSystem *subsysAux_,
+                              bool isFine_, Algorithm alg_)
+            : subsys(subsys_), subsysAux(subsysAux_),
+              isFine(isFine_), alg(alg_), result(Success) {}
+            SubSystem *subsys, *subsysAux;
+            bool isFine;
+            Algorithm alg;
+            int result;
+        };
+        void diagnoseComponent(ComponentDiagnosis &comp);
+        void solveComponent(ComponentSolution &comp);
+        int solveComponents(std::vector<ComponentSolution> &jobs);
     public:
         System();
         System(std::vector<Constraint *> clist_);
@@ -162,6 +200,9 @@ namespace GCS
 
         int solve(bool isFine=true, Algorithm alg=DogLeg);
         int solve(VEC_pD &params, bool isFine=true, Algorithm alg=DogLeg);
+        // solves only the components containing negatively tagged constraints
+        // (e.g. the dragging constraints), warm-started from the current values
+        int solveIncremental(bool isFine=true, Algorithm alg=DogLeg);
         int solve(SubSystem *subsys, bool isFine=true, Algorithm alg=DogLeg);
         int solve(SubSystem *subsysA, SubSystem *subsysB, bool isFine=true);
 
@@ -107,8 +107,11 @@ void SubSystem::initialize(VEC_pD &params, MAP_pD_pD &reductionmap)
 
     c2p.clear();
     p2c.clear();
+    jacobiPattern.clear();
+    jacobiPattern.resize(csize);
+    int row=0;
     for (std::vector<Constraint *>::iterator constr=clist.begin();
-         constr != clist.end(); ++constr) {
+         constr != clist.end(); ++constr, row++) {
         (*constr)->revertParams(); // ensure that the constraint points to the original parameters
         VEC_pD constr_params_orig = (*constr)->params();
         SET_pD constr_params;
@@ -123,6 +126,7 @@ void SubSystem::initialize(VEC_pD &params, MAP_pD_pD &reductionmap)
 //            jacobi.set(*constr, *p, 0.);
             c2p[*constr].push_back(*p);
             p2c[*p].push_back(*constr);
+            jacobiPattern[row].push_back(*p - &pvals[0]);
         }
 //        (*constr)->redirectParams(pmap); // redirect parameters to pvec
     }
@@ -253,21 +257,50 @@ void SubSystem::calcJacobi()
 }
 */
 
-void SubSystem::calcJacobi(VEC_pD &params, Eigen::MatrixXd &jacobi)
+// Maps every entry of pvals to the columns of params that refer to it.
+// Because of the parameter reduction several columns may share one entry.
+void SubSystem::mapColumns(VEC_pD &params, std::vector<VEC_I> &columns)
 {
-    jacobi.setZero(csize, params.size());
+    columns.clear();
+    columns.resize(psize);
     for (int j=0; j < int(params.size()); j++) {
         MAP_pD_pD::const_iterator
           pmapfind = pmap.find(params[j]);
         if (pmapfind != pmap.end())
-            for (int i=0; i < csize; i++)
-                jacobi(i,j) = clist[i]->grad(pmapfind->second);
+            columns[pmapfind->second - &pvals[0]].push_back(j);
+    }
+}
+
+// The jacobian is assembled from its sparsity pattern, i.e. only the
+// derivatives with respect to the parameters a constraint actually
+// depends on are evaluated.
+void SubSystem::calcJacobi(VEC_pD &params, Eigen::MatrixXd &jacobi)
+{
+    jacobi.setZero(csize, params.size());
+    std::vector<VEC_I> columns;
+    mapColumns(params, columns);
+    for (int i=0; i < csize; i++) {
+        const VEC_I &pattern = jacobiPattern[i];
+        for (VEC_I::const_iterator idx=pattern.begin(); idx != pattern.end(); ++idx) {
+            const VEC_I &cols = columns[*idx];
+            if (cols.empty())
+                continue;
+            double deriv = clist[i]->grad(&pvals[*idx]);
+            for (VEC_I::const_iterator j=cols.begin(); j != cols.end(); ++j)
+                jacobi(i,*j) = deriv;
+        }
     }
 }
 
 void SubSystem::calcJacobi(Eigen::MatrixXd &jacobi)
 {
-    calcJacobi(plist, jacobi);
+    // plist corresponds one to one to pvals
+    jacobi.setZero(csize, psize);
+    for (int i=0; i < csize; i++) {
+        const VEC_I &pattern = jacobiPattern[i];
+        for (VEC_I::const_iterator idx=pattern.begin(); idx != pattern.end(); ++idx)
+            jacobi(i,*idx) = clist[i]->grad(&pvals[*idx]);
+    }
 }
 
 void SubSystem::calcGrad(VEC_pD &params, Eigen::VectorXd &grad)
@@ -275,22 +308,40 @@ void SubSystem::calcGrad(VEC_pD &params, Eigen::VectorXd &grad)
     assert(grad.size() == int(params.size()));
 
     grad.setZero();
-    for (int j=0; j < int(params.size()); j++) {
-        MAP_pD_pD::const_iterator
-          pmapfind = pmap.find(params[j]);
-        if (pmapfind != pmap.end()) {
-            // assert(p2c.find(pmapfind->second) != p2c.end());
-            std::vector<Constraint *> constrs=p2c[pmapfind->second];
-            for (std::vector<Constraint *>::const_iterator constr = constrs.begin();
-                 constr != constrs.end(); ++constr)
-                grad[j] += (*constr)->error() * (*constr)->grad(pmapfind->second);
+    std::vector<VEC_I> columns;
+    mapColumns(params, columns);
+    for (int i=0; i < csize; i++) {
+        const VEC_I &pattern = jacobiPattern[i];
+        double err = 0.;
+        bool hasError = false;
+        for (VEC_I::const_iterator idx=pattern.begin(); idx != pattern.end(); ++idx) {
+            const VEC_I &cols = columns[*idx];
+            if (cols.empty())
+                continue;
+            if (!hasError) { // evaluate the residual only once per constraint
+                err = clist[i]->error();
+                hasError = true;
+            }
+            double deriv = err * clist[i]->grad(&pvals[*idx]);
+            for (VEC_I::const_iterator j=cols.begin(); j != cols.end(); ++j)
+                grad[*j] += deriv;
         }
     }
 }
 
 void SubSystem::calcGrad(Eigen::VectorXd &grad)
 {
-    calcGrad(plist, grad);
+    assert(grad.size() == psize);
+
+    grad.setZero();
+    for (int i=0; i < csize; i++) {
+        const VEC_I &pattern = jacobiPattern[i];
+        if (pattern.empty())
+            continue;
+        double err = clist[i]->error();
+        for (VEC_I::const_iterator idx=pattern.begin(); idx != pattern.end(); ++idx)
+            grad[*idx] += err * clist[i]->grad(&pvals[*idx]);
+    }
 }
 
 double SubSystem::maxStep(VEC_pD &params, Eigen::VectorXd &xdir)
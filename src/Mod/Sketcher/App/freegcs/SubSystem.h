@@ -43,7 +43,9 @@ namespace GCS
 //        JacobianMatrix jacobi;  // jacobi matrix of the residuals
         std::map<Constraint *,VEC_pD > c2p; // constraint to parameter adjacency list
         std::map<double *,std::vector<Constraint *> > p2c; // parameter to constraint adjacency list
+        std::vector<VEC_I> jacobiPattern; // indices in pvals of the non-zero entries of each jacobian row
         void initialize(VEC_pD &params, MAP_pD_pD &reductionmap); // called by the constructors
+        void mapColumns(VEC_pD &params, std::vector<VEC_I> &columns);
     public:
         SubSystem(std::vector<Constraint *> &clist_, VEC_pD &params);
         SubSystem(std::vector<Constraint *> &clist_, VEC_pD &params,
@@ -158,7 +158,8 @@ struct EditData {
     PointsCoordinate(0),
     CurvesCoordinate(0),
     CurveSet(0), RootCrossSet(0), EditCurveSet(0),
-    PointSet(0), pickStyleAxes(0)
+    PointSet(0), pickStyleAxes(0),
+    DrawnIntGeoCount(-1)
     {}
 
     // pointer to the active handler for new sketch objects
@@ -223,11 +224,20 @@ struct EditData {
 
     SoGroup       *constrGroup;
     SoPickStyle   *pickStyleAxes;
+
+    // layout of the curve and point sets of the last draw(true): the first coordinate
+    // of each geometry (with a trailing end index), used to patch changed geometries only
+    std::vector<int> GeoCurvesCoordIndex;
+    std::vector<int> GeoPointsCoordIndex;
+    int DrawnIntGeoCount; // -1 if the layout is unknown
+
+    // the icon currently shown by each constraint icon node (see drawTypicalConstraintIcon())
+    std::map<SoImage *, QString> ConstrIconKeys;
 };
 
 
 // this function is used to simulate cyclic periodic negative geometry indices (for external geometry)
-const Part::Geometry* GeoById(const std::vector<Part::Geometry*> GeoList, int Id)
+const Part::Geometry* GeoById(const std::vector<Part::Geometry*> &GeoList, int Id)
 {
     if (Id >= 0)
         return GeoList[Id];
@@ -1116,8 +1126,8 @@ void ViewProviderSketch::moveConstraint(int constNum, const Base::Vector2D &toPo
 
     int intGeoCount = getSketchObject()->getHighestCurveIndex() + 1;
     int extGeoCount = getSketchObject()->getExternalGeometryCount();
-    // with memory allocation
-    const std::vector<Part::Geometry *> geomlist = edit->ActSketch.extractGeometry(true, true);
+    // without memory allocation
+    const std::vector<Part::Geometry *> geomlist = edit->ActSketch.getGeometry();
 
     assert(int(geomlist.size()) == extGeoCount + intGeoCount);
     assert((Constr->First >= -extGeoCount && Constr->First < intGeoCount)
@@ -1237,10 +1247,6 @@ void ViewProviderSketch::moveConstraint(int constNum, const Base::Vector2D &toPo
         Constr->LabelDistance = vec.Length()/2;
     }
 
-    // delete the cloned objects
-    for (std::vector<Part::Geometry *>::const_iterator it=geomlist.begin(); it != geomlist.end(); ++it)
-        if (*it) delete *it;
-
     draw(true);
 }
 
@@ -2173,7 +2179,12 @@ void ViewProviderSketch::sendConstraintIconToCoin(const QImage &icon, SoImage *s
 
 void ViewProviderSketch::clearCoinImage(SoImage *soImagePtr)
 {
+    // an already cleared image is left alone to avoid a needless notification
+    std::map<SoImage *, QString>::iterator it = edit->ConstrIconKeys.find(soImagePtr);
+    if (it != edit->ConstrIconKeys.end() && it->second.isEmpty())
+        return;
     soImagePtr->setToDefaults();
+    edit->ConstrIconKeys[soImagePtr] = QString();
 }
 
 QColor ViewProviderSketch::constrColor(int constraintId)
@@ -2340,8 +2351,10 @@ void ViewProviderSketch::combineConstraintIcons(IconQueue iconQueue)
     // (Translation: this number is somewhat made-up.)
     float maxDistSquared = pow(0.05 * getScaleFactor(), 2);
 
-    // There's room for optimisation here; we could reuse the combined icons...
-    edit->combinedConstrBoxes.clear();
+    // The bounding boxes of unchanged combined icons are taken over by
+    // drawMergedConstraintIcons() instead of rendering those icons again
+    std::map<QString, ConstrIconBBVec> lastConstrBoxes;
+    lastConstrBoxes.swap(edit->combinedConstrBoxes);
 
     while(!iconQueue.empty()) {
         // A group starts with an item popped off the back of our initial queue
@@ -2385,20 +2398,65 @@ void ViewProviderSketch::combineConstraintIcons(IconQueue iconQueue)
             drawTypicalConstraintIcon(thisGroup[0]);
         }
         else {
-            drawMergedConstraintIcons(thisGroup);
+            drawMergedConstraintIcons(thisGroup, lastConstrBoxes);
         }
     }
 }
 
-void ViewProviderSketch::drawMergedConstraintIcons(IconQueue iconQueue)
+void ViewProviderSketch::drawMergedConstraintIcons(IconQueue iconQueue,
+                                                   const std::map<QString, ConstrIconBBVec> &lastConstrBoxes)
 {
     SbVec3f avPos(0, 0, 0);
     for(IconQueue::iterator i = iconQueue.begin(); i != iconQueue.end(); ++i) {
-        clearCoinImage(i->destination);
         avPos = avPos + i->position;
     }
     avPos = avPos/iconQueue.size();
 
+    // The composite icon only depends on the icons in the order they are
+    // combined below, so it is only rendered again if one of them changed
+    QString iconKey;
+    SoImage *keyDest = 0;
+    SoInfo *keyInfo = 0;
+    float keyClosest = FLT_MAX;
+    QString keyIdString;
+    for(IconQueue::iterator i = iconQueue.begin(); i != iconQueue.end(); ++i) {
+        bool isFirstOfType = true;
+        for(IconQueue::iterator j = iconQueue.begin(); j != i; ++j)
+            if(j->type == i->type) {
+                isFirstOfType = false;
+                break;
+            }
+        if(!isFirstOfType)
+            continue;
+        for(IconQueue::iterator j = i; j != iconQueue.end(); ++j) {
+            if(j->type != i->type)
+                continue;
+            if((avPos - j->position).length() < keyClosest) {
+                keyDest = j->destination;
+                keyInfo = j->infoPtr;
+                keyClosest = (avPos - j->position).length();
+            }
+            if(keyIdString.length())
+                keyIdString.append(QString::fromAscii(","));
+            keyIdString.append(QString::number(j->constraintId));
+            iconKey += j->type + QLatin1Char('|') + j->label + QLatin1Char('|') +
+                       constrColor(j->constraintId).name() + QLatin1Char('|') +
+                       QString::number(constrColorPriority(j->constraintId)) + QLatin1Char('|') +
+                       QString::number(j->iconRotation) + QLatin1Char(j == i ? ';' : ',');
+        }
+    }
+
+    for(IconQueue::iterator i = iconQueue.begin(); i != iconQueue.end(); ++i)
+        if(i->destination != keyDest)
+            clearCoinImage(i->destination);
+
+    std::map<QString, ConstrIconBBVec>::const_iterator lastBoxes = lastConstrBoxes.find(keyIdString);
+    if(lastBoxes != lastConstrBoxes.end() && edit->ConstrIconKeys[keyDest] == iconKey) {
+        edit->combinedConstrBoxes[keyIdString] = lastBoxes->second;
+        keyInfo->string.setValue(keyIdString.toAscii().data());
+        return;
+    }
+
     QImage compositeIcon;
     float closest = FLT_MAX;  // Closest distance between avPos and any icon
     SoImage *thisDest;
@@ -2543,6 +2601,7 @@ void ViewProviderSketch::drawMergedConstraintIcons(IconQueue iconQueue)
     edit->combinedConstrBoxes[idString] = boundingBoxes;
     thisInfo->string.setValue(idString.toAscii().data());
     sendConstraintIconToCoin(compositeIcon, thisDest);
+    edit->ConstrIconKeys[thisDest] = iconKey;
 }
 
 
@@ -2636,14 +2695,22 @@ void ViewProviderSketch::drawTypicalConstraintIcon(const constrIconQueueItem &i)
 {
     QColor color = constrColor(i.constraintId);
 
+    i.infoPtr->string.setValue(QString::number(i.constraintId).toAscii().data());
+
+    // nothing to do if the node already shows this very icon
+    QString iconKey = i.type + QLatin1Char('|') + i.label + QLatin1Char('|') +
+                      color.name() + QLatin1Char('|') + QString::number(i.iconRotation);
+    if (edit->ConstrIconKeys[i.destination] == iconKey)
+        return;
+
     QImage image = renderConstrIcon(i.type,
                                     color,
                                     QStringList(i.label),
                                     QList<QColor>() << color,
                                     i.iconRotation);
 
-    i.infoPtr->string.setValue(QString::number(i.constraintId).toAscii().data());
     sendConstraintIconToCoin(image, i.destination);
+    edit->ConstrIconKeys[i.destination] = iconKey;
 }
 
 float ViewProviderSketch::getScaleFactor()
@@ -2657,6 +2724,108 @@ float ViewProviderSketch::getScaleFactor()
     }
 }
 
+// this function computes the coordinates of the curve (if any) and of the points
+// of a geometry, as used by the curve set and the point set in edit mode
+static void tessellateGeometry(const Part::Geometry *geo,
+                               std::vector<Base::Vector3d> &Coords,
+                               std::vector<Base::Vector3d> &Points,
+                               std::vector<unsigned int> &Index)
+{
+    if (geo->getTypeId() == Part::GeomPoint::getClassTypeId()) { // add a point
+        const Part::GeomPoint *point = dynamic_cast<const Part::GeomPoint *>(geo);
+        Points.push_back(point->getPoint());
+    }
+    else if (geo->getTypeId() == Part::GeomLineSegment::getClassTypeId()) { // add a line
+        const Part::GeomLineSegment *lineSeg = dynamic_cast<const Part::GeomLineSegment *>(geo);
+        // create the definition struct for that geom
+        Coords.push_back(lineSeg->getStartPoint());
+        Coords.push_back(lineSeg->getEndPoint());
+        Points.push_back(lineSeg->getStartPoint());
+        Points.push_back(lineSeg->getEndPoint());
+        Index.push_back(2);
+    }
+    else if (geo->getTypeId() == Part::GeomCircle::getClassTypeId()) { // add a circle
+        const Part::GeomCircle *circle = dynamic_cast<const Part::GeomCircle *>(geo);
+        Handle_Geom_Circle curve = Handle_Geom_Circle::DownCast(circle->handle());
+
+        int countSegments = 50;
+        Base::Vector3d center = circle->getCenter();
+        double segment = (2 * M_PI) / countSegments;
+        for (int i=0; i < countSegments; i++) {
+            gp_Pnt pnt = curve->Value(i*segment);
+            Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
+        }
+
+        gp_Pnt pnt = curve->Value(0);
+        Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
+
+        Index.push_back(countSegments+1);
+        Points.push_back(center);
+    }
+    else if (geo->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) { // add an arc
+        const Part::GeomArcOfCircle *arc = dynamic_cast<const Part::GeomArcOfCircle *>(geo);
+        Handle_Geom_TrimmedCurve curve = Handle_Geom_TrimmedCurve::DownCast(arc->handle());
+
+        double startangle, endangle;
+        arc->getRange(startangle, endangle);
+        if (startangle > endangle) // if arc is reversed
+            std::swap(startangle, endangle);
+
+        double range = endangle-startangle;
+        int countSegments = std::max(6, int(50.0 * range / (2 * M_PI)));
+        double segment = range / countSegments;
+
+        Base::Vector3d center = arc->getCenter();
+        Base::Vector3d start  = arc->getStartPoint();
+        Base::Vector3d end    = arc->getEndPoint();
+
+        for (int i=0; i < countSegments; i++) {
+            gp_Pnt pnt = curve->Value(startangle);
+            Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
+            startangle += segment;
+        }
+
+        // end point
+        gp_Pnt pnt = curve->Value(endangle);
+        Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
+
+        Index.push_back(countSegments+1);
+        Points.push_back(start);
+        Points.push_back(end);
+        Points.push_back(center);
+    }
+    else if (geo->getTypeId() == Part::GeomBSplineCurve::getClassTypeId()) { // add a bspline
+        const Part::GeomBSplineCurve *spline = dynamic_cast<const Part::GeomBSplineCurve *>(geo);
+        Handle_Geom_BSplineCurve curve = Handle_Geom_BSplineCurve::DownCast(spline->handle());
+
+        double first = curve->FirstParameter();
+        double last = curve->LastParameter();
+        if (first > last) // if arc is reversed
+            std::swap(first, last);
+
+        double range = last-first;
+        int countSegments = 50;
+        double segment = range / countSegments;
+
+        for (int i=0; i < countSegments; i++) {
+            gp_Pnt pnt = curve->Value(first);
+            Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
+            first += segment;
+        }
+
+        // end point
+        gp_Pnt end = curve->Value(last);
+        Coords.push_back(Base::Vector3d(end.X(), end.Y(), end.Z()));
+
+        std::vector<Base::Vector3d> poles = spline->getPoles();
+        for (std::vector<Base::Vector3d>::iterator it = poles.begin(); it != poles.end(); ++it) {
+            Points.push_back(*it);
+        }
+
+        Index.push_back(countSegments+1);
+    }
+}
+
 void ViewProviderSketch::draw(bool temp)
 {
     assert(edit);
@@ -2675,7 +2844,7 @@ void ViewProviderSketch::draw(bool temp)
     const std::vector<Part::Geometry *> *geomlist;
     std::vector<Part::Geometry *> tempGeo;
     if (temp)
-        tempGeo = edit->ActSketch.extractGeometry(true, true); // with memory allocation
+        tempGeo = edit->ActSketch.getGeometry(); // without memory allocation
     else
         tempGeo = getSketchObject()->getCompleteGeometry(); // without memory allocation
     geomlist = &tempGeo;
@@ -2684,141 +2853,108 @@ void ViewProviderSketch::draw(bool temp)
     assert(int(geomlist->size()) == extGeoCount + intGeoCount);
     assert(int(geomlist->size()) >= 2);
 
-    edit->CurvIdToGeoId.clear();
-    int GeoId = 0;
-
-    // RootPoint
-    Points.push_back(Base::Vector3d(0.,0.,0.));
-
-    for (std::vector<Part::Geometry *>::const_iterator it = geomlist->begin(); it != geomlist->end()-2; ++it, GeoId++) {
-        if (GeoId >= intGeoCount)
-            GeoId = -extGeoCount;
-        if ((*it)->getTypeId() == Part::GeomPoint::getClassTypeId()) { // add a point
-            const Part::GeomPoint *point = dynamic_cast<const Part::GeomPoint *>(*it);
-            Points.push_back(point->getPoint());
-        }
-        else if ((*it)->getTypeId() == Part::GeomLineSegment::getClassTypeId()) { // add a line
-            const Part::GeomLineSegment *lineSeg = dynamic_cast<const Part::GeomLineSegment *>(*it);
-            // create the definition struct for that geom
-            Coords.push_back(lineSeg->getStartPoint());
-            Coords.push_back(lineSeg->getEndPoint());
-            Points.push_back(lineSeg->getStartPoint());
-            Points.push_back(lineSeg->getEndPoint());
-            Index.push_back(2);
-            edit->CurvIdToGeoId.push_back(GeoId);
-        }
-        else if ((*it)->getTypeId() == Part::GeomCircle::getClassTypeId()) { // add a circle
-            const Part::GeomCircle *circle = dynamic_cast<const Part::GeomCircle *>(*it);
-            Handle_Geom_Circle curve = Handle_Geom_Circle::DownCast(circle->handle());
-
-            int countSegments = 50;
-            Base::Vector3d center = circle->getCenter();
-            double segment = (2 * M_PI) / countSegments;
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(i*segment);
-                Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
+    int geoCount = int(geomlist->size()) - 2; // the axes are not part of the curve and point sets
+    int i=0;
+
+    // While dragging only the geometries changed by the solver get new coordinates.
+    // This relies on the layout of the last draw(true), so whenever the number of
+    // vertices of a changed geometry differs (e.g. a growing arc) everything is rebuilt.
+    std::set<int> changedGeoIds;
+    bool incremental = temp && edit->DrawnIntGeoCount == intGeoCount &&
+                       int(edit->GeoCurvesCoordIndex.size()) == geoCount+1 &&
+                       edit->CurvesCoordinate->point.getNum() == edit->GeoCurvesCoordIndex.back() &&
+                       edit->PointsCoordinate->point.getNum() == edit->GeoPointsCoordIndex.back();
+    if (incremental) {
+        std::vector<int> changedGeos = edit->ActSketch.getChangedGeometry();
+        SbVec3f *verts = edit->CurvesCoordinate->point.startEditing();
+        SbVec3f *pverts = edit->PointsCoordinate->point.startEditing();
+        for (std::vector<int>::const_iterator jt = changedGeos.begin(); jt != changedGeos.end(); ++jt) {
+            if (*jt >= geoCount)
+                continue;
+            Coords.clear();
+            Points.clear();
+            Index.clear();
+            tessellateGeometry((*geomlist)[*jt], Coords, Points, Index);
+
+            int coordStart = edit->GeoCurvesCoordIndex[*jt];
+            int pointStart = edit->GeoPointsCoordIndex[*jt];
+            if (int(Coords.size()) != edit->GeoCurvesCoordIndex[*jt+1] - coordStart ||
+                int(Points.size()) != edit->GeoPointsCoordIndex[*jt+1] - pointStart) {
+                incremental = false;
+                break;
             }
 
-            gp_Pnt pnt = curve->Value(0);
-            Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
+            i=coordStart; // patching the range of this geometry in the line set
+            for (std::vector<Base::Vector3d>::const_iterator it = Coords.begin(); it != Coords.end(); ++it,i++)
+                verts[i].setValue(it->x,it->y,zLines);
 
-            Index.push_back(countSegments+1);
-            edit->CurvIdToGeoId.push_back(GeoId);
-            Points.push_back(center);
-        }
-        else if ((*it)->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) { // add an arc
-            const Part::GeomArcOfCircle *arc = dynamic_cast<const Part::GeomArcOfCircle *>(*it);
-            Handle_Geom_TrimmedCurve curve = Handle_Geom_TrimmedCurve::DownCast(arc->handle());
-
-            double startangle, endangle;
-            arc->getRange(startangle, endangle);
-            if (startangle > endangle) // if arc is reversed
-                std::swap(startangle, endangle);
-
-            double range = endangle-startangle;
-            int countSegments = std::max(6, int(50.0 * range / (2 * M_PI)));
-            double segment = range / countSegments;
-
-            Base::Vector3d center = arc->getCenter();
-            Base::Vector3d start  = arc->getStartPoint();
-            Base::Vector3d end    = arc->getEndPoint();
-
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
-                Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
-                startangle += segment;
-            }
+            i=pointStart; // patching the range of this geometry in the point set
+            for (std::vector<Base::Vector3d>::const_iterator it = Points.begin(); it != Points.end(); ++it,i++)
+                pverts[i].setValue(it->x,it->y,zPoints);
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
+            changedGeoIds.insert(*jt < intGeoCount ? *jt : *jt - int(geomlist->size()));
+        }
+        edit->CurvesCoordinate->point.finishEditing();
+        edit->PointsCoordinate->point.finishEditing();
+    }
 
-            Index.push_back(countSegments+1);
-            edit->CurvIdToGeoId.push_back(GeoId);
-            Points.push_back(start);
-            Points.push_back(end);
-            Points.push_back(center);
+    if (!incremental) {
+        Coords.clear();
+        Points.clear();
+        Index.clear();
+        edit->CurvIdToGeoId.clear();
+        edit->GeoCurvesCoordIndex.clear();
+        edit->GeoPointsCoordIndex.clear();
+        int GeoId = 0;
+
+        // RootPoint
+        Points.push_back(Base::Vector3d(0.,0.,0.));
+
+        for (std::vector<Part::Geometry *>::const_iterator it = geomlist->begin(); it != geomlist->end()-2; ++it, GeoId++) {
+            if (GeoId >= intGeoCount)
+                GeoId = -extGeoCount;
+            edit->GeoCurvesCoordIndex.push_back(Coords.size());
+            edit->GeoPointsCoordIndex.push_back(Points.size());
+            size_t curveCount = Index.size();
+            tessellateGeometry(*it, Coords, Points, Index);
+            if (Index.size() > curveCount)
+                edit->CurvIdToGeoId.push_back(GeoId);
         }
-        else if ((*it)->getTypeId() == Part::GeomBSplineCurve::getClassTypeId()) { // add a bspline
-            const Part::GeomBSplineCurve *spline = dynamic_cast<const Part::GeomBSplineCurve *>(*it);
-            Handle_Geom_BSplineCurve curve = Handle_Geom_BSplineCurve::DownCast(spline->handle());
+        edit->GeoCurvesCoordIndex.push_back(Coords.size());
+        edit->GeoPointsCoordIndex.push_back(Points.size());
 
-            double first = curve->FirstParameter();
-            double last = curve->LastParameter();
-            if (first > last) // if arc is reversed
-                std::swap(first, last);
+        edit->CurvesCoordinate->point.setNum(Coords.size());
+        edit->CurveSet->numVertices.setNum(Index.size());
+        edit->CurvesMaterials->diffuseColor.setNum(Index.size());
+        edit->PointsCoordinate->point.setNum(Points.size());
+        edit->PointsMaterials->diffuseColor.setNum(Points.size());
 
-            double range = last-first;
-            int countSegments = 50;
-            double segment = range / countSegments;
+        SbVec3f *verts = edit->CurvesCoordinate->point.startEditing();
+        int32_t *index = edit->CurveSet->numVertices.startEditing();
+        SbVec3f *pverts = edit->PointsCoordinate->point.startEditing();
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(first);
-                Coords.push_back(Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z()));
-                first += segment;
-            }
+        i=0; // setting up the line set
+        for (std::vector<Base::Vector3d>::const_iterator it = Coords.begin(); it != Coords.end(); ++it,i++)
+            verts[i].setValue(it->x,it->y,zLines);
 
-            // end point
-            gp_Pnt end = curve->Value(last);
-            Coords.push_back(Base::Vector3d(end.X(), end.Y(), end.Z()));
+        i=0; // setting up the indexes of the line set
+        for (std::vector<unsigned int>::const_iterator it = Index.begin(); it != Index.end(); ++it,i++)
+            index[i] = *it;
 
-            std::vector<Base::Vector3d> poles = spline->getPoles();
-            for (std::vector<Base::Vector3d>::iterator it = poles.begin(); it != poles.end(); ++it) {
-                Points.push_back(*it);
-            }
+        i=0; // setting up the point set
+        for (std::vector<Base::Vector3d>::const_iterator it = Points.begin(); it != Points.end(); ++it,i++)
+            pverts[i].setValue(it->x,it->y,zPoints);
 
-            Index.push_back(countSegments+1);
-            edit->CurvIdToGeoId.push_back(GeoId);
-        }
-        else {
-        }
+        edit->CurvesCoordinate->point.finishEditing();
+        edit->CurveSet->numVertices.finishEditing();
+        edit->PointsCoordinate->point.finishEditing();
     }
 
-    edit->CurvesCoordinate->point.setNum(Coords.size());
-    edit->CurveSet->numVertices.setNum(Index.size());
-    edit->CurvesMaterials->diffuseColor.setNum(Index.size());
-    edit->PointsCoordinate->point.setNum(Points.size());
-    edit->PointsMaterials->diffuseColor.setNum(Points.size());
-    
-    SbVec3f *verts = edit->CurvesCoordinate->point.startEditing();
-    int32_t *index = edit->CurveSet->numVertices.startEditing();
-    SbVec3f *pverts = edit->PointsCoordinate->point.startEditing();
-
-    int i=0; // setting up the line set
-    for (std::vector<Base::Vector3d>::const_iterator it = Coords.begin(); it != Coords.end(); ++it,i++)
-      verts[i].setValue(it->x,it->y,zLines);
-    
-    i=0; // setting up the indexes of the line set
-    for (std::vector<unsigned int>::const_iterator it = Index.begin(); it != Index.end(); ++it,i++)
-        index[i] = *it;
-
-    i=0; // setting up the point set
-    for (std::vector<Base::Vector3d>::const_iterator it = Points.begin(); it != Points.end(); ++it,i++)
-        pverts[i].setValue(it->x,it->y,zPoints);
-
-    edit->CurvesCoordinate->point.finishEditing();
-    edit->CurveSet->numVertices.finishEditing();
-    edit->PointsCoordinate->point.finishEditing();
+    // the changes of the solver are tracked from here on, whereas a draw of the
+    // sketch object's geometry leaves the layout unknown to the solver tracking
+    if (temp)
+        edit->ActSketch.resetChangedGeometry();
+    edit->DrawnIntGeoCount = temp ? intGeoCount : -1;
 
     // set cross coordinates
     edit->RootCrossSet->numVertices.set1Value(0,2);
@@ -2849,8 +2985,10 @@ void ViewProviderSketch::draw(bool temp)
     // reset point if the constraint type has changed
 Restart:
     // check if a new constraint arrived
-    if (constrlist.size() != edit->vConstrType.size())
+    if (constrlist.size() != edit->vConstrType.size()) {
         rebuildConstraintsVisual();
+        incremental = false;
+    }
     assert(int(constrlist.size()) == edit->constrGroup->getNumChildren());
     assert(int(edit->vConstrType.size()) == edit->constrGroup->getNumChildren());
     // go through the constraints and update the position
@@ -2867,6 +3005,24 @@ Restart:
         SoSeparator *sep = dynamic_cast<SoSeparator *>(edit->constrGroup->getChild(i));
         const Constraint *Constr = *it;
 
+        // the icon positions of constraints on unchanged geometry are still valid
+        if (incremental &&
+            changedGeoIds.find(Constr->First) == changedGeoIds.end() &&
+            changedGeoIds.find(Constr->Second) == changedGeoIds.end()) {
+            switch (Constr->Type) {
+                case Horizontal:
+                case Vertical:
+                case Perpendicular:
+                case Parallel:
+                case Equal:
+                case PointOnObject:
+                case Tangent:
+                    continue;
+                default:
+                    break;
+            }
+        }
+
         // distinquish different constraint types to build up
         switch (Constr->Type) {
             case Horizontal: // write the new position of the Horizontal constraint Same as vertical position.
@@ -3416,11 +3572,6 @@ Restart:
     this->drawConstraintIcons();
     this->updateColor();
 
-    // delete the cloned objects
-    if (temp)
-        for (std::vector<Part::Geometry *>::iterator it=tempGeo.begin(); it != tempGeo.end(); ++it)
-            if (*it) delete *it;
-
     if (mdi && mdi->isDerivedFrom(Gui::View3DInventor::getClassTypeId())) { 
         static_cast<Gui::View3DInventor *>(mdi)->getViewer()->redraw();
     }
@@ -3432,6 +3583,7 @@ void ViewProviderSketch::rebuildConstraintsVisual(void)
     // clean up
     edit->constrGroup->removeAllChildren();
     edit->vConstrType.clear();
+    edit->ConstrIconKeys.clear();
 
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/View");
     int fontSize = hGrp->GetInt("EditSketcherFontSize", 17);
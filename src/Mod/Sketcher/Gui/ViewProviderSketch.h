@@ -299,7 +299,9 @@ protected:
     void drawTypicalConstraintIcon(const constrIconQueueItem &i);
 
     /// Combines multiple constraint icons and sends them to Coin
-    void drawMergedConstraintIcons(IconQueue iconQueue);
+    /*! The bounding boxes of the last draw are reused if the combined icon did not change */
+    void drawMergedConstraintIcons(IconQueue iconQueue,
+                                   const std::map<QString, ConstrIconBBVec> &lastConstrBoxes);
 
     /// Helper for drawMergedConstraintIcons and drawTypicalConstraintIcon
     QImage renderConstrIcon(const QString &type,
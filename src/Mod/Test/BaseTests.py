@@ -203,8 +203,125 @@ class ParameterTestCase(unittest.TestCase):
         Temp.Import(TempPath)
         self.failUnless(Temp.GetFloat("ExTest") == 4711.4711,"ExportImport error")
         Temp = 0
+
+    def testIndex(self):
+        # the values are cached, check that they follow all changes
+        Temp = self.TestPar.GetGroup("IndexTest")
+        Temp.SetInt("Value",1)
+        Temp.SetInt("Value",1)
+        Temp.SetInt("Value",2)
+        self.failUnless(Temp.GetInt("Value") == 2,"Changed value not returned")
+        Temp.SetFloat("Value",0.1)
+        self.failUnless(Temp.GetFloat("Value") == 0.1,"Float value changed by caching")
+        Temp.SetString("Value","")
+        self.failUnless(Temp.GetString("Value","preset") == "","Empty string not returned")
+        Temp.Clear()
+        self.failUnless(Temp.GetInt("Value",3) == 3,"Value not removed by Clear")
+        self.failUnless(Temp.GetString("Value","preset") == "preset","Value not removed by Clear")
+        Temp.SetBool("Value",1)
+        self.TestPar.RemGroup("IndexTest")
+        self.failUnless(not self.TestPar.HasGroup("IndexTest"),"Group not removed")
+        Temp = self.TestPar.GetGroup("IndexTest")
+        self.failUnless(Temp.GetBool("Value",0) == 0,"Value of removed group returned")
+        Temp = 0
         
     def tearDown(self):
         #remove all
         TestPar = FreeCAD.ParamGet("System parameter:Test")
         TestPar.Clear()
+
+
+class ModuleCacheTestCase(unittest.TestCase):
+    def setUp(self):
+        import __main__
+        # the module directory and the cache file, which must not touch the stamp of the directory
+        self.Dir = tempfile.mkdtemp()
+        self.CacheDir = tempfile.mkdtemp()
+        self.Cache = __main__.ModuleCache(os.path.join(self.CacheDir, "ModuleCache.txt"))
+
+    def write(self, name, lines):
+        f = open(os.path.join(self.Dir, name), "w")
+        f.write("\n".join(lines) + "\n")
+        f.close()
+        return os.path.join(self.Dir, name)
+
+    def testDeclarativeInit(self):
+        name = self.write("Init.py", [
+            "# comment",
+            "import FreeCAD",
+            "FreeCAD.addImportType(\"Test format (*.tst)\",\"TestModule\")",
+            "ParGrp = FreeCAD.ParamGet(\"System parameter:Test\").GetGroup(\"ModuleCache\")",
+            "ParGrp.SetString(\"HelpIndex\", \"index.html\")",
+            "ParGrp.SetInt(\"Count\", 3)"])
+        calls = self.Cache.scanInit(name)
+        group = ("System parameter:Test", "ModuleCache")
+        self.failUnless(calls == [("App", "addImportType", ("Test format (*.tst)", "TestModule")),
+                                  ("Group", group),
+                                  ("Param", group, "SetString", ("HelpIndex", "index.html")),
+                                  ("Param", group, "SetInt", ("Count", 3))], "Wrong calls %s" % calls)
+        # only the parameter calls are replayed to leave the import types alone
+        self.Cache.replay(calls[1:])
+        grp = FreeCAD.ParamGet("System parameter:Test").GetGroup("ModuleCache")
+        self.failUnless(grp.GetString("HelpIndex") == "index.html")
+        self.failUnless(grp.GetInt("Count") == 3)
+
+    def testNonDeclarativeInit(self):
+        name = self.write("Init.py", ["import os", "FreeCAD.addImportType(os.name, \"TestModule\")"])
+        self.failUnless(self.Cache.scanInit(name) is None)
+        name = self.write("Init.py", ["def f():", "    pass", "f()"])
+        self.failUnless(self.Cache.scanInit(name) is None)
+        name = self.write("Init.py", ["FreeCAD.addImportType(\"Test (*.tst)\", Module)"])
+        self.failUnless(self.Cache.scanInit(name) is None)
+
+    def testDeclarativeInitGui(self):
+        name = self.write("InitGui.py", [
+            "class TestModuleWorkbench ( Workbench ):",
+            "    \"Test workbench\"",
+            "    MenuText = \"Cache test\"",
+            "    ToolTip = \"Cache test tool tip\"",
+            "    Icon = \"test.svg\"",
+            "    def Initialize(self):",
+            "        import TestModuleGui",
+            "    def GetClassName(self):",
+            "        return \"Gui::PythonWorkbench\"",
+            "",
+            "Gui.addWorkbench(TestModuleWorkbench())"])
+        info = self.Cache.scanInitGui(name)
+        self.failUnless(info == {"Workbenches": [{"Name": "TestModuleWorkbench", "MenuText": "Cache test",
+                                                  "ToolTip": "Cache test tool tip", "Icon": "test.svg"}],
+                                 "Calls": []}, "Wrong workbenches %s" % info)
+
+    def testNonDeclarativeInitGui(self):
+        name = self.write("InitGui.py", [
+            "class TestModuleWorkbench ( Workbench ):",
+            "    Icon = FreeCAD.getHomePath() + \"test.svg\"",
+            "Gui.addWorkbench(TestModuleWorkbench())"])
+        self.failUnless(self.Cache.scanInitGui(name) is None)
+        name = self.write("InitGui.py", [
+            "class TestModuleWorkbench ( Workbench ):",
+            "    pass",
+            "Gui.addWorkbench(TestModuleWorkbench())",
+            "Gui.addCommand(\"Test_Command\", TestCommand())"])
+        self.failUnless(self.Cache.scanInitGui(name) is None)
+
+    def testEntry(self):
+        name = self.write("Init.py", ["import FreeCAD"])
+        entry = self.Cache.entry(self.Dir)
+        self.failUnless(entry["Init"] == [] and entry["InitGui"] is None)
+        self.Cache.save()
+        # a new cache reads the entry back
+        import __main__
+        other = __main__.ModuleCache(self.Cache.fileName)
+        self.failUnless(other.entry(self.Dir) == entry and not other.changed)
+        # a changed file is scanned again
+        self.write("Init.py", ["import os"])
+        stamp = os.path.getmtime(name) + 10
+        os.utime(name, (stamp, stamp))
+        entry = other.entry(self.Dir)
+        self.failUnless(other.changed and entry["Init"] is None)
+
+    def tearDown(self):
+        import shutil
+        shutil.rmtree(self.Dir)
+        shutil.rmtree(self.CacheDir)
+        FreeCAD.ParamGet("System parameter:Test").RemGroup("ModuleCache")
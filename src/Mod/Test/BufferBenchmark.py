@@ -0,0 +1,97 @@
+#   (c) The FreeCAD developers 2014 LGPL
+
+# Benchmark of the bulk data access of Mesh, Points, FemMesh and TopoShape.
+# It compares the list based methods with the buffer based ones that pass
+# the data in bytearrays or other objects supporting the buffer protocol.
+#
+# Run it from the Python console or with FreeCADCmd:
+#   import BufferBenchmark
+#   BufferBenchmark.run(200)
+#
+# The typed views of the bytearrays are made with ctypes, so numpy is not needed.
+
+import FreeCAD, ctypes, time
+
+def measure(results, name, func):
+    start = time.time()
+    func()
+    results.append((name, time.time() - start))
+
+def doubles(data):
+    return (ctypes.c_double * (len(data) // ctypes.sizeof(ctypes.c_double))).from_buffer(data)
+
+def uints(data):
+    return (ctypes.c_uint * (len(data) // ctypes.sizeof(ctypes.c_uint))).from_buffer(data)
+
+def benchMesh(results, sampling):
+    import Mesh
+    mesh = Mesh.createSphere(10.0, sampling)
+    FreeCAD.Console.PrintMessage("Mesh with %d points and %d facets\n"
+                                 % (mesh.CountPoints, mesh.CountFacets))
+    topo = []
+    measure(results, "Mesh read list", lambda: topo.append(mesh.Topology))
+    data = []
+    measure(results, "Mesh read buffer",
+            lambda: data.append((mesh.getPointData(True), mesh.getFacetData())))
+
+    points, facets = topo[0]
+    def writeList():
+        other = Mesh.Mesh()
+        other.addFacets([[points[i], points[j], points[k]] for i, j, k in facets])
+    measure(results, "Mesh write list", writeList)
+    pts, fac = data[0]
+    measure(results, "Mesh write buffer", lambda: Mesh.Mesh().setData(doubles(pts), uints(fac)))
+
+def benchPoints(results, count):
+    import Points
+    coords = [FreeCAD.Vector(i, 2 * i, 3 * i) for i in range(count)]
+    points = Points.Points()
+    points.addPoints(coords)
+    FreeCAD.Console.PrintMessage("Points with %d points\n" % points.CountPoints)
+    measure(results, "Points read list", lambda: points.Points)
+    data = []
+    measure(results, "Points read buffer", lambda: data.append(points.getPointData(True)))
+    measure(results, "Points write list", lambda: Points.Points().addPoints(coords))
+    measure(results, "Points write buffer", lambda: Points.Points().addPointData(doubles(data[0])))
+
+def benchFem(results, count):
+    try:
+        import Fem
+    except ImportError:
+        FreeCAD.Console.PrintMessage("Fem module not available, skipped\n")
+        return
+    coords = [(i, 2.0 * i, 3.0 * i) for i in range(count)]
+    mesh = Fem.FemMesh()
+    for x, y, z in coords:
+        mesh.addNode(x, y, z)
+    FreeCAD.Console.PrintMessage("FemMesh with %d nodes\n" % mesh.NodeCount)
+    measure(results, "FemMesh read list", lambda: mesh.Nodes)
+    data = []
+    measure(results, "FemMesh read buffer", lambda: data.append(mesh.getNodeData()))
+
+    def writeList():
+        other = Fem.FemMesh()
+        for x, y, z in coords:
+            other.addNode(x, y, z)
+    measure(results, "FemMesh write list", writeList)
+    measure(results, "FemMesh write buffer", lambda: Fem.FemMesh().addNodeData(doubles(data[0][1])))
+
+def benchShape(results, tolerance):
+    import Part
+    shape = Part.makeSphere(10.0)
+    # tessellate once so that both paths only read the triangulation
+    shape.tessellate(tolerance)
+    measure(results, "Shape read list", lambda: shape.tessellate(tolerance))
+    measure(results, "Shape read buffer", lambda: shape.tessellateData(tolerance))
+
+def run(sampling=200, count=1000000, tolerance=0.001):
+    results = []
+    benchMesh(results, sampling)
+    benchPoints(results, count)
+    benchFem(results, count // 10)
+    benchShape(results, tolerance)
+
+    FreeCAD.Console.PrintMessage("Buffer benchmark\n")
+    for name, secs in results:
+        FreeCAD.Console.PrintMessage("  %-22s %8.3f s\n" % (name, secs))
+    return results
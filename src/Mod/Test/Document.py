@@ -759,3 +759,98 @@ class DocumentPropertyCases(unittest.TestCase):
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("PropertyTests")
+
+
+class DocumentNotificationCases(unittest.TestCase):
+  class Observer:
+    def __init__(self):
+      self.changes = []
+    def slotChangedObject(self, obj, prop):
+      if obj.Document.Name == "NotificationTests":
+        self.changes.append((obj.Name, prop))
+
+  def setUp(self):
+    self.Doc = FreeCAD.newDocument("NotificationTests")
+    self.Obj1 = self.Doc.addObject("App::FeatureTest","Obj1")
+    self.Obj2 = self.Doc.addObject("App::FeatureTest","Obj2")
+    self.Observer = DocumentNotificationCases.Observer()
+    FreeCAD.addDocumentObserver(self.Observer)
+
+  def testBatch(self):
+    self.Doc.beginNotificationBatch()
+    for i in range(10):
+      self.Obj1.Integer = i
+      self.Obj2.Integer = i
+      self.Obj1.Float = i
+    self.Doc.beginNotificationBatch()
+    self.Obj2.Integer = 20
+    self.Doc.endNotificationBatch()
+    self.failUnless(len(self.Observer.changes) == 0)
+    self.Doc.endNotificationBatch()
+    # one notification per property, grouped by object
+    self.failUnless(self.Observer.changes == [("Obj1","Integer"),("Obj1","Float"),("Obj2","Integer")])
+    self.failUnless(self.Obj2.Integer == 20)
+
+  def testRemoveInBatch(self):
+    self.Doc.beginNotificationBatch()
+    self.Obj1.Integer = 1
+    self.Obj2.Integer = 2
+    self.Doc.removeObject("Obj1")
+    self.Doc.endNotificationBatch()
+    self.failUnless(self.Observer.changes == [("Obj2","Integer")])
+
+  def testRemovePropertyInBatch(self):
+    obj = self.Doc.addObject("App::FeaturePython","Obj3")
+    obj.addProperty("App::PropertyInteger","Dynamic")
+    self.Observer.changes = []
+    self.Doc.beginNotificationBatch()
+    obj.Dynamic = 1
+    self.Obj1.Integer = 1
+    obj.removeProperty("Dynamic")
+    self.Doc.endNotificationBatch()
+    self.failUnless(self.Observer.changes == [("Obj1","Integer")])
+
+  def tearDown(self):
+    FreeCAD.removeDocumentObserver(self.Observer)
+    FreeCAD.closeDocument("NotificationTests")
+
+
+class DocumentProfilerCases(unittest.TestCase):
+  def setUp(self):
+    self.Doc = FreeCAD.newDocument("ProfilerTests")
+    self.Obj = self.Doc.addObject("App::FeatureTest","Feature")
+    FreeCAD.Profiler.clear()
+    FreeCAD.Profiler.setEnabled(True)
+
+  def testSummary(self):
+    self.Obj.Integer = 2
+    self.Doc.recompute()
+    names = [zone[0] for zone in FreeCAD.Profiler.summary()]
+    self.failUnless("Document::recompute" in names)
+    self.failUnless("App::FeatureTest" in names)
+
+  def testDisabled(self):
+    FreeCAD.Profiler.setEnabled(False)
+    self.Obj.Integer = 2
+    self.Doc.recompute()
+    self.failUnless(FreeCAD.Profiler.summary() == [])
+
+  def testExportTrace(self):
+    import json
+    self.Obj.Integer = 2
+    self.Doc.recompute()
+    FreeCAD.Profiler.addCounter("Objects", 1)
+    FileName = tempfile.gettempdir() + os.sep + "ProfilerTests.json"
+    FreeCAD.Profiler.exportTrace(FileName)
+    file = open(FileName)
+    trace = json.load(file)
+    file.close()
+    os.remove(FileName)
+    phases = [event["ph"] for event in trace["traceEvents"]]
+    self.failUnless("X" in phases)
+    self.failUnless("C" in phases)
+
+  def tearDown(self):
+    FreeCAD.Profiler.setEnabled(False)
+    FreeCAD.Profiler.clear()
+    FreeCAD.closeDocument("ProfilerTests")
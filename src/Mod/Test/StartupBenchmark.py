@@ -0,0 +1,57 @@
+#   (c) The FreeCAD developers 2014 LGPL
+
+# Benchmark of the start-up time of the console application.
+#
+# Run it from the Python console or FreeCADCmd:
+#   import StartupBenchmark
+#   StartupBenchmark.run(10)
+#
+# Each run starts FreeCADCmd with an empty script. The 'rebuild' runs remove
+# the module cache ModuleCache.txt from the user directory first so that all
+# Init.py files are analyzed again, the 'cached' runs use the cache.
+# The cache is switched off with the boolean parameter 'UseModuleCache'
+# of 'User parameter:BaseApp/Preferences/General'.
+
+import FreeCAD, os, subprocess, sys, tempfile, time
+
+def executable():
+    name = "FreeCADCmd"
+    if sys.platform == "win32":
+        name += ".exe"
+    return os.path.join(FreeCAD.getHomePath(), "bin", name)
+
+def startup(script, cacheFile, rebuild):
+    if rebuild and os.path.exists(cacheFile):
+        os.remove(cacheFile)
+    devnull = open(os.devnull, "w")
+    start = time.time()
+    subprocess.call([executable(), script], stdout=devnull, stderr=devnull)
+    secs = time.time() - start
+    devnull.close()
+    return secs
+
+def median(values):
+    values = sorted(values)
+    n = len(values)
+    if n % 2:
+        return values[n / 2]
+    return 0.5 * (values[n / 2 - 1] + values[n / 2])
+
+def run(count=10):
+    fd, script = tempfile.mkstemp(".py")
+    os.write(fd, "pass\n")
+    os.close(fd)
+    cacheFile = FreeCAD.ConfigGet("UserAppData") + "ModuleCache.txt"
+
+    results = []
+    for name, rebuild in (("rebuild", True), ("cached", False)):
+        times = [startup(script, cacheFile, rebuild) for i in range(count)]
+        results.append((name, min(times), median(times)))
+    os.remove(script)
+
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/General")
+    FreeCAD.Console.PrintMessage("Start-up of %s, %d runs, UseModuleCache=%s\n"
+                                 % (executable(), count, param.GetBool("UseModuleCache", True)))
+    for name, best, med in results:
+        FreeCAD.Console.PrintMessage("  %-10s min %6.3f s  median %6.3f s\n" % (name, best, med))
+    return results
@@ -46,6 +46,10 @@ def All():
     suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestSketcherApp") )
     suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestPartApp") )
     suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestPartDesignApp") )
+    suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestRobotApp") )
+    suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestPointsApp") )
+    suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestFemApp") )
+    suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestImportApp") )
     # gui tests of modules
     if ( FreeCAD.GuiUp == 1):
         suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestSketcherGui") )
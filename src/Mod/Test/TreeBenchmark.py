@@ -0,0 +1,61 @@
+#   (c) The FreeCAD developers 2014 LGPL
+
+# Benchmark of the tree view with a large synthetic document.
+#
+# Run it from the Python console of the GUI:
+#   import TreeBenchmark
+#   TreeBenchmark.run(50000)
+#
+# The objects are put into groups whose tree items are collapsed, so
+# most items are only created by the 'expand' step.
+
+import FreeCAD, FreeCADGui, os, tempfile, time
+
+def createDocument(count, groupSize=100):
+    doc = FreeCAD.newDocument("TreeBenchmark")
+    group = None
+    for i in range(count):
+        if i % groupSize == 0:
+            group = doc.addObject("App::DocumentObjectGroup","Group")
+        obj = doc.addObject("App::DocumentObjectGroup","Item")
+        group.addObject(obj)
+    return doc
+
+def measure(results, name, func):
+    start = time.time()
+    func()
+    FreeCADGui.updateGui()
+    results.append((name, time.time() - start))
+
+def run(count=50000, groupSize=100):
+    results = []
+    docs = []
+    measure(results, "create", lambda: docs.append(createDocument(count, groupSize)))
+    doc = docs[0]
+
+    def relabel():
+        doc.beginNotificationBatch()
+        for obj in doc.Objects:
+            obj.Label = obj.Name + "_renamed"
+        doc.endNotificationBatch()
+    measure(results, "relabel", relabel)
+    measure(results, "recompute", doc.recompute)
+
+    def expand():
+        gui = FreeCADGui.getDocument(doc.Name)
+        for obj in doc.Objects:
+            if obj.Name.startswith("Group"):
+                gui.toggleTreeItem(obj, 2)
+    measure(results, "expand", expand)
+
+    fileName = os.path.join(tempfile.gettempdir(), "TreeBenchmark.FCStd")
+    doc.saveAs(fileName)
+    measure(results, "close", lambda: FreeCAD.closeDocument(doc.Name))
+    measure(results, "open", lambda: docs.append(FreeCAD.openDocument(fileName)))
+    measure(results, "close", lambda: FreeCAD.closeDocument(docs[1].Name))
+    os.remove(fileName)
+
+    FreeCAD.Console.PrintMessage("Tree benchmark with %d objects\n" % count)
+    for name, secs in results:
+        FreeCAD.Console.PrintMessage("  %-10s %8.3f s\n" % (name, secs))
+    return results
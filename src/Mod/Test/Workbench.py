@@ -66,6 +66,44 @@ class WorkbenchTestCase(unittest.TestCase):
         list=FreeCADGui.listWorkbenches()
         self.failUnless(list.has_key("UnitWorkbench")==False, "Test on removing workbench handler failed")
 
+    def testLazyHandler(self):
+        import __main__, tempfile, shutil, types
+        dir = tempfile.mkdtemp()
+        try:
+            name = os.path.join(dir, "InitGui.py")
+            f = open(name, "w")
+            f.write("class LazyUnitWorkbench ( Workbench ):\n"
+                    "    MenuText = \"Lazy unittest\"\n"
+                    "    def Initialize(self):\n"
+                    "        self.appendToolbar(\"My Lazy Unittest\",[\"Test_Test\"])\n"
+                    "    def GetClassName(self):\n"
+                    "        return \"Gui::PythonWorkbench\"\n"
+                    "\n"
+                    "Gui.addWorkbench(LazyUnitWorkbench())\n")
+            f.close()
+
+            # register the stub the way FreeCADGuiInit.py does for a cached module
+            cache = __main__.ModuleCache(os.path.join(dir, "ModuleCache.txt"))
+            info = cache.scanInitGui(name)["Workbenches"][0]
+            self.failUnless(info == {"Name": "LazyUnitWorkbench", "MenuText": "Lazy unittest"}, "Wrong cache entry %s" % info)
+            attrs = {"__LazyInitGui__": name, "MenuText": info["MenuText"]}
+            FreeCADGui.addWorkbench(types.ClassType(info["Name"], (__main__.LazyWorkbench,), attrs)())
+            list=FreeCADGui.listWorkbenches()
+            self.failUnless(hasattr(list["LazyUnitWorkbench"], "__LazyInitGui__"), "Test on adding lazy workbench failed")
+
+            # activating it executes InitGui.py which replaces the stub
+            FreeCADGui.activateWorkbench("LazyUnitWorkbench")
+            FreeCADGui.updateGui()
+            list=FreeCADGui.listWorkbenches()
+            self.failUnless(not hasattr(list["LazyUnitWorkbench"], "__LazyInitGui__"), "Lazy workbench not replaced")
+            self.failUnless(list["LazyUnitWorkbench"].MenuText == "Lazy unittest")
+            self.failUnless(FreeCADGui.activeWorkbench().name()=="LazyUnitWorkbench", "Test on loading lazy workbench failed")
+        finally:
+            FreeCADGui.activateWorkbench(self.Active.name())
+            if FreeCADGui.listWorkbenches().has_key("LazyUnitWorkbench"):
+                FreeCADGui.removeWorkbench("LazyUnitWorkbench")
+            shutil.rmtree(dir)
+
     def tearDown(self):
         FreeCADGui.activateWorkbench(self.Active.name())
         FreeCAD.Console.PrintLog(self.Active.name())